@@ -34,6 +34,14 @@
 # include "./PostProcessor.hpp"
 # include "./ErrorManager.hpp"
 # include "./Colors.hpp"
+# include "./GLExtensions.hpp"
+# include "./ProgramCache.hpp"
+# include "./StartupTimer.hpp"
+# include "./RenderScheduler.hpp"
+# include "./FramePacer.hpp"
+# include "./ResolutionScaler.hpp"
+# include "./FrameCapture.hpp"
+# include "./TurntableRecorder.hpp"
 # include <glad/glad.h>
 # include <memory>
 # include <iostream>
@@ -71,7 +79,6 @@ class App {
         int _mode;
         Parser *_parser;
         Mesh *_mesh;
-        Shader *_shader;
         Renderer *_renderer;
         GLFWwindow *_window;
 
@@ -79,6 +86,11 @@ class App {
         std::unique_ptr<TextureLoader> _textureLoader;
         std::unique_ptr<UIManager> _uiManager;
         std::unique_ptr<PostProcessor> _postProcessor;
+        std::unique_ptr<RenderScheduler> _scheduler;
+        std::unique_ptr<FramePacer> _pacer;
+        std::unique_ptr<ResolutionScaler> _resolution;
+        std::unique_ptr<FrameCapture> _capture;
+        std::unique_ptr<TurntableRecorder> _recorder;
 
         std::shared_ptr<Texture> _currentTexture;
         std::unordered_map<int, std::shared_ptr<Texture>> _materialTextures;
@@ -88,6 +100,9 @@ class App {
         bool _showVertices = false;
         bool _enableCRT = false; 
         bool _useTexture = false;
+        size_t _activeLOD = 0;
+        bool _turntableActive = false;
+        bool _turntableAutoRotation = false;
         
         /**
          * @brief Set up UI callback functions for ImGui controls.
@@ -96,7 +111,7 @@ class App {
         void setupUICallbacks();
 
     public:
-        App(int mode, Mesh *mesh, Shader *shader, Renderer *renderer, Parser *parser);
+        App(int mode, Mesh *mesh, Renderer *renderer, Parser *parser);
 
         ~App();
         
@@ -113,7 +128,9 @@ class App {
         void handleAutoRotationToggle(bool autoRotation);
         void handleCRTToggle(bool enableCRT);
         void handleTextureToggle(bool useTexture);
-        void renderWithMaterials();
+        void handleScreenshot();
+        void handleTurntableStart(int frames);
+        void handleTurntableEnd();
         glm::mat4 createProjectionMatrix();
     };
 
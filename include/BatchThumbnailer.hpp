@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BatchThumbnailer.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/27 09:31:14 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/27 17:12:48 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file BatchThumbnailer.hpp
+ * @brief Declaration of the BatchThumbnailer rendering a thumbnail for every model of a directory tree.
+ *
+ * Three stages overlap: parser threads read and parse OBJ/FDF files, the thread owning the
+ * GL context uploads and renders them one after another, and the capture's encoder threads
+ * write the PNGs. A bounded queue between parsing and rendering keeps the parsers ahead
+ * of the GPU without holding more than a few parsed models in memory.
+ */
+
+#pragma once
+
+#ifndef BATCHTHUMBNAILER_HPP
+# define BATCHTHUMBNAILER_HPP
+
+# include "./HeadlessRenderer.hpp"
+# include "./SoftwareRenderer.hpp"
+# include "./Parser.hpp"
+# include <string>
+# include <vector>
+# include <deque>
+# include <memory>
+# include <thread>
+# include <mutex>
+# include <condition_variable>
+# include <filesystem>
+# include <cstddef>
+
+/**
+ * @struct BatchStats
+ * @brief Outcome and throughput of a batch run.
+ */
+struct BatchStats {
+    size_t found = 0;               ///< OBJ/FDF files under the input directory
+    size_t written = 0;             ///< Thumbnails on disk
+    size_t failed = 0;              ///< Files that failed to parse, render or write
+    float seconds = 0.0f;
+    float assetsPerSecond = 0.0f;
+    float renderWaitSeconds = 0.0f; ///< Time the GL thread waited for parsed models (parsing is the bottleneck when high)
+};
+
+/**
+ * @class BatchThumbnailer
+ * @brief Parser pool feeding the single GL thread through a bounded queue.
+ *
+ * run() must be called on the thread with the HeadlessRenderer's context current; only the
+ * parsers run elsewhere, and they never touch GL. With a SoftwareRenderer instead there is
+ * no context, and the rendering thread drives the CPU rasterizer. The output tree mirrors
+ * the input tree, with each model's extension replaced by .png.
+ */
+class BatchThumbnailer {
+    private:
+        struct Job {
+            std::filesystem::path file;
+            std::filesystem::path output;
+            std::unique_ptr<Parser> parser;
+        };
+
+        HeadlessRenderer *_headless;
+        SoftwareRenderer *_software;
+        size_t _parserCount;
+        size_t _queueCapacity;
+        bool _quantize;
+        bool _optimize;
+        bool _reduceOverdraw;
+        bool _generateLODs;
+
+        std::vector<Job> _files;
+        size_t _nextFile;
+        size_t _activeParsers;
+        size_t _parseFailures;
+        double _renderWait;
+        bool _stopping;
+        std::deque<Job> _queue;
+        std::mutex _mutex;
+        std::condition_variable _parsed;
+        std::condition_variable _consumed;
+        std::vector<std::thread> _parsers;
+
+        void collect(const std::filesystem::path &input, const std::filesystem::path &output);
+        void parserLoop();
+        bool pop(Job &job);
+        bool render(Job &job);
+
+    public:
+        BatchThumbnailer(HeadlessRenderer *headless, size_t parsers, size_t queueCapacity = 0, bool quantize = false);
+        BatchThumbnailer(SoftwareRenderer *software, size_t parsers, size_t queueCapacity = 0);
+        ~BatchThumbnailer();
+
+        BatchThumbnailer(const BatchThumbnailer &) = delete;
+        BatchThumbnailer &operator=(const BatchThumbnailer &) = delete;
+
+        void setMeshProcessing(bool optimize, bool reduceOverdraw, bool generateLODs);
+        BatchStats run(const std::string &inputDirectory, const std::string &outputDirectory);
+
+        static bool isModelFile(const std::filesystem::path &path);
+};
+
+#endif
@@ -6,6 +6,7 @@
 # include "glm/glm.hpp"
 # include "glm/gtc/matrix_transform.hpp"
 # include "glm/gtc/type_ptr.hpp"
+# include "./Shader.hpp"
 
 struct Color {
     float r, g, b, a;
@@ -30,11 +31,11 @@ namespace Colors {
 
 //inline is used so that the function can be defined in the .hpp file (avoiding multiple definitions error)
 inline void setClearColor(const Color &color) {
-    glClearColor(color.r, color.g, color.b, color.a);
+    GLState::clearColor(color.r, color.g, color.b, color.a);
 }
 
-inline void setLineColor(int lineColorLoc, const Color &color) {
-    glUniform3f(lineColorLoc, color.r, color.g, color.b);
+inline void setLineColor(Shader &shader, const Color &color) {
+    shader.setUniform("u_lineColor", glm::vec3(color.r, color.g, color.b));
 }
 
 #endif
\ No newline at end of file
@@ -19,11 +19,57 @@
 # include "glm/gtc/matrix_transform.hpp"
 # include "glm/gtc/type_ptr.hpp"
 # include <glad/glad.h>
+# include <string>
+# include <vector>
 
+/**
+ * GL error policy (selected at build time):
+ * - SCOP_GL_DEBUG defined (debug builds): GLCall records its call site; errors are reported
+ *   by the KHR_debug message callback when the driver supports it, otherwise by polling
+ *   glGetError around every wrapped call
+ * - SCOP_GL_DEBUG undefined (release builds): GLCall is the bare call and debug groups
+ *   compile away, so error checking costs nothing in the frame loop
+ */
 class ErrorManager {
+	private:
+		static bool _debugOutput;
+		static const char *_callFunction;
+		static const char *_callFile;
+		static int _callLine;
+		static std::vector<std::string> _groups;
+
+		static void APIENTRY debugCallback(GLenum source, GLenum type, GLuint id, GLenum severity,
+		                                   GLsizei length, const GLchar *message, const void *userParam);
+		static void printGroups();
+
 	public:
 		static void GLClearError();
 		static bool GLLogCall(const char *function, const char *file, int line);
+
+		static bool enableDebugOutput();
+		static bool usesDebugOutput() { return _debugOutput; }
+
+		static void setCallSite(const char *function, const char *file, int line) {
+			_callFunction = function;
+			_callFile = file;
+			_callLine = line;
+		}
+
+		static void pushGroup(const char *name, const char *file, int line);
+		static void popGroup();
+};
+
+/**
+ * @class GLDebugGroup
+ * @brief Scoped debug group; tags every message raised inside the scope with its source location.
+ */
+class GLDebugGroup {
+	public:
+		GLDebugGroup(const char *name, const char *file, int line) { ErrorManager::pushGroup(name, file, line); }
+		~GLDebugGroup() { ErrorManager::popGroup(); }
+
+		GLDebugGroup(const GLDebugGroup &) = delete;
+		GLDebugGroup &operator=(const GLDebugGroup &) = delete;
 };
 
 // Debug break so that execution stops when glError triggers
@@ -34,10 +80,27 @@ class ErrorManager {
     # define DEBUG_BREAK() std::raise(SIGTRAP)
 # endif
 
-// Macro assertion to go through the debug break and provoke the stop
-# define GLCall(x) ErrorManager::GLClearError();\
-	x;\
-	ASSERT(ErrorManager::GLLogCall(#x, __FILE__, __LINE__))
+# define GL_DEBUG_GROUP_NAME_(line) glDebugGroup_##line
+# define GL_DEBUG_GROUP_NAME(line) GL_DEBUG_GROUP_NAME_(line)
+
+# ifdef SCOP_GL_DEBUG
+// With a debug callback the driver reports errors itself; only remember where we are
+#  define GLCall(x) do { \
+	if (ErrorManager::usesDebugOutput()) { \
+		ErrorManager::setCallSite(#x, __FILE__, __LINE__); \
+		x; \
+		ErrorManager::setCallSite(nullptr, nullptr, 0); \
+	} else { \
+		ErrorManager::GLClearError(); \
+		x; \
+		ASSERT(ErrorManager::GLLogCall(#x, __FILE__, __LINE__)) \
+	} \
+} while (0)
+#  define GL_DEBUG_GROUP(name) GLDebugGroup GL_DEBUG_GROUP_NAME(__LINE__)(name, __FILE__, __LINE__)
+# else
+#  define GLCall(x) x
+#  define GL_DEBUG_GROUP(name) ((void)0)
+# endif
 
 #define ASSERT(x) if (!(x)) DEBUG_BREAK();
 
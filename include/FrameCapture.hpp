@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FrameCapture.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/24 10:27:14 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/24 17:05:48 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file FrameCapture.hpp
+ * @brief Declaration of the FrameCapture saving rendered frames as PNG without stalling.
+ *
+ * glReadPixels into client memory waits for the GPU to finish everything queued before it.
+ * Here it targets a pixel buffer object instead, so the call only queues a copy; a fence
+ * marks when the copy is done and the buffer is mapped a few frames later, when waiting is
+ * no longer needed. The pixels are then handed to a worker thread that encodes the PNG.
+ */
+
+#pragma once
+
+#ifndef FRAMECAPTURE_HPP
+# define FRAMECAPTURE_HPP
+
+# include <glad/glad.h>
+# include <string>
+# include <vector>
+# include <deque>
+# include <thread>
+# include <mutex>
+# include <condition_variable>
+# include <atomic>
+# include <cstdint>
+# include <cstddef>
+
+/**
+ * @struct FrameCaptureStats
+ * @brief Capture progress; pending covers both frames on the GPU and frames being encoded.
+ */
+struct FrameCaptureStats {
+    size_t captured = 0;        ///< Readbacks issued
+    size_t written = 0;         ///< PNG files written
+    size_t failed = 0;          ///< Encodes or writes that failed
+    size_t dropped = 0;         ///< Captures refused because every ring slot was busy
+    size_t pending = 0;
+    std::string lastPath;
+};
+
+/**
+ * @class FrameCapture
+ * @brief Ring of pixel pack buffers read back asynchronously and encoded on worker threads.
+ *
+ * Per frame: capture() after the image is composited, update() once (anywhere in the frame)
+ * to move finished readbacks to the encoders. Captures are taken from the current read
+ * framebuffer region, so whatever reached it (scene, post effects) is what gets saved.
+ */
+class FrameCapture {
+    private:
+        static const size_t RING_SIZE = 3;
+
+        struct Slot {
+            unsigned int buffer = 0;
+            size_t capacity = 0;
+            GLsync fence = nullptr;
+            int width = 0;
+            int height = 0;
+            std::string path;
+        };
+
+        struct Job {
+            std::vector<uint8_t> pixels;
+            int width = 0;
+            int height = 0;
+            std::string path;
+        };
+
+        Slot _slots[RING_SIZE];
+        size_t _next;               // Oldest in-flight slot, harvested first
+        size_t _inFlight;
+        std::string _directory;
+        std::vector<std::string> _requests;
+
+        std::vector<std::thread> _workers;
+        std::deque<Job> _jobs;
+        std::mutex _mutex;
+        std::condition_variable _jobReady;
+        std::condition_variable _jobDone;
+        size_t _encoding;
+        bool _stopping;
+
+        std::atomic<size_t> _written;
+        std::atomic<size_t> _failed;
+        size_t _captured;
+        size_t _dropped;
+        std::string _lastPath;
+
+        void workerLoop();
+        bool harvest(Slot &slot, bool wait);
+        bool harvestOldest(bool wait);
+        std::string nextPath() const;
+
+    public:
+        static std::string timestamp();
+
+        explicit FrameCapture(const std::string &directory = "captures", size_t workers = 1);
+        ~FrameCapture();
+
+        FrameCapture(const FrameCapture &) = delete;
+        FrameCapture &operator=(const FrameCapture &) = delete;
+
+        void requestScreenshot(const std::string &path = "");
+        bool hasRequest() const { return !_requests.empty(); }
+        void captureRequested(unsigned int framebuffer, int x, int y, int width, int height);
+
+        bool capture(unsigned int framebuffer, int x, int y, int width, int height, const std::string &path);
+        bool hasFreeSlot() const { return _inFlight < RING_SIZE; }
+        bool hasPendingReadback() const { return _inFlight > 0; }
+        void update();
+        void waitForSlot(size_t maxQueuedJobs);
+        void flush();
+
+        FrameCaptureStats getStats();
+};
+
+#endif
@@ -0,0 +1,107 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FramePacer.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/20 09:05:31 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/20 17:22:14 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file FramePacer.hpp
+ * @brief Declaration of the FramePacer controlling swap interval, frame rate limit and latency.
+ *
+ * The pacer owns the buffer swap. It applies the vsync mode through glfwSwapInterval,
+ * holds frames to a target rate with a sleep-then-spin wait (the OS sleep is only trusted
+ * up to its measured overshoot, the rest is spun), and records presented frame intervals
+ * so frame time, FPS and pacing jitter are averaged over a window instead of one delta.
+ */
+
+#pragma once
+
+#ifndef FRAMEPACER_HPP
+# define FRAMEPACER_HPP
+
+# include <glad/glad.h>
+# include <GLFW/glfw3.h>
+# include <array>
+# include <chrono>
+# include <cstddef>
+
+enum class VSyncMode {
+    OFF = 0,
+    ON = 1,
+    ADAPTIVE = 2    ///< Sync when on time, tear instead of waiting a whole refresh when late (swap interval -1)
+};
+
+/**
+ * @struct FramePacingStats
+ * @brief Presented frame statistics over the last 120 frames (times in seconds).
+ */
+struct FramePacingStats {
+    float frameTime = 0.0f;         ///< Mean interval between presented frames
+    float fps = 0.0f;               ///< 1 / frameTime
+    float jitter = 0.0f;            ///< Standard deviation of the interval
+    float maxDeviation = 0.0f;      ///< Largest distance of one interval from the target (or the mean when unlimited)
+    float targetFrameTime = 0.0f;   ///< Limiter period, 0 when unlimited
+    float cpuTime = 0.0f;           ///< Smoothed CPU time from beginFrame to the swap (waits excluded)
+    VSyncMode vsync = VSyncMode::ON;
+    bool adaptiveSupported = false; ///< Driver exposes WGL/GLX_EXT_swap_control_tear
+    bool lowLatency = false;
+};
+
+/**
+ * @class FramePacer
+ * @brief Frame rate limiter and swap owner for the main loop.
+ *
+ * Normal mode paces after presenting (input → render → present → wait). Low-latency mode
+ * waits before input is sampled (wait → input → render → present) and drains the GPU
+ * after the swap, so the input a frame is built from is as recent as possible and no
+ * frames queue up in the driver.
+ */
+class FramePacer {
+    private:
+        using Clock = std::chrono::steady_clock;
+        static constexpr size_t HISTORY = 120;
+
+        GLFWwindow *_window;
+        VSyncMode _vsync;
+        bool _adaptiveSupported;
+        bool _lowLatency;
+        double _targetFrameTime;
+
+        Clock::time_point _deadline;
+        Clock::time_point _lastPresent;
+        Clock::time_point _frameStart;
+        bool _frameStarted;
+        bool _hasLastPresent;
+        double _sleepOvershoot;
+
+        std::array<float, HISTORY> _intervals;
+        size_t _intervalCount;
+        size_t _intervalNext;
+
+        FramePacingStats _stats;
+
+        void recordInterval(float interval);
+
+    public:
+        explicit FramePacer(GLFWwindow *window);
+
+        void setVSync(VSyncMode mode);
+        void setTargetFPS(float fps);
+        void setLowLatency(bool lowLatency);
+        bool isLowLatency() const { return _lowLatency; }
+
+        void waitForNextFrame();
+        void beginFrame();
+        void present();
+        void resetTiming();
+
+        const FramePacingStats &getStats() const { return _stats; }
+};
+
+#endif
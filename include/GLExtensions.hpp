@@ -0,0 +1,118 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   GLExtensions.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/18 09:33:05 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/18 15:12:40 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file GLExtensions.hpp
+ * @brief Optional OpenGL functionality beyond the 3.3 core profile glad was generated for.
+ *
+ * glad only loads GL 3.3 core entry points. Features that are core in later versions or
+ * exposed as extensions (program binaries, parallel shader compilation, debug output) are detected at
+ * runtime and their entry points loaded here, so the renderer can use them when present
+ * and fall back to plain 3.3 behavior otherwise.
+ */
+
+#pragma once
+
+#ifndef GLEXTENSIONS_HPP
+# define GLEXTENSIONS_HPP
+
+# include <glad/glad.h>
+# include <string>
+
+// ARB_get_program_binary (core in 4.1)
+# ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#  define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+# endif
+# ifndef GL_PROGRAM_BINARY_LENGTH
+#  define GL_PROGRAM_BINARY_LENGTH 0x8741
+# endif
+# ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#  define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+# endif
+
+// KHR_parallel_shader_compile
+# ifndef GL_COMPLETION_STATUS_KHR
+#  define GL_COMPLETION_STATUS_KHR 0x91B1
+# endif
+
+// KHR_debug (core in 4.3)
+# ifndef GL_DEBUG_OUTPUT
+#  define GL_DEBUG_OUTPUT 0x92E0
+# endif
+# ifndef GL_DEBUG_OUTPUT_SYNCHRONOUS
+#  define GL_DEBUG_OUTPUT_SYNCHRONOUS 0x8242
+# endif
+# ifndef GL_CONTEXT_FLAG_DEBUG_BIT
+#  define GL_CONTEXT_FLAG_DEBUG_BIT 0x00000002
+# endif
+# ifndef GL_DEBUG_SOURCE_API
+#  define GL_DEBUG_SOURCE_API 0x8246
+#  define GL_DEBUG_SOURCE_WINDOW_SYSTEM 0x8247
+#  define GL_DEBUG_SOURCE_SHADER_COMPILER 0x8248
+#  define GL_DEBUG_SOURCE_THIRD_PARTY 0x8249
+#  define GL_DEBUG_SOURCE_APPLICATION 0x824A
+#  define GL_DEBUG_SOURCE_OTHER 0x824B
+# endif
+# ifndef GL_DEBUG_TYPE_ERROR
+#  define GL_DEBUG_TYPE_ERROR 0x824C
+#  define GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR 0x824D
+#  define GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR 0x824E
+#  define GL_DEBUG_TYPE_PORTABILITY 0x824F
+#  define GL_DEBUG_TYPE_PERFORMANCE 0x8250
+#  define GL_DEBUG_TYPE_OTHER 0x8251
+#  define GL_DEBUG_TYPE_MARKER 0x8268
+#  define GL_DEBUG_TYPE_PUSH_GROUP 0x8269
+#  define GL_DEBUG_TYPE_POP_GROUP 0x826A
+# endif
+# ifndef GL_DEBUG_SEVERITY_HIGH
+#  define GL_DEBUG_SEVERITY_HIGH 0x9146
+#  define GL_DEBUG_SEVERITY_MEDIUM 0x9147
+#  define GL_DEBUG_SEVERITY_LOW 0x9148
+#  define GL_DEBUG_SEVERITY_NOTIFICATION 0x826B
+# endif
+
+typedef void (APIENTRYP PFNSCOPGETPROGRAMBINARYPROC)(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+typedef void (APIENTRYP PFNSCOPPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+typedef void (APIENTRYP PFNSCOPPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+typedef void (APIENTRYP PFNSCOPMAXSHADERCOMPILERTHREADSPROC)(GLuint count);
+typedef void (APIENTRYP PFNSCOPDEBUGMESSAGECALLBACKPROC)(GLDEBUGPROC callback, const void *userParam);
+typedef void (APIENTRYP PFNSCOPDEBUGMESSAGECONTROLPROC)(GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled);
+typedef void (APIENTRYP PFNSCOPPUSHDEBUGGROUPPROC)(GLenum source, GLuint id, GLsizei length, const GLchar *message);
+typedef void (APIENTRYP PFNSCOPPOPDEBUGGROUPPROC)(void);
+
+/**
+ * @class GLExtensions
+ * @brief Runtime-detected capabilities and their entry points (null when unavailable).
+ *
+ * load() must run once after gladLoadGLLoader with the same loader function.
+ */
+class GLExtensions {
+    public:
+        static bool programBinary;              ///< GL 4.1 or ARB_get_program_binary with at least one binary format
+        static bool parallelShaderCompile;      ///< KHR/ARB_parallel_shader_compile
+        static bool debugOutput;                ///< GL 4.3 or KHR_debug (message callback and debug groups)
+
+        static PFNSCOPGETPROGRAMBINARYPROC getProgramBinary;
+        static PFNSCOPPROGRAMBINARYPROC programBinaryLoad;
+        static PFNSCOPPROGRAMPARAMETERIPROC programParameteri;
+        static PFNSCOPMAXSHADERCOMPILERTHREADSPROC maxShaderCompilerThreads;
+        static PFNSCOPDEBUGMESSAGECALLBACKPROC debugMessageCallback;
+        static PFNSCOPDEBUGMESSAGECONTROLPROC debugMessageControl;
+        static PFNSCOPPUSHDEBUGGROUPPROC pushDebugGroup;
+        static PFNSCOPPOPDEBUGGROUPPROC popDebugGroup;
+
+        static void load(GLADloadproc loader);
+        static bool has(const std::string &extension);
+        static bool versionAtLeast(int major, int minor);
+};
+
+#endif
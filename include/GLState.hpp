@@ -0,0 +1,113 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   GLState.hpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/15 09:20:11 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/15 13:57:46 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file GLState.hpp
+ * @brief Declaration of the GLState cache that filters redundant OpenGL state changes.
+ *
+ * OpenGL is one big state machine and the render loop used to re-issue the same binds and
+ * toggles several times per frame (renderer, material loop, post-processor and app all reset
+ * depth/cull state and rebind their objects). Every bind, enable/disable and fixed-function
+ * setter in the renderer and app goes through GLState instead, which remembers what the
+ * context currently holds and only forwards calls that actually change something.
+ */
+
+#pragma once
+
+#ifndef GLSTATE_HPP
+# define GLSTATE_HPP
+
+# include <glad/glad.h>
+# include <unordered_map>
+# include <cstddef>
+
+/**
+ * @struct GLStateStats
+ * @brief State-change traffic of the current frame.
+ */
+struct GLStateStats {
+    size_t issued = 0;  ///< Calls forwarded to the driver
+    size_t elided = 0;  ///< Calls dropped because the context already held that state
+};
+
+/**
+ * @class GLState
+ * @brief Process-wide shadow of the OpenGL context state the application touches.
+ *
+ * Only valid while every state change goes through it. Code outside our control that
+ * changes state must either restore it (the ImGui OpenGL3 backend backs up and restores
+ * everything it touches) or be followed by invalidate(). Deleting an object through the
+ * delete* helpers forgets its bindings, since GL unbinds deleted names and may reuse them.
+ */
+class GLState {
+    private:
+        static const unsigned int UNKNOWN = 0xFFFFFFFFu;
+
+        static unsigned int _program;
+        static unsigned int _vertexArray;
+        static std::unordered_map<unsigned int, unsigned int> _buffers;         // target -> buffer
+        static std::unordered_map<unsigned int, unsigned int> _elementBuffers;  // VAO -> index buffer
+        static unsigned int _drawFramebuffer;
+        static unsigned int _readFramebuffer;
+        static unsigned int _renderbuffer;
+        static unsigned int _activeTexture;
+        static std::unordered_map<unsigned int, unsigned int> _textures;       // unit -> 2D texture
+        static std::unordered_map<unsigned int, bool> _capabilities;
+        static unsigned int _depthFunc;
+        static int _depthMask;
+        static float _lineWidth;
+        static float _pointSize;
+        static int _viewport[4];
+        static int _scissor[4];
+        static float _clearColor[4];
+        static bool _clearColorKnown;
+
+        static GLStateStats _frameStats;
+
+        static bool changed(bool differs);
+
+    public:
+        static void useProgram(unsigned int program);
+        static void bindVertexArray(unsigned int vertexArray);
+        static void bindBuffer(unsigned int target, unsigned int buffer);
+        static void bindBufferBase(unsigned int target, unsigned int index, unsigned int buffer);
+        static void bindFramebuffer(unsigned int target, unsigned int framebuffer);
+        static void bindRenderbuffer(unsigned int renderbuffer);
+        static void activeTexture(unsigned int unit);
+        static void bindTexture(unsigned int target, unsigned int texture);
+
+        static void enable(unsigned int capability);
+        static void disable(unsigned int capability);
+        static bool isEnabled(unsigned int capability);
+
+        static void depthFunc(unsigned int func);
+        static void depthMask(bool write);
+        static void lineWidth(float width);
+        static void pointSize(float size);
+        static void viewport(int x, int y, int width, int height);
+        static void scissor(int x, int y, int width, int height);
+        static void clearColor(float r, float g, float b, float a);
+
+        static void deleteProgram(unsigned int program);
+        static void deleteVertexArray(unsigned int vertexArray);
+        static void deleteBuffer(unsigned int buffer);
+        static void deleteTexture(unsigned int texture);
+        static void deleteFramebuffer(unsigned int framebuffer);
+        static void deleteRenderbuffer(unsigned int renderbuffer);
+
+        static void invalidate();
+
+        static const GLStateStats &getFrameStats();
+        static void resetFrameStats();
+};
+
+#endif
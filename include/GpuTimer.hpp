@@ -0,0 +1,91 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   GpuTimer.hpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/21 09:20:17 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/21 15:58:42 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file GpuTimer.hpp
+ * @brief Declaration of the GpuTimer measuring GPU time per render pass with timer queries.
+ *
+ * Each pass is bracketed by a GL_TIME_ELAPSED query. Results are read back FRAME_LATENCY
+ * frames later from a ring of per-frame query sets, by which time the GPU has long finished
+ * them, so reading never blocks the CPU. Per-pass times are smoothed for display.
+ */
+
+#pragma once
+
+#ifndef GPUTIMER_HPP
+# define GPUTIMER_HPP
+
+# include <glad/glad.h>
+# include <vector>
+# include <cstddef>
+
+/**
+ * Render passes timed separately. WIREFRAME_POINTS covers the wireframe and vertex overlay
+ * draws; the FDF line surface is the scene itself and counts as SCENE. ANTI_ALIASING is the
+ * MSAA resolve or the FXAA pass; the extra raster cost of MSAA shows up in SCENE.
+ */
+enum class GpuPass {
+    SCENE,
+    WIREFRAME_POINTS,
+    ANTI_ALIASING,
+    POST_PROCESS,
+    UI,
+    COUNT
+};
+
+/**
+ * @struct GpuTimerStats
+ * @brief Smoothed GPU milliseconds per pass.
+ */
+struct GpuTimerStats {
+    float passMs[static_cast<size_t>(GpuPass::COUNT)] = {};
+    float totalMs = 0.0f;
+    size_t droppedFrames = 0;   ///< Frames whose results were still pending when their ring slot was reused
+};
+
+/**
+ * @class GpuTimer
+ * @brief Process-wide GL_TIME_ELAPSED query ring (one context, like GLState).
+ *
+ * Time-elapsed queries cannot nest, so only one pass is open at a time: begin() closes the
+ * open pass first, and a pass may be opened several times per frame (the render queue
+ * switches between scene and overlay draws); its segments are summed.
+ */
+class GpuTimer {
+    private:
+        static const size_t FRAME_LATENCY = 4;
+
+        struct FrameQueries {
+            std::vector<unsigned int> queries;
+            std::vector<GpuPass> passes;
+            size_t used = 0;
+        };
+
+        static FrameQueries _frames[FRAME_LATENCY];
+        static size_t _frame;
+        static int _activePass;
+        static bool _hasSample;
+        static GpuTimerStats _stats;
+
+        static void collect(FrameQueries &frame);
+
+    public:
+        static void beginFrame();
+        static void begin(GpuPass pass);
+        static void end();
+        static void shutdown();
+
+        static const GpuTimerStats &getStats() { return _stats; }
+        static const char *getPassName(GpuPass pass);
+};
+
+#endif
@@ -0,0 +1,53 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HeadlessContext.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/26 09:05:51 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/26 12:31:16 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file HeadlessContext.hpp
+ * @brief Declaration of the HeadlessContext creating an OpenGL context without a window.
+ *
+ * Render nodes and CI machines have no display server, so GLFW cannot open a window there.
+ * EGL can still create an OpenGL 3.3 core context with no surface at all (Mesa's surfaceless
+ * platform, which runs on llvmpipe with no GPU); everything then renders into framebuffer
+ * objects. Only available where EGL is (Linux); elsewhere the context is never valid.
+ */
+
+#pragma once
+
+#ifndef HEADLESSCONTEXT_HPP
+# define HEADLESSCONTEXT_HPP
+
+# include <string>
+
+/**
+ * @class HeadlessContext
+ * @brief EGL display and surfaceless OpenGL 3.3 core context, current on the creating thread.
+ *
+ * EGL handles are kept as void pointers so EGL headers stay out of the rest of the build.
+ */
+class HeadlessContext {
+    private:
+        void *_display;
+        void *_context;
+        std::string _renderer;
+
+    public:
+        HeadlessContext();
+        ~HeadlessContext();
+
+        HeadlessContext(const HeadlessContext &) = delete;
+        HeadlessContext &operator=(const HeadlessContext &) = delete;
+
+        bool isValid() const { return _context != nullptr; }
+        const std::string &getRendererName() const { return _renderer; }
+};
+
+#endif
@@ -0,0 +1,99 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HeadlessRenderer.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/26 10:12:08 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/26 16:54:33 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file HeadlessRenderer.hpp
+ * @brief Declaration of the HeadlessRenderer writing images of a model without a window.
+ *
+ * Runs the viewer's frame (camera, LOD selection, render queue, post-processing chain and
+ * anti-aliasing) into an off-screen target instead of the backbuffer, and saves the result
+ * through the asynchronous capture. Used with a HeadlessContext on machines with no display.
+ */
+
+#pragma once
+
+#ifndef HEADLESSRENDERER_HPP
+# define HEADLESSRENDERER_HPP
+
+# include "./Parser.hpp"
+# include "./Mesh.hpp"
+# include "./Renderer.hpp"
+# include "./InputManager.hpp"
+# include "./TextureLoader.hpp"
+# include "./PostProcessor.hpp"
+# include "./RenderTargetPool.hpp"
+# include "./FrameCapture.hpp"
+# include <memory>
+# include <string>
+# include <unordered_map>
+
+/**
+ * @struct HeadlessOptions
+ * @brief Image size and the viewer settings a headless render uses.
+ */
+struct HeadlessOptions {
+    int width = 1920;
+    int height = 1080;
+    AntiAliasing antiAliasing = AntiAliasing::OFF;
+    bool crt = false;
+    bool useTexture = false;
+    bool wireframe = false;
+    bool orthographic = false;
+};
+
+/**
+ * @class HeadlessRenderer
+ * @brief Renders models into an off-screen target and saves them as PNG.
+ *
+ * Needs a current context for its whole lifetime. One instance serves any number of models:
+ * the post-processor, targets and capture ring are reused, and file writes run on the
+ * capture's workers while the next model renders. Images are only guaranteed on disk after
+ * flush() (or destruction).
+ */
+class HeadlessRenderer {
+    private:
+        Renderer *_renderer;
+        HeadlessOptions _options;
+        std::unique_ptr<TextureLoader> _textureLoader;
+        std::unique_ptr<PostProcessor> _postProcessor;
+        std::unique_ptr<RenderTargetPool> _targets;
+        std::unique_ptr<FrameCapture> _capture;
+        RenderTarget *_output;
+        size_t _encoders;
+
+        struct Scene {
+            Parser *parser;
+            Mesh *mesh;
+            std::unique_ptr<InputManager> camera;
+            std::unordered_map<int, std::shared_ptr<Texture>> materialTextures;
+            std::shared_ptr<Texture> texture;
+        };
+
+        bool prepare(Scene &scene, Parser &parser, Mesh &mesh);
+        void renderFrame(Scene &scene, float time);
+
+    public:
+        HeadlessRenderer(Renderer *renderer, const HeadlessOptions &options, size_t encoders = 1);
+        ~HeadlessRenderer();
+
+        HeadlessRenderer(const HeadlessRenderer &) = delete;
+        HeadlessRenderer &operator=(const HeadlessRenderer &) = delete;
+
+        bool renderImage(Parser &parser, Mesh &mesh, const std::string &path);
+        bool renderTurntable(Parser &parser, Mesh &mesh, const std::string &directory, int frames);
+        void flush();
+        void trimTextureCache(size_t maxTextures);
+
+        FrameCaptureStats getCaptureStats() { return _capture->getStats(); }
+};
+
+#endif
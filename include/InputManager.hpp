@@ -19,6 +19,7 @@
 # include <glad/glad.h>
 # include <GLFW/glfw3.h>
 # include "./Types.hpp"
+# include "./GLState.hpp"
 # include "./Parser.hpp"
 # include "glm/glm.hpp"
 # include "glm/gtc/matrix_transform.hpp"
@@ -62,6 +63,9 @@ class InputManager {
 		// Timing
 		float _deltaTime;
 		float _lastFrame;
+
+		// Set by every window event, consumed once per loop iteration
+		bool _pendingEvents = true;
 		
 		// Field of view
 		float _fov = 45.0f;
@@ -73,6 +77,7 @@ class InputManager {
 		std::function<void(bool)> _onAutoRotationToggle;
 		std::function<void(bool)> _onCRTToggle;
 		std::function<void(bool)> _onTextureToggle;
+		std::function<void()> _onScreenshot;
 		
 		bool _useOrthographic = false;
 		bool _wireframeMode = false;
@@ -92,8 +97,11 @@ class InputManager {
 		glm::vec3 getCameraPosition() const;
 		bool getAutorotationStatus() const;
 		std::vector<glm::mat4> getMatrices() const;
+		float getProjectedSize(float viewportHeight) const;
 		
 		void setDeltaTime(float currentFrame);
+		void resetFrameClock(float currentFrame);
+		bool consumeEvents();
 		void setAspectRatio(float aspectRatio);
 		void setViewportBounds(const glm::vec4& bounds);
 		void setUseOrthographic(bool useOrtho);
@@ -115,6 +123,10 @@ class InputManager {
 		static void mouseCallbackWrapper(GLFWwindow* window, double xpos, double ypos);
 		static void scrollCallbackWrapper(GLFWwindow* window, double xoffset, double yoffset);
 		static void keyCallbackWrapper(GLFWwindow* window, int key, int scancode, int action, int mods);
+		static void charCallbackWrapper(GLFWwindow* window, unsigned int codepoint);
+		static void cursorEnterCallbackWrapper(GLFWwindow* window, int entered);
+		static void windowFocusCallbackWrapper(GLFWwindow* window, int focused);
+		static void windowRefreshCallbackWrapper(GLFWwindow* window);
 		
 		// Instance methods for callbacks
 		void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
@@ -129,10 +141,12 @@ class InputManager {
 		void setAutoRotationToggleCallback(std::function<void(bool)> callback);
 		void setCRTToggleCallback(std::function<void(bool)> callback);
 		void setTextureToggleCallback(std::function<void(bool)> callback);
+		void setScreenshotCallback(std::function<void()> callback);
 		
 		// Getters for current state
 		bool isUsingOrthographic() const { return _useOrthographic; }
 		bool isWireframeMode() const { return _wireframeMode; }
+		glm::vec3 getModelRotation() const { return _modelRotation; }
 };
 
 #endif
\ No newline at end of file
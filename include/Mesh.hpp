@@ -16,8 +16,37 @@
 # define MESH_HPP
 
 #include "./ErrorManager.hpp"
+#include "./GLState.hpp"
 #include "./Parser.hpp"
 
+/**
+ * @struct DrawChunk
+ * @brief Contiguous slice of an index buffer drawn with a single glDrawElementsBaseVertex call.
+ *
+ * With 16-bit indices every chunk stores indices relative to baseVertex, so meshes with more
+ * than 65,536 vertices are split into chunks whose vertex span fits in an unsigned short.
+ */
+struct DrawChunk {
+    size_t firstIndex;  ///< Offset into the index buffer, in indices
+    int indexCount;     ///< Number of indices in the chunk
+    int baseVertex;     ///< Added to every index by the GL before fetching vertices
+};
+
+/**
+ * @struct LODRanges
+ * @brief Draw chunks of one level of detail; level 0 is the full-resolution mesh.
+ *
+ * groups is empty when the level could not be simplified per material group,
+ * in which case material rendering falls back to level 0.
+ */
+struct LODRanges {
+    std::vector<DrawChunk> triangles;
+    std::vector<DrawChunk> wireframe;
+    std::vector<std::vector<DrawChunk>> groups;
+    size_t primitiveCount = 0;  ///< Triangles, or line segments for an FDF line list
+    float error = 0.0f;
+};
+
 class Mesh {
     private:
         unsigned int _VAO, _VBO, _IBO, _wireframeIBO;
@@ -27,10 +56,26 @@ class Mesh {
         int _wireframeIndexCount;
         Parser *_parser;
 
+        bool _quantized;
+        glm::vec3 _quantOffset;
+        glm::vec3 _quantScale;
+        size_t _vertexBufferSize;
+
+        unsigned int _indexType;
+        size_t _indexBufferSize;
+        std::vector<LODRanges> _lods;
+
+        std::vector<PackedVertex> packVertices();
+        bool buildIndexBuffers(bool splitChunks, std::vector<unsigned int> &indexData, std::vector<unsigned int> &wireframeData);
+        void uploadIndices(unsigned int ibo, const std::vector<unsigned int> &data);
+        void drawChunks(unsigned int mode, unsigned int ibo, const std::vector<DrawChunk> &chunks) const;
+
     public:
-        Mesh(Parser *parser);
+        Mesh(Parser *parser, bool quantize = false);
         ~Mesh();
 
+        static std::vector<unsigned int> buildLineList(const std::vector<unsigned int> &triangleIndices);
+
         int getVertexCount() const;
         int getIndexCount() const;
         int getWireframeIndexCount() const;
@@ -38,9 +83,25 @@ class Mesh {
         unsigned int getBVO() const;
         unsigned int getIBO() const;
         unsigned int getWireframeIBO() const;
+        bool isQuantized() const;
+        const glm::vec3 &getQuantOffset() const;
+        const glm::vec3 &getQuantScale() const;
+        size_t getVertexBufferSize() const;
+        unsigned int getIndexType() const;
+        size_t getIndexBufferSize() const;
+        size_t getChunkCount() const;
+        size_t getLODCount() const;
+        bool isLineList() const;
+        size_t getLODPrimitiveCount(size_t lod) const;
+        float getLODError(size_t lod) const;
 
         void bind();
         void generateWireframeIndices();
+
+        void drawElements(unsigned int mode, size_t lod = 0) const;
+        void drawWireframe(size_t lod = 0) const;
+        void drawMaterialGroup(size_t groupIndex, unsigned int mode, size_t lod = 0) const;
+        void drawPoints() const;
 };
 
 #endif
\ No newline at end of file
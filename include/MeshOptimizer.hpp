@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MeshOptimizer.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/11 10:02:17 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/12 16:20:05 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file MeshOptimizer.hpp
+ * @brief Declaration of the MeshOptimizer helpers for post-load index/vertex reordering.
+ *
+ * OBJ files list triangles in authoring order and the parser emits vertices in the
+ * order they are first seen, which is rarely friendly to the GPU post-transform cache.
+ * MeshOptimizer reorders triangle lists with the Tipsify algorithm (Sander et al.),
+ * optionally sorts the resulting clusters to reduce fragment overdraw, reorders vertices
+ * by first use, and measures the resulting cache and overdraw efficiency.
+ */
+
+#pragma once
+
+#ifndef MESHOPTIMIZER_HPP
+# define MESHOPTIMIZER_HPP
+
+# include <vector>
+# include <cstddef>
+# include "./Types.hpp"
+
+/**
+ * @struct VertexCacheStats
+ * @brief Post-transform cache efficiency of an index buffer under a FIFO cache model.
+ */
+struct VertexCacheStats {
+    float acmr = 0.0f;               ///< Average cache miss ratio (transformed vertices per triangle, 0.5 - 3.0)
+    float atvr = 0.0f;               ///< Average transformed vertex ratio (transformed / referenced vertices, >= 1.0)
+    size_t transformedVertices = 0;  ///< Vertex shader invocations under the simulated cache
+};
+
+/**
+ * @struct OverdrawStats
+ * @brief Fragment overdraw of a triangle order, rasterized from the six axis directions
+ *        outside the mesh and the six cube-map directions from its bounding box center.
+ */
+struct OverdrawStats {
+    float overdraw = 0.0f;      ///< Mean of the outside and inside figures below (1.0 = no overdraw)
+    float outsideOverdraw = 0.0f;   ///< Shaded fragments per covered pixel over the six outside views
+    float insideOverdraw = 0.0f;    ///< Shaded fragments per covered pixel over the six inside views
+    size_t pixelsCovered = 0;   ///< Pixels covered by the mesh, summed over all views
+    size_t pixelsShaded = 0;    ///< Fragments that passed the depth test, summed over all views
+    std::vector<size_t> viewShaded; ///< Fragments shaded per view (outside views, then inside ones)
+};
+
+/**
+ * @class MeshOptimizer
+ * @brief Stateless helpers that reorder triangle lists for vertex cache and vertex fetch locality.
+ *
+ * All functions operate on plain triangle index lists (three indices per triangle) so they can
+ * be applied to the full index buffer or to a single material group independently.
+ */
+class MeshOptimizer {
+    public:
+        static const unsigned int CACHE_SIZE = 16;
+
+        static VertexCacheStats analyzeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount,
+                                                   unsigned int cacheSize = CACHE_SIZE);
+
+        static std::vector<unsigned int> optimizeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount,
+                                                             unsigned int cacheSize = CACHE_SIZE,
+                                                             std::vector<size_t> *clusterStarts = nullptr);
+
+        static OverdrawStats analyzeOverdraw(const std::vector<unsigned int> &indices, const std::vector<Vertex> &vertices);
+
+        static std::vector<unsigned int> optimizeOverdraw(const std::vector<unsigned int> &indices, const std::vector<Vertex> &vertices,
+                                                          const std::vector<size_t> &clusterStarts, float threshold = 1.05f,
+                                                          unsigned int cacheSize = CACHE_SIZE);
+
+        static std::vector<unsigned int> buildFetchRemap(const std::vector<unsigned int> &indices, size_t vertexCount);
+        static void remapVertices(std::vector<Vertex> &vertices, const std::vector<unsigned int> &remap);
+        static void remapIndices(std::vector<unsigned int> &indices, const std::vector<unsigned int> &remap);
+};
+
+#endif
@@ -0,0 +1,47 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MeshSimplifier.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/13 09:41:52 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/13 18:05:37 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file MeshSimplifier.hpp
+ * @brief Declaration of the MeshSimplifier used to build level-of-detail index buffers.
+ *
+ * Simplification works on index lists only: every level of detail keeps referencing the
+ * original vertex buffer, so LODs cost index memory and nothing else. Edges are collapsed
+ * onto one of their existing endpoints (half-edge collapse) in order of quadric error
+ * (Garland & Heckbert), while vertices on open borders and UV/normal seams stay locked.
+ */
+
+#pragma once
+
+#ifndef MESHSIMPLIFIER_HPP
+# define MESHSIMPLIFIER_HPP
+
+# include <vector>
+# include <cstddef>
+# include "./Types.hpp"
+
+/**
+ * @class MeshSimplifier
+ * @brief Stateless quadric-error-metric triangle list simplification.
+ *
+ * Errors (target and result) are expressed relative to the largest dimension of the
+ * bounding box passed in, so 0.01 means "1% of the model size" regardless of units.
+ * Calls share no state and can run in parallel on different index lists.
+ */
+class MeshSimplifier {
+    public:
+        static std::vector<unsigned int> simplify(const std::vector<unsigned int> &indices, const std::vector<Vertex> &vertices,
+                                                  const BoundingBox &bounds, size_t targetIndexCount, float targetError,
+                                                  float *resultError = nullptr);
+};
+
+#endif
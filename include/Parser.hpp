@@ -66,6 +66,7 @@ class Parser {
 		std::vector<unsigned int> _indices;
 		std::vector<Material> _materials;
 		std::vector<MaterialGroup> _materialGroups;
+		std::vector<MeshLOD> _lods;
 
 		std::string _currentMaterial;
 		int _currentMaterialIndex;
@@ -88,6 +89,7 @@ class Parser {
 		const std::vector<unsigned int> &getIndices() const;
 		const std::vector<Material> &getMaterials() const;
 		const std::vector<MaterialGroup> &getMaterialGroups() const;
+		const std::vector<MeshLOD> &getLODs() const;
 		const Material* getMaterialByName(const std::string& name) const;
 		int getMaterialIndex(const std::string& name) const;
 		size_t getRows() const;
@@ -103,6 +105,8 @@ class Parser {
 		void countFDFPositions(const std::string &filePath);
 		void calculateFDFSpacing();
 		void calculateNormals();
+		void optimize(bool reduceOverdraw = false);
+		void generateLODs(size_t maxLevels = 4);
 		void updateMinMaxZ(float newZ);
 		float getZDifference() const;
 		const BoundingBox& getBoundingBox() const;
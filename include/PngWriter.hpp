@@ -0,0 +1,46 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PngWriter.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/24 09:41:27 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/24 15:12:09 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file PngWriter.hpp
+ * @brief Declaration of the PngWriter encoding 8-bit RGB/RGBA images as PNG files.
+ *
+ * Self-contained (no zlib): rows get the adaptive PNG filter, and the filtered data is
+ * compressed with LZ77 and the fixed deflate Huffman code. That is far from the best
+ * compression, but renders with flat backgrounds shrink well and encoding is fast.
+ * Stateless and thread-safe, so capture workers can encode in parallel.
+ */
+
+#pragma once
+
+#ifndef PNGWRITER_HPP
+# define PNGWRITER_HPP
+
+# include <string>
+# include <vector>
+# include <cstdint>
+# include <cstddef>
+
+class PngWriter {
+    private:
+        static uint32_t crc32(uint32_t crc, const uint8_t *data, size_t size);
+        static uint32_t adler32(const uint8_t *data, size_t size);
+        static std::vector<uint8_t> filterRows(const uint8_t *pixels, int width, int height, int channels, bool flipVertically);
+        static std::vector<uint8_t> deflate(const std::vector<uint8_t> &data);
+        static void appendChunk(std::vector<uint8_t> &png, const char *type, const std::vector<uint8_t> &data);
+
+    public:
+        static std::vector<uint8_t> encode(const uint8_t *pixels, int width, int height, int channels, bool flipVertically = false);
+        static bool write(const std::string &path, const uint8_t *pixels, int width, int height, int channels, bool flipVertically = false);
+};
+
+#endif
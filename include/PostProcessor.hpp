@@ -16,27 +16,80 @@
 # include <glad/glad.h>
 # include <glm/glm.hpp>
 # include <memory>
+# include <string>
+# include <vector>
+# include <utility>
 # include "./Shader.hpp"
 # include "./ErrorManager.hpp"
+# include "./RenderTargetPool.hpp"
+# include "./GpuTimer.hpp"
 
+/**
+ * Anti-aliasing modes of the off-screen pipeline. FXAA is a cheap single pass over the
+ * resolved image; MSAA rasterizes the scene target at several samples per pixel (far more
+ * memory and fill cost, but exact on geometry edges and thin lines) and resolves it by a blit.
+ */
+enum class AntiAliasing {
+    OFF,
+    FXAA,
+    MSAA_2X,
+    MSAA_4X,
+    MSAA_8X
+};
+
+/**
+ * @struct PostEffect
+ * @brief One pass of the post-processing chain: a fullscreen shader plus its parameters.
+ *
+ * Every pass receives u_screenTexture (unit 0, the previous pass's output), u_uvScale (the
+ * part of that texture holding the image), u_time and u_resolution (on-screen size); parameters are extra float uniforms set each time the pass runs (the
+ * shader's shadow copy elides the unchanged ones).
+ */
+struct PostEffect {
+    std::string name;
+    std::unique_ptr<Shader> shader;
+    bool enabled = false;
+    std::vector<std::pair<std::string, float>> parameters;
+    GpuPass timerPass = GpuPass::POST_PROCESS;
+};
+
+/**
+ * @class PostProcessor
+ * @brief Ordered chain of post effects between the scene target and the backbuffer.
+ *
+ * The scene renders into a pooled target; enabled passes then ping-pong between it and at
+ * most one intermediate target, and the last pass draws straight into the caller's viewport
+ * on the output framebuffer (the default one unless told otherwise). Disabled passes are skipped without touching any GL state,
+ * and with no pass enabled the caller either bypasses the chain altogether (see isActive())
+ * or, for a scene rendered below viewport size, render() just upscales it with a blit.
+ */
 class PostProcessor {
     private:
-        unsigned int _framebuffer;
-        unsigned int _colorTexture;
-        unsigned int _depthRenderbuffer;
+        RenderTargetPool _pool;
+        RenderTarget *_sceneTarget;
+        std::vector<PostEffect> _effects;
+        size_t _enabledCount;
+        size_t _fxaaEffect;
+        size_t _crtEffect;
+
         unsigned int _quadVAO;
         unsigned int _quadVBO;
         
-        std::unique_ptr<Shader> _postProcessShader;
-        
         int _width;
         int _height;
-        bool _enableCRT;
+        int _capacityWidth;     ///< Allocated size of the pooled targets, at least _width x _height
+        int _capacityHeight;
+        glm::vec2 _outputSize;
         float _time;
+
+        AntiAliasing _antiAliasing;
+        int _samples;
+        int _maxSamples;
         
-        void setupFramebuffer();
         void setupQuad();
         void cleanup();
+        RenderTarget *resolve();
+        void drawPass(PostEffect &effect, const RenderTarget &input);
 
     public:
         PostProcessor(int width, int height);
@@ -44,16 +97,32 @@ class PostProcessor {
         
         void bind();
         void unbind();
-        void render();
+        void render(int x, int y, int width, int height, unsigned int output = 0);
         void resize(int width, int height);
+        void endFrame() { _pool.endFrame(); }
+
+        size_t addEffect(const std::string &name, const std::string &shaderPath);
+        int findEffect(const std::string &name) const;
+        void setEffectEnabled(size_t index, bool enabled);
+        bool isEffectEnabled(size_t index) const { return _effects[index].enabled; }
+        void setEffectParameter(size_t index, const std::string &name, float value);
+        size_t getEffectCount() const { return _effects.size(); }
+        const std::string &getEffectName(size_t index) const { return _effects[index].name; }
         
-        void setEnableCRT(bool enable) { _enableCRT = enable; }
-        bool getEnableCRT() const { return _enableCRT; }
+        void setEnableCRT(bool enable) { setEffectEnabled(_crtEffect, enable); }
+        bool getEnableCRT() const { return isEffectEnabled(_crtEffect); }
+        void setAntiAliasing(AntiAliasing mode);
+        AntiAliasing getAntiAliasing() const { return _antiAliasing; }
+        int getMaxSamples() const { return _maxSamples; }
+        static int getSampleCount(AntiAliasing mode);
+
+        // False when every effect and MSAA are off: unless it renders at a reduced scale, the
+        // scene can then go straight to the backbuffer
+        bool isActive() const { return _enabledCount > 0 || _samples > 0; }
         
         void updateTime(float time) { _time = time; }
-        
-        unsigned int getFramebuffer() const { return _framebuffer; }
-        unsigned int getColorTexture() const { return _colorTexture; }
+
+        RenderTargetPoolStats getTargetStats() const { return _pool.getStats(); }
 };
 
 #endif
@@ -0,0 +1,64 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ProgramCache.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/18 10:07:44 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/18 15:13:21 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file ProgramCache.hpp
+ * @brief Declaration of the on-disk cache of linked shader program binaries.
+ *
+ * Linking GLSL is the slowest part of startup and every shader variant adds a program.
+ * Linked programs are saved with glGetProgramBinary and restored with glProgramBinary on
+ * the next launch. The cache key hashes both stage sources together with the driver's
+ * vendor, renderer and version strings, so editing a shader or updating the driver simply
+ * misses; a binary the driver rejects is deleted and the program is rebuilt from source.
+ */
+
+#pragma once
+
+#ifndef PROGRAMCACHE_HPP
+# define PROGRAMCACHE_HPP
+
+# include <string>
+# include <cstddef>
+
+/**
+ * @struct ProgramCacheStats
+ * @brief Cache activity since startup.
+ */
+struct ProgramCacheStats {
+    size_t hits = 0;        ///< Programs restored from a binary
+    size_t misses = 0;      ///< Programs compiled from source
+    size_t rejected = 0;    ///< Binaries found but refused by the driver (stale/corrupt)
+};
+
+/**
+ * @class ProgramCache
+ * @brief Stateless load/store of program binaries (requires GLExtensions::programBinary).
+ *
+ * Files live in $SCOP_CACHE_DIR, else $XDG_CACHE_HOME/scop, else ~/.cache/scop.
+ */
+class ProgramCache {
+    private:
+        static ProgramCacheStats _stats;
+
+        static std::string getPath(const std::string &key);
+
+    public:
+        static std::string makeKey(const std::string &vertexSource, const std::string &fragmentSource);
+        static unsigned int load(const std::string &key);
+        static void store(const std::string &key, unsigned int program);
+        static void recordMiss();
+
+        static std::string getDirectory();
+        static const ProgramCacheStats &getStats();
+};
+
+#endif
@@ -0,0 +1,185 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RenderQueue.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/16 10:04:27 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/16 17:31:50 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file RenderQueue.hpp
+ * @brief Declaration of the RenderQueue used to sort draw submissions before execution.
+ *
+ * Passes no longer draw in the order they walk their data (file order for material groups).
+ * They submit DrawItems instead; each item gets a packed 64-bit sort key, the queue radix-sorts
+ * the keys and the renderer executes the items in key order. The key layout decides what the
+ * GPU sees: layers first (opaque, overlay, transparent), then program and texture so equal state
+ * is contiguous, then depth - front to back for opaque work, back to front for transparency.
+ */
+
+#pragma once
+
+#ifndef RENDERQUEUE_HPP
+# define RENDERQUEUE_HPP
+
+# include "./Types.hpp"
+# include <vector>
+# include <memory>
+# include <unordered_map>
+# include <cstdint>
+# include <cstddef>
+
+class Shader;
+class Mesh;
+class Texture;
+
+/**
+ * @enum RenderLayer
+ * @brief Coarse ordering buckets, executed in this order.
+ */
+enum class RenderLayer : uint8_t {
+    OPAQUE = 0,         ///< Depth-tested geometry, sorted by state, then front to back
+    OVERLAY = 1,        ///< Debug overlays drawn on top of the opaque scene (vertex points)
+    TRANSPARENT = 2     ///< Blended geometry, sorted back to front before state
+};
+
+/**
+ * @enum DrawKind
+ * @brief What an item draws, which also decides the shader mode uniforms.
+ */
+enum class DrawKind : uint8_t {
+    TRIANGLES,
+    LINES,
+    WIREFRAME,
+    POINTS
+};
+
+/**
+ * @struct DrawItem
+ * @brief One draw submission: the state it needs plus what to draw.
+ */
+struct DrawItem {
+    Shader *shader = nullptr;
+    const Mesh *mesh = nullptr;
+    const Texture *texture = nullptr;   ///< Bound to unit 0 when useTexture is set
+    DrawKind kind = DrawKind::TRIANGLES;
+    RenderLayer layer = RenderLayer::OPAQUE;
+    int group = -1;                     ///< Material group index, -1 draws the whole mesh
+    int material = -1;                  ///< Material index, used as a sort criterion only
+    size_t lod = 0;
+    bool useTexture = false;
+    float depth = 0.0f;                 ///< View distance, used for front/back ordering
+};
+
+/**
+ * @struct RenderQueueStats
+ * @brief What the last executed queue cost in state.
+ */
+struct RenderQueueStats {
+    size_t items = 0;           ///< Draw items executed
+    size_t stateSwitches = 0;   ///< Program or texture changes between consecutive items
+};
+
+/**
+ * @class RenderQueue
+ * @brief Collects DrawItems for one frame and orders them by sort key.
+ *
+ * Keys are sorted with an LSD radix sort (8 passes of 8 bits, stable), skipping passes in
+ * which every key has the same byte. Item storage is reused from frame to frame.
+ */
+class RenderQueue {
+    private:
+        struct SortEntry {
+            uint64_t key;
+            uint32_t index;
+        };
+
+        std::vector<DrawItem> _items;
+        std::vector<SortEntry> _entries;
+        std::vector<SortEntry> _scratch;
+        std::vector<uint32_t> _order;
+
+        static uint64_t makeKey(const DrawItem &item);
+        static uint32_t depthBits(float depth);
+
+    public:
+        void submit(const DrawItem &item);
+        const std::vector<uint32_t> &sort();
+        void clear();
+
+        const DrawItem &operator[](size_t index) const;
+        size_t size() const;
+        bool empty() const;
+};
+
+/**
+ * @struct SceneDraw
+ * @brief One draw of a model as planned by planSceneDraws(), for any backend.
+ */
+template <typename TextureType>
+struct SceneDraw {
+    DrawKind kind = DrawKind::TRIANGLES;
+    int group = -1;                         ///< Material group index, -1 draws the whole mesh
+    int material = -1;
+    const TextureType *texture = nullptr;   ///< Triangle draws only
+    bool useTexture = false;
+};
+
+/**
+ * Plan Scene Draws - Decides how a model is drawn, shared by the viewer and headless backends
+ *
+ * FLOW:
+ * 1. Wireframe: the whole mesh as a single wireframe draw
+ * 2. No material groups or no material textures: the whole mesh, with the fallback texture
+ * 3. Otherwise one draw per non-empty material group, with its material's texture
+ *    (the fallback when that material has none)
+ * Mode 0 (OBJ) draws triangles, anything else (FDF) lines, which take no texture.
+ */
+template <typename TextureType>
+std::vector<SceneDraw<TextureType>> planSceneDraws(const std::vector<MaterialGroup> &groups, int mode,
+                                                   const std::unordered_map<int, std::shared_ptr<TextureType>> &materialTextures,
+                                                   const TextureType *fallback, bool useTexture, bool wireframe) {
+    std::vector<SceneDraw<TextureType>> draws;
+    DrawKind kind = mode == 0 ? DrawKind::TRIANGLES : DrawKind::LINES;
+
+    if (wireframe) {
+        SceneDraw<TextureType> draw;
+        draw.kind = DrawKind::WIREFRAME;
+        draws.push_back(draw);
+        return draws;
+    }
+
+    if (groups.empty() || materialTextures.empty()) {
+        SceneDraw<TextureType> draw;
+        draw.kind = kind;
+        if (kind == DrawKind::TRIANGLES) {
+            draw.texture = fallback;
+            draw.useTexture = useTexture;
+        }
+        draws.push_back(draw);
+        return draws;
+    }
+
+    for (size_t groupIndex = 0; groupIndex < groups.size(); ++groupIndex) {
+        const MaterialGroup &group = groups[groupIndex];
+        if (group.indices.empty()) continue;
+
+        SceneDraw<TextureType> draw;
+        draw.kind = kind;
+        draw.group = static_cast<int>(groupIndex);
+        draw.material = group.materialIndex;
+        if (kind == DrawKind::TRIANGLES) {
+            auto textureIt = materialTextures.find(group.materialIndex);
+            draw.texture = textureIt != materialTextures.end() ? textureIt->second.get() : fallback;
+            draw.useTexture = useTexture;
+        }
+        draws.push_back(draw);
+    }
+    return draws;
+}
+
+#endif
@@ -0,0 +1,96 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RenderScheduler.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/19 09:12:44 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/19 16:48:03 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file RenderScheduler.hpp
+ * @brief Declaration of the RenderScheduler deciding whether a loop iteration renders a frame.
+ *
+ * A static model with no input, no auto-rotation and no animated post effect produces the
+ * same image every frame. In on-demand mode the main loop blocks in glfwWaitEventsTimeout
+ * while nothing is dirty and leaves the last presented frame on screen; input, UI changes
+ * and animations request frames. Process CPU time is sampled so the saving is measurable.
+ */
+
+#pragma once
+
+#ifndef RENDERSCHEDULER_HPP
+# define RENDERSCHEDULER_HPP
+
+# include <GLFW/glfw3.h>
+# include <ctime>
+# include <cstddef>
+
+/**
+ * @struct RenderSchedulerStats
+ * @brief Rendered frame rate and process CPU usage, while active and over the last idle period.
+ *
+ * CPU usage is process CPU time over wall time (100% = one core busy). GPU work is only
+ * submitted for rendered frames, so framesPerSecond is the GPU load indicator.
+ */
+struct RenderSchedulerStats {
+    bool onDemand = true;
+    bool animating = false;
+    float framesPerSecond = 0.0f;   ///< Frames rendered per second over the last active second
+    float cpuUsage = 0.0f;          ///< CPU usage over the last active second
+    float idleSeconds = 0.0f;       ///< Length of the last idle period
+    float idleCpuUsage = 0.0f;      ///< CPU usage during the last idle period
+    size_t idleWakeups = 0;         ///< Loop iterations that found nothing to redraw in the last idle period
+};
+
+/**
+ * @class RenderScheduler
+ * @brief Dirty tracking for the main loop: render when something changed, otherwise wait.
+ *
+ * Each loop iteration calls waitForEvents(), reports what changed (requestRedraw, setAnimating)
+ * and renders only if beginFrame() returns true. A redraw request covers a few frames because
+ * ImGui reacts to input one frame late (hover, click release, widget state applied on render).
+ */
+class RenderScheduler {
+    private:
+        bool _onDemand;
+        bool _animating;
+        int _pendingFrames;
+        double _idleTimeout;
+
+        bool _idle;
+        bool _resumed;
+        double _idleStart;
+        std::clock_t _idleClock;
+        size_t _idleWakeups;
+
+        double _windowStart;
+        std::clock_t _windowClock;
+        size_t _windowFrames;
+
+        RenderSchedulerStats _stats;
+
+        static float cpuPercent(std::clock_t cpuStart, double wallSeconds);
+
+    public:
+        static const int REDRAW_FRAMES = 3;
+
+        explicit RenderScheduler(double idleTimeout = 0.5);
+
+        void setOnDemand(bool onDemand);
+        bool isOnDemand() const { return _onDemand; }
+        void setAnimating(bool animating);
+        void requestRedraw(int frames = REDRAW_FRAMES);
+        bool isActive() const { return !_onDemand || _animating || _pendingFrames > 0; }
+
+        void waitForEvents();
+        bool beginFrame();
+        bool resumedFromIdle() const { return _resumed; }
+
+        const RenderSchedulerStats &getStats() const { return _stats; }
+};
+
+#endif
@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RenderTargetPool.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/22 09:14:37 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/22 16:31:05 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file RenderTargetPool.hpp
+ * @brief Declaration of the RenderTargetPool recycling off-screen framebuffers.
+ *
+ * Framebuffers are requested by description (size, color format, depth attachment) and
+ * handed back when the pass that wrote them has been consumed. Released targets stay
+ * allocated and are handed out again to the next request with the same description, so a
+ * steady frame allocates nothing; targets nobody asked for in a while are deleted.
+ */
+
+#pragma once
+
+#ifndef RENDERTARGETPOOL_HPP
+# define RENDERTARGETPOOL_HPP
+
+# include <glad/glad.h>
+# include <vector>
+# include <memory>
+# include <cstddef>
+
+/**
+ * @struct RenderTargetDesc
+ * @brief Pool key: targets are only shared between requests with identical descriptions.
+ */
+struct RenderTargetDesc {
+    int width = 0;
+    int height = 0;
+    GLenum format = GL_RGB8;    ///< Sized internal format of the color texture
+    bool depth = false;         ///< Depth/stencil renderbuffer attached
+    int samples = 0;            ///< > 0: multisampled renderbuffers, resolved by blitting
+
+    bool operator==(const RenderTargetDesc &other) const {
+        return width == other.width && height == other.height
+            && format == other.format && depth == other.depth && samples == other.samples;
+    }
+};
+
+/**
+ * @struct RenderTarget
+ * @brief Framebuffer with a linearly filtered color texture and an optional depth renderbuffer.
+ *
+ * Multisampled targets cannot be sampled: their color is a renderbuffer (colorTexture
+ * stays 0) and they are read by resolving into a single-sampled target.
+ */
+struct RenderTarget {
+    RenderTargetDesc desc;
+    unsigned int framebuffer = 0;
+    unsigned int colorTexture = 0;
+    unsigned int colorRenderbuffer = 0;
+    unsigned int depthRenderbuffer = 0;
+    bool inUse = false;
+    size_t lastUsedFrame = 0;
+};
+
+/**
+ * @struct RenderTargetPoolStats
+ * @brief Allocated targets and their approximate video memory.
+ */
+struct RenderTargetPoolStats {
+    size_t targets = 0;
+    size_t inUse = 0;
+    size_t bytes = 0;
+    size_t allocations = 0;     ///< Targets created since startup (stays flat while the chain is stable)
+};
+
+/**
+ * @class RenderTargetPool
+ * @brief Hands out framebuffers by description and keeps released ones for reuse.
+ *
+ * Pointers returned by acquire() stay valid until the target is deleted by purge(),
+ * endFrame() or the destructor, which only ever delete released targets.
+ */
+class RenderTargetPool {
+    private:
+        std::vector<std::unique_ptr<RenderTarget>> _targets;
+        size_t _frame;
+        size_t _maxIdleFrames;
+        size_t _allocations;
+
+        static bool create(RenderTarget &target);
+        static void destroy(RenderTarget &target);
+        static size_t bytesPerPixel(GLenum format);
+
+    public:
+        explicit RenderTargetPool(size_t maxIdleFrames = 120);
+        ~RenderTargetPool();
+
+        RenderTargetPool(const RenderTargetPool &) = delete;
+        RenderTargetPool &operator=(const RenderTargetPool &) = delete;
+
+        RenderTarget *acquire(const RenderTargetDesc &desc);
+        void release(RenderTarget *target);
+
+        void endFrame();
+        void purge();
+
+        RenderTargetPoolStats getStats() const;
+};
+
+#endif
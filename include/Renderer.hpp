@@ -18,6 +18,8 @@
  * handling mesh rendering with support for multiple visualization modes including wireframe,
  * solid, and textured rendering. It manages shader uniforms, transformation matrices,
  * and provides both single-material and multi-material rendering capabilities.
+ * Camera, light and model transforms reach the shaders through shared uniform buffers.
+ * Draws are submitted to a RenderQueue and executed in sort-key order on flush().
  */
 
 #ifndef RENDERER_HPP
@@ -30,7 +32,24 @@
 # include "Mesh.hpp"
 # include "Shader.hpp"
 # include "ErrorManager.hpp"
+# include "UniformBuffer.hpp"
+# include "RenderQueue.hpp"
+# include "GpuTimer.hpp"
+# include "Texture.hpp"
 # include "glm/gtc/type_ptr.hpp"
+# include <memory>
+
+/**
+ * @enum ShaderVariant
+ * @brief Permutations of the 3D shader, each compiled with the matching #define.
+ */
+enum class ShaderVariant {
+    LINE,           ///< Flat line color, no lighting or texture fetch
+    POINT,          ///< Flat vertex color with program point size
+    TEXTURED,       ///< Lit, base color sampled from the bound texture
+    UNTEXTURED,     ///< Lit, constant base color
+    COUNT
+};
 
 /**
  * @class Renderer
@@ -39,26 +58,54 @@
  * The Renderer class provides a high-level interface for rendering 3D geometry using OpenGL.
  * Key features include:
  * - Multiple rendering modes (wireframe, solid, textured)
- * - Transformation matrix management (Model-View-Projection)
+ * - Transformation matrix management (Model-View-Projection) through std140 uniform buffers
  * - Texture mode toggle support
  * - Multi-material rendering for complex models
+ * - Sorted draw submission (state-coherent, front to back, transparency last)
  * - Vertex visualization for debugging
+ * - Level-of-detail selection from the projected model size
  * - Shader uniform management
+ * - Precompiled shader variants chosen per draw item instead of per-fragment branches
  *
  * The renderer works closely with the Mesh and Shader classes to provide efficient
  * GPU-accelerated rendering with modern OpenGL practices.
  */
 class Renderer {
     private:
-        Shader* _shader;
+        Shader* _shader;    // Source of the variants, never compiled itself
+        std::unique_ptr<Shader> _variants[static_cast<size_t>(ShaderVariant::COUNT)];
+        std::unique_ptr<UniformBuffer> _frameBuffer;
+        std::unique_ptr<UniformBuffer> _objectBuffer;
+        RenderQueue _queue;
+        RenderQueueStats _queueStats;
+
+        void execute(const DrawItem &item);
+        Shader *selectVariant(const DrawItem &item) const;
 
     public:
+        // Largest simplification error, in pixels, a LOD may show on screen
+        static constexpr float LOD_PIXEL_ERROR = 1.0f;
+
         Renderer(Shader *shader);
-        
-        void setMatrices(const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection);
+        ~Renderer();
+
+        void initialize();
+        void setFrameData(const glm::mat4& view, const glm::mat4& projection, const glm::vec3 &cameraPos);
+        void setObjectData(const glm::mat4& model);
+        void setMeshUniforms(const Mesh &mesh);
+        size_t selectLOD(const Mesh &mesh, float projectedSize) const;
+
+        void submit(const DrawItem &item);
+        void submitMesh(const Mesh &mesh, int mode, bool showVertices, bool wireframeMode, bool useTexture,
+                        const Texture *texture = nullptr, size_t lod = 0, float depth = 0.0f);
+        void submitModel(const Mesh &mesh, const std::vector<MaterialGroup> &groups,
+                         const std::unordered_map<int, std::shared_ptr<Texture>> &materialTextures,
+                         const Texture *fallback, int mode, bool showVertices, bool wireframeMode, bool useTexture,
+                         size_t lod = 0, float depth = 0.0f);
+        void submitVertices(const Mesh &mesh, float depth = 0.0f);
+        void flush();
 
-        void draw(Mesh &mesh, int mode, const glm::vec3 &cameraPos, bool showVertices, bool wireframeMode, bool useTexture);
-        void drawMaterialGroup(Mesh &mesh, const std::vector<unsigned int>& indices, int mode, const glm::vec3 &cameraPos, bool showVertices = false);
+        const RenderQueueStats &getQueueStats() const;
 };
 
 #endif
\ No newline at end of file
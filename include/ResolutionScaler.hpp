@@ -0,0 +1,81 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ResolutionScaler.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/23 09:32:18 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/23 17:05:41 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file ResolutionScaler.hpp
+ * @brief Declaration of the ResolutionScaler choosing the scene's render scale.
+ *
+ * The scene can render into an off-screen target smaller than the viewport, which the
+ * composite pass then upscales. In dynamic mode the scale follows the measured GPU frame
+ * time: it drops while a frame exceeds the budget and climbs back once there is headroom,
+ * so dense models stay interactive on slower GPUs and render at full size elsewhere.
+ */
+
+#pragma once
+
+#ifndef RESOLUTIONSCALER_HPP
+# define RESOLUTIONSCALER_HPP
+
+# include <cstddef>
+
+/**
+ * @struct ResolutionStats
+ * @brief Current render scale and the scene size it produced this frame.
+ */
+struct ResolutionStats {
+    bool dynamic = true;
+    float scale = 1.0f;
+    float budgetMs = 16.0f;
+    int renderWidth = 0;
+    int renderHeight = 0;
+    int viewportWidth = 0;      ///< Render area in framebuffer pixels (HiDPI aware)
+    int viewportHeight = 0;
+    size_t changes = 0;         ///< Scale adjustments made by the controller since startup
+};
+
+/**
+ * @class ResolutionScaler
+ * @brief Feedback controller from GPU frame time to render scale.
+ *
+ * GPU cost of the scene grows with the pixel count, i.e. with the square of the scale, so
+ * each adjustment moves the scale by the square root of the budget/time ratio. The scale is
+ * quantized and only changes after the smoothed timer has settled on the previous one,
+ * which keeps it from oscillating and from reallocating render targets every frame.
+ */
+class ResolutionScaler {
+    private:
+        bool _dynamic;
+        float _manualScale;
+        float _scale;
+        float _budgetMs;
+        float _minScale;
+        int _settleFrames;
+        ResolutionStats _stats;
+
+    public:
+        static constexpr float SCALE_STEP = 0.05f;
+        static constexpr int SETTLE_FRAMES = 15;
+
+        explicit ResolutionScaler(float budgetMs = 16.0f, float minScale = 0.5f);
+
+        void setDynamic(bool dynamic);
+        void setManualScale(float scale);
+        void setBudget(float budgetMs);
+
+        void update(float gpuMs);
+        void apply(int viewportWidth, int viewportHeight, int &renderWidth, int &renderHeight, bool fullScale = false);
+
+        float getScale() const { return _scale; }
+        const ResolutionStats &getStats() const { return _stats; }
+};
+
+#endif
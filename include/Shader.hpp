@@ -19,8 +19,39 @@
 # include <iostream>
 # include <fstream>
 # include <sstream>
+# include <unordered_map>
+# include <unordered_set>
+# include <vector>
 # include "ErrorManager.hpp"
 # include "Types.hpp"
+# include "UniformBuffer.hpp"
+# include "GLState.hpp"
+
+/**
+ * @struct UniformSlot
+ * @brief Reflected uniform location plus a shadow copy of the last value uploaded to it.
+ */
+struct UniformSlot {
+    int location = -1;
+    unsigned int type = 0;
+    size_t valueSize = 0;       ///< Bytes of the shadowed value, 0 until first upload
+    float value[16] = {};       ///< Shadow copy (large enough for a mat4)
+};
+
+/**
+ * @struct UniformStats
+ * @brief Uniform traffic of the current frame, shared by all shaders.
+ *
+ * Before the location cache every request cost a glGetUniformLocation plus a glUniform*
+ * call; now only uploads reach the driver and unchanged values are skipped.
+ */
+struct UniformStats {
+    size_t requests = 0;    ///< setUniform calls made by the application
+    size_t uploads = 0;     ///< glUniform* calls actually issued
+    size_t skipped = 0;     ///< Requests elided because the shadow value matched
+    size_t blockUpdates = 0;    ///< Uniform buffer updates requested (per-frame and per-object blocks)
+    size_t blockUploads = 0;    ///< glBufferSubData calls actually issued for them
+};
 
 class Shader {
     private:
@@ -28,25 +59,46 @@ class Shader {
         unsigned int _fs;
         unsigned int _id;
         ShaderProgramSource _shaderSource;
+        std::string _cacheKey;
+        bool _fromCache;
+        std::unordered_map<std::string, UniformSlot> _uniforms;
+        std::unordered_set<std::string> _missingUniforms;
+
+        static UniformStats _frameStats;
 
-        unsigned int createShader(const std::string &vertexShader, const std::string &fragmentShader);
         unsigned int compileShader(unsigned int type, const std::string &source);
+        static bool checkShader(unsigned int id, unsigned int type);
         ShaderProgramSource parseShader(const std::string &filepath);
+        static std::string applyDefines(const std::string &source, const std::vector<std::string> &defines);
+        void reflectUniforms();
+        UniformSlot *updateShadow(const std::string &name, const void *data, size_t size);
     
     public:
         Shader(std::string shaderpath);
+        Shader(const Shader &base, const std::vector<std::string> &defines);
         ~Shader();
+
+        Shader(const Shader &) = delete;
+        Shader &operator=(const Shader &) = delete;
         void use() const;
 
         unsigned int getID() const;
 
-        void compile();
+        bool compile();
+        void beginCompile();
+        bool finishCompile();
+        bool isFromCache() const;
+        bool hasUniform(const std::string &name) const;
 
         void setUniform(const std::string& name, int value);
         void setUniform(const std::string& name, float value);
         void setUniform(const std::string& name, const glm::vec2& vector);
         void setUniform(const std::string& name, const glm::vec3& vector);
         void setUniform(const std::string& name, const glm::mat4& matrix);
+
+        static const UniformStats &getFrameStats();
+        static void resetFrameStats();
+        static void recordBlockUpdate(bool uploaded);
 };
 
 #endif
@@ -0,0 +1,218 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SoftwareRasterizer.hpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/28 09:04:37 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/29 18:26:51 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file SoftwareRasterizer.hpp
+ * @brief Declaration of the SoftwareRasterizer drawing meshes on the CPU without any GL.
+ *
+ * A sort-middle tile renderer: vertices are transformed in parallel, primitives are clipped
+ * and binned to 64x64 screen tiles, and then every tile is rasterized by one thread, four
+ * pixels at a time with SSE2 (scalar lanes elsewhere). Triangles are lit with the Phong model
+ * of 3D.shader, lines get a flat color, and both are depth tested (GL_LESS) against a float
+ * depth buffer. The image matches the GL renderer's direct path closely enough for thumbnails
+ * and image diffs; there is no anti-aliasing or post-processing.
+ */
+
+#pragma once
+
+#ifndef SOFTWARERASTERIZER_HPP
+# define SOFTWARERASTERIZER_HPP
+
+# include "./Types.hpp"
+# include <glm/glm.hpp>
+# include <vector>
+# include <string>
+# include <memory>
+# include <functional>
+# include <thread>
+# include <mutex>
+# include <condition_variable>
+# include <atomic>
+# include <cstdint>
+# include <cstddef>
+
+/**
+ * @struct SoftwareTexture
+ * @brief RGBA8 image sampled like the GL textures (bilinear, clamp to edge, no mipmaps).
+ *
+ * Rows are kept in file order, the order Texture uploads them in, so the flipped V of the
+ * parser's texture coordinates lands on the same texels as on the GPU.
+ */
+struct SoftwareTexture {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> texels;
+
+    static std::shared_ptr<SoftwareTexture> load(const std::string &path);
+};
+
+/**
+ * @struct SoftwareFrameData
+ * @brief The FrameData and ObjectData uniform blocks of 3D.shader.
+ */
+struct SoftwareFrameData {
+    glm::mat4 model = glm::mat4(1.0f);
+    glm::mat4 view = glm::mat4(1.0f);
+    glm::mat4 projection = glm::mat4(1.0f);
+    glm::vec3 viewPos = glm::vec3(0.0f);
+    glm::vec3 lightPos = glm::vec3(5.0f);
+    glm::vec3 lightColor = glm::vec3(1.0f);
+};
+
+/**
+ * @struct SoftwareRasterStats
+ * @brief Work and time per stage of the last frame.
+ */
+struct SoftwareRasterStats {
+    size_t triangles = 0;       ///< Triangles binned, after culling and clipping
+    size_t lines = 0;           ///< Lines binned, after culling and clipping
+    size_t binned = 0;          ///< Primitive references over all tiles (a primitive lands in every tile its bounds touch)
+    size_t tiles = 0;
+    size_t threads = 0;
+    float transformMs = 0.0f;
+    float binMs = 0.0f;
+    float rasterMs = 0.0f;
+};
+
+/**
+ * @class SoftwareRasterizer
+ * @brief CPU renderer for one frame at a time: beginFrame(), submit draws, flush().
+ *
+ * Submitted vertex and index arrays are referenced, not copied, and must stay alive until
+ * flush(). The color buffer is read back bottom row first, like glReadPixels. The output is
+ * the same for any thread count: primitives are binned in fixed-size chunks, and every tile
+ * replays its chunks in submission order. Parallel stages run on a pool of threads - 1
+ * workers started once by the constructor, with the calling thread as the last worker.
+ */
+class SoftwareRasterizer {
+    public:
+        static const int TILE_SIZE = 64;
+        static const int SUBPIXEL_BITS = 4;         ///< Vertex positions are snapped to 1/16 pixel
+        static const int MAX_SIZE = 16384;          ///< Keeps the fixed-point edge functions within 32 bits per tile
+
+    private:
+        struct Command {
+            const std::vector<Vertex> *vertices;
+            const std::vector<unsigned int> *indices;
+            bool lines;
+            glm::vec3 color;
+            const SoftwareTexture *texture;
+            size_t source;
+        };
+
+        struct ClipVertex {
+            glm::vec4 clip;
+            glm::vec3 world;
+            glm::vec3 normal;
+            glm::vec2 uv;
+        };
+
+        /** Screen position in fixed point, window depth, and the attributes divided by w. */
+        struct ScreenVertex {
+            int32_t x, y;
+            float z, invW;
+            float attributes[8];    // world xyz, normal xyz, uv
+        };
+
+        struct Source {
+            const std::vector<Vertex> *vertices;
+            std::vector<ScreenVertex> screen;
+            std::vector<ClipVertex> clip;
+            std::vector<uint8_t> outcodes;
+        };
+
+        struct Primitive {
+            uint32_t vertices[3];   // CLIPPED_VERTEX set: index into the chunk's own vertices
+        };
+
+        struct Chunk {
+            size_t command;
+            size_t first;
+            size_t count;
+            std::vector<ScreenVertex> vertices;
+            std::vector<Primitive> primitives;
+            std::vector<uint32_t> tileStart;
+            std::vector<uint32_t> binned;
+        };
+
+        struct Tile {
+            int x0, y0, x1, y1;
+        };
+
+        static const uint32_t CLIPPED_VERTEX = 0x80000000u;
+
+        size_t _threads;
+        int _width;
+        int _height;
+        int _stride;
+        int _tilesX;
+        int _tilesY;
+        float _guardX;
+        float _guardY;
+        std::vector<uint8_t> _color;
+        std::vector<float> _depth;
+        glm::vec3 _clearColor;
+
+        SoftwareFrameData _frame;
+        glm::mat4 _viewProjection;
+        glm::mat3 _normalMatrix;
+        std::vector<Command> _commands;
+        std::vector<Source> _sources;
+        std::vector<Chunk> _chunks;
+        SoftwareRasterStats _stats;
+
+        std::vector<std::thread> _workers;
+        std::mutex _mutex;
+        std::condition_variable _workReady;
+        std::condition_variable _workDone;
+        const std::function<void(size_t)> *_job;
+        size_t _jobCount;
+        std::atomic<size_t> _nextJob;
+        size_t _generation;
+        size_t _busy;
+        bool _stopping;
+
+        void workerLoop();
+        void runJobs();
+        void parallelFor(size_t count, const std::function<void(size_t)> &job);
+        void transform(size_t source, size_t first, size_t count);
+        ScreenVertex project(const ClipVertex &vertex) const;
+        uint8_t outcode(const glm::vec4 &clip) const;
+        void setupChunk(Chunk &chunk);
+        void clipPrimitive(Chunk &chunk, const Source &source, const unsigned int *indices, size_t vertexCount, uint8_t planes);
+        void binChunk(Chunk &chunk);
+        const ScreenVertex &fetch(const Chunk &chunk, uint32_t index) const;
+        void rasterTile(size_t tileIndex);
+        void rasterTriangle(const Tile &tile, const ScreenVertex *v0, const ScreenVertex *v1, const ScreenVertex *v2, const Command &command);
+        void rasterLine(const Tile &tile, const ScreenVertex *v0, const ScreenVertex *v1, const Command &command);
+
+    public:
+        explicit SoftwareRasterizer(size_t threads = 0);
+        ~SoftwareRasterizer();
+
+        SoftwareRasterizer(const SoftwareRasterizer &) = delete;
+        SoftwareRasterizer &operator=(const SoftwareRasterizer &) = delete;
+
+        bool resize(int width, int height);
+        void beginFrame(const SoftwareFrameData &frame, const glm::vec3 &clearColor);
+        void submitTriangles(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices,
+                             const glm::vec3 &color, const SoftwareTexture *texture = nullptr);
+        void submitLines(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices, const glm::vec3 &color);
+        void flush();
+
+        int getWidth() const { return _width; }
+        int getHeight() const { return _height; }
+        void readPixels(std::vector<uint8_t> &rgb) const;
+        const SoftwareRasterStats &getStats() const { return _stats; }
+};
+
+#endif
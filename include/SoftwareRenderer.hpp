@@ -0,0 +1,84 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SoftwareRenderer.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/29 09:14:02 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/29 18:31:16 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file SoftwareRenderer.hpp
+ * @brief Declaration of the SoftwareRenderer writing model images with the CPU rasterizer.
+ *
+ * The --software counterpart of HeadlessRenderer: the same default view, material groups,
+ * textures and render modes, drawn by the SoftwareRasterizer instead of a GL context, so it
+ * needs no GPU, no display and no EGL. Anti-aliasing and the CRT effect are not available.
+ */
+
+#pragma once
+
+#ifndef SOFTWARERENDERER_HPP
+# define SOFTWARERENDERER_HPP
+
+# include "./HeadlessRenderer.hpp"
+# include "./SoftwareRasterizer.hpp"
+# include "./RenderQueue.hpp"
+# include "./Parser.hpp"
+# include <memory>
+# include <string>
+# include <vector>
+# include <unordered_map>
+
+/**
+ * @struct SoftwareRenderStats
+ * @brief Images written and failed by this renderer.
+ */
+struct SoftwareRenderStats {
+    size_t written = 0;
+    size_t failed = 0;
+};
+
+/**
+ * @class SoftwareRenderer
+ * @brief Renders parsed models with the SoftwareRasterizer and saves them as PNG.
+ *
+ * Images are encoded and written synchronously; the rasterizer already uses every core.
+ */
+class SoftwareRenderer {
+    private:
+        HeadlessOptions _options;
+        std::unique_ptr<SoftwareRasterizer> _rasterizer;
+        std::unordered_map<std::string, std::shared_ptr<SoftwareTexture>> _textureCache;
+        std::vector<uint8_t> _pixels;
+        bool _valid;
+        SoftwareRenderStats _stats;
+
+        struct Scene {
+            Parser *parser;
+            std::unique_ptr<InputManager> camera;
+            std::unordered_map<int, std::shared_ptr<SoftwareTexture>> materialTextures;
+            std::shared_ptr<SoftwareTexture> texture;
+            std::vector<unsigned int> wireframe;
+        };
+
+        std::shared_ptr<SoftwareTexture> loadTexture(const std::string &path);
+        bool prepare(Scene &scene, Parser &parser);
+        void renderFrame(Scene &scene);
+        bool write(const std::string &path);
+
+    public:
+        SoftwareRenderer(const HeadlessOptions &options, size_t threads = 0);
+
+        bool renderImage(Parser &parser, const std::string &path);
+        bool renderTurntable(Parser &parser, const std::string &directory, int frames);
+        void trimTextureCache(size_t maxTextures);
+
+        const SoftwareRenderStats &getStats() const { return _stats; }
+        const SoftwareRasterStats &getRasterStats() const { return _rasterizer->getStats(); }
+};
+
+#endif
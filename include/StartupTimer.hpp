@@ -0,0 +1,49 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   StartupTimer.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/18 11:40:19 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/18 15:14:02 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file StartupTimer.hpp
+ * @brief Wall-clock breakdown of the launch sequence (parse, GL setup, shaders, ...).
+ */
+
+#pragma once
+
+#ifndef STARTUPTIMER_HPP
+# define STARTUPTIMER_HPP
+
+# include <string>
+# include <vector>
+# include <chrono>
+
+/**
+ * @class StartupTimer
+ * @brief Process-wide list of named startup phases.
+ *
+ * mark() closes the current phase: the time since the previous mark is added to the named
+ * phase, so a phase split over several places (e.g. shaders built in two components)
+ * accumulates into one line. report() prints the table once the first frame is ready.
+ */
+class StartupTimer {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        static std::vector<std::pair<std::string, double>> _phases;
+        static Clock::time_point _start;
+        static Clock::time_point _last;
+
+    public:
+        static void begin();
+        static void mark(const std::string &phase);
+        static void report();
+};
+
+#endif
@@ -17,6 +17,7 @@
 
 # include <iostream>
 # include "./ErrorManager.hpp"
+# include "./GLState.hpp"
 # include "./stb_image/stb_image.h"
 # include "glm/glm.hpp"
 # include "glm/gtc/matrix_transform.hpp"
@@ -39,6 +40,7 @@ class Texture {
 
 		int getWidth() const;
 		int getHeigth() const;
+		unsigned int getID() const;
 };
 
 #endif
\ No newline at end of file
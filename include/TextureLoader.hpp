@@ -40,6 +40,7 @@ class TextureLoader {
         bool isValidTexturePath(const std::string& filePath) const;
         
         void clearCache();
+        size_t getCacheSize() const { return _textureCache.size(); }
 };
 
 #endif
\ No newline at end of file
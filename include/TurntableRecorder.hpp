@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TurntableRecorder.hpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/25 09:18:36 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/25 16:40:02 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file TurntableRecorder.hpp
+ * @brief Declaration of the TurntableRecorder rendering a full model turn as numbered PNGs.
+ *
+ * A recording renders a fixed number of frames, the model turned by 360 / frames degrees
+ * per frame. Everything time-based is derived from the frame index rather than from the
+ * wall clock, so the same settings always produce the same images no matter how fast they
+ * render. Frames go through an asynchronous capture with a pool of encoder threads, and the
+ * loop is throttled only by the GPU and the encoders, not by vsync or the frame limiter.
+ */
+
+#pragma once
+
+#ifndef TURNTABLERECORDER_HPP
+# define TURNTABLERECORDER_HPP
+
+# include "./FrameCapture.hpp"
+# include <memory>
+# include <string>
+# include <chrono>
+# include <cstddef>
+
+/**
+ * @struct TurntableStats
+ * @brief Progress of the running (or last) recording.
+ */
+struct TurntableStats {
+    bool recording = false;         ///< Frames still being rendered
+    bool encoding = false;          ///< Rendering done, frames still being written
+    int frame = 0;
+    int frames = 0;
+    size_t written = 0;
+    size_t pending = 0;
+    float framesPerSecond = 0.0f;   ///< Frames written per second since the recording started
+    std::string directory;
+};
+
+/**
+ * @class TurntableRecorder
+ * @brief Per-frame angle and time for a turntable, and the capture that saves its frames.
+ *
+ * Per loop iteration while isActive(): update(); then, while isRecording(), render the
+ * frame at getAngle() / getTime() and captureFrame() once it is composited.
+ */
+class TurntableRecorder {
+    private:
+        std::unique_ptr<FrameCapture> _capture;
+        size_t _encoders;
+        int _frame;
+        int _frames;
+        float _startAngle;
+        std::string _directory;
+        std::chrono::steady_clock::time_point _start;
+        TurntableStats _stats;
+
+        void finish();
+
+    public:
+        static constexpr float FRAME_RATE = 30.0f;  ///< Time base of animated effects, in frames per second
+
+        explicit TurntableRecorder(size_t encoders = 0);
+
+        void start(int frames, float startAngle, const std::string &directory = "");
+        void stop();
+
+        bool isRecording() const { return _capture && _frame < _frames; }
+        bool isActive() const { return _capture != nullptr; }
+        float getAngle() const;
+        float getTime() const { return static_cast<float>(_frame) / FRAME_RATE; }
+
+        void captureFrame(unsigned int framebuffer, int x, int y, int width, int height);
+        void update();
+
+        const TurntableStats &getStats() const { return _stats; }
+};
+
+#endif
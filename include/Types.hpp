@@ -18,6 +18,7 @@
 # include "glm/glm.hpp"
 # include "glm/gtc/matrix_transform.hpp"
 # include "glm/gtc/type_ptr.hpp"
+# include <cstdint>
 
 enum Type {
   OBJ,
@@ -60,6 +61,17 @@ struct Vertex {
 	}
 };
 
+/**
+ * Packed vertex layout (16 bytes instead of 32) uploaded when quantization is enabled:
+ * position as 16-bit unorm relative to the mesh bounding box (w is padding),
+ * texture coordinates as half floats and the normal octahedrally encoded in 2 x 16-bit snorm.
+ */
+struct PackedVertex {
+	uint16_t position[4];
+	uint16_t texCoord[2];
+	int16_t normal[2];
+};
+
 struct Face {
     unsigned int indices[3];
     int materialIndex;
@@ -71,6 +83,17 @@ struct MaterialGroup {
     std::vector<unsigned int> indices;
 };
 
+/**
+ * One simplified level of detail. Indices reference the same vertex buffer as the full mesh.
+ * groupIndices mirrors the material groups when they cover the whole mesh (empty otherwise);
+ * error is the simplification error relative to the bounding box's largest dimension.
+ */
+struct MeshLOD {
+    std::vector<unsigned int> indices;
+    std::vector<std::vector<unsigned int>> groupIndices;
+    float error = 0.0f;
+};
+
 struct FaceKey {
 	int posIndex;
 	int texIndex;
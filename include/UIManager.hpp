@@ -33,6 +33,18 @@
 # include <functional>
 # include "./Parser.hpp"
 # include "./InputManager.hpp"
+# include "./Mesh.hpp"
+# include "./Shader.hpp"
+# include "./GLState.hpp"
+# include "./RenderQueue.hpp"
+# include "./RenderScheduler.hpp"
+# include "./FramePacer.hpp"
+# include "./GpuTimer.hpp"
+# include "./RenderTargetPool.hpp"
+# include "./ResolutionScaler.hpp"
+# include "./PostProcessor.hpp"
+# include "./FrameCapture.hpp"
+# include "./TurntableRecorder.hpp"
 # include "./Colors.hpp"
 
 /**
@@ -46,16 +58,39 @@ struct UIState {
     bool autoRotation = false;
     bool enableCRT = false;
     bool useTexture = false;
+    bool renderOnDemand = true;
+    int vsyncMode = static_cast<int>(VSyncMode::ON);
+    int targetFPS = 0;              ///< 0 = unlimited
+    bool lowLatency = false;
+    bool dynamicResolution = true;
+    float renderScale = 1.0f;       ///< Used when dynamic resolution is off
+    float gpuBudgetMs = 16.0f;
+    int antiAliasing = static_cast<int>(AntiAliasing::OFF);
+    int maxSamples = 0;             ///< GL_MAX_SAMPLES, for labelling unsupported MSAA modes
+    int turntableFrames = 120;      ///< Frames per full turn of a turntable recording
     glm::vec3 cameraPosition{0.0f};
 
     int vertexCount = 0;
     int indexCount = 0;
     int triangleCount = 0;
     int materialCount = 0;
+    int activeLOD = 0;
+    std::vector<int> lodPrimitiveCounts;
+    bool lodLineList = false;       ///< LOD counts are line segments (FDF) rather than triangles
     std::string currentFile = "";
     
     float frameTime = 0.0f;
     float fps = 0.0f;
+    FramePacingStats pacingStats;
+    UniformStats uniformStats;
+    GLStateStats glStateStats;
+    RenderQueueStats queueStats;
+    RenderSchedulerStats schedulerStats;
+    GpuTimerStats gpuStats;
+    RenderTargetPoolStats postTargetStats;
+    ResolutionStats resolutionStats;
+    FrameCaptureStats captureStats;
+    TurntableStats turntableStats;
 };
 
 /**
@@ -92,6 +127,7 @@ class UIManager {
         GLFWwindow* _window;
         UIState _state;
         UILayout _layout;
+        bool _stateChanged = false;
         ImFont *_boldFont;
         ImFont *_regularFont;
         
@@ -109,6 +145,9 @@ class UIManager {
         void renderRenderingControls();
         void renderModelControls();
         void renderPerformanceStats();
+        void renderFramePacingControls();
+        void renderResolutionControls();
+        void renderCaptureControls();
         void renderMainViewport();
         void drawCustomFrameHeader(const char* title, ImVec2 framePos, float frameWidth, 
                                 float headerHeight, ImU32 headerColor, ImU32 textColor);
@@ -124,6 +163,7 @@ class UIManager {
 
         const UIState& getState() const { return _state; }
         const UILayout& getLayout() const { return _layout; }
+        bool consumeStateChanged();
 
         bool initialize();
         void shutdown();
@@ -132,7 +172,17 @@ class UIManager {
         void updateState(const UIState& newState);
         void updateMeshInfo(const Parser* parser);
         void updateCameraInfo(const InputManager* inputManager);
-        void updatePerformanceStats(float deltaTime);
+        void updateLODInfo(const Mesh* mesh, size_t activeLOD);
+        void updatePerformanceStats(const FramePacingStats& stats);
+        void updateUniformStats(const UniformStats& stats);
+        void updateGLStateStats(const GLStateStats& stats);
+        void updateQueueStats(const RenderQueueStats& stats);
+        void updateSchedulerStats(const RenderSchedulerStats& stats);
+        void updateGpuTimerStats(const GpuTimerStats& stats);
+        void updatePostTargetStats(const RenderTargetPoolStats& stats);
+        void updateResolutionStats(const ResolutionStats& stats);
+        void updateCaptureStats(const FrameCaptureStats& stats);
+        void updateTurntableStats(const TurntableStats& stats);
         void setCurrentFile(const std::string& filename);
 
         std::function<void(bool)> onWireframeModeChanged;
@@ -141,6 +191,17 @@ class UIManager {
         std::function<void(bool)> onAutoRotationChanged;
         std::function<void(bool)> onCRTModeChanged;
         std::function<void(bool)> onTextureModeChanged;
+        std::function<void(bool)> onRenderOnDemandChanged;
+        std::function<void(int)> onVSyncModeChanged;
+        std::function<void(int)> onTargetFPSChanged;
+        std::function<void(bool)> onLowLatencyChanged;
+        std::function<void(bool)> onDynamicResolutionChanged;
+        std::function<void(float)> onRenderScaleChanged;
+        std::function<void(float)> onGpuBudgetChanged;
+        std::function<void(int)> onAntiAliasingChanged;
+        std::function<void()> onScreenshot;
+        std::function<void(int)> onTurntableStart;
+        std::function<void()> onTurntableStop;
         std::function<void()> onResetCamera;
         std::function<void(const std::string&)> onLoadFile;
 };
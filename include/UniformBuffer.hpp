@@ -0,0 +1,95 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UniformBuffer.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/14 10:12:40 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/14 16:48:21 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/**
+ * @file UniformBuffer.hpp
+ * @brief Declaration of the UniformBuffer wrapper and the std140 blocks shared by all shaders.
+ *
+ * Per-frame data (camera and light) and per-object data (model and normal matrix) live in
+ * two uniform buffer objects attached to fixed binding points. Every program that declares
+ * the matching block gets it wired to the same binding point after linking, so the data is
+ * uploaded once per change instead of once per program and per uniform.
+ */
+
+#pragma once
+
+#ifndef UNIFORMBUFFER_HPP
+# define UNIFORMBUFFER_HPP
+
+# include <glad/glad.h>
+# include <vector>
+# include <cstddef>
+# include "glm/glm.hpp"
+
+/**
+ * @struct FrameUniforms
+ * @brief CPU mirror of the std140 "FrameData" block.
+ *
+ * Only mat4 and vec4 members are used so the C++ layout matches std140 without padding
+ * fields; the w components of the vec4s are unused.
+ */
+struct FrameUniforms {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec4 viewPos;
+    glm::vec4 lightPos;
+    glm::vec4 lightColor;
+};
+
+/**
+ * @struct ObjectUniforms
+ * @brief CPU mirror of the std140 "ObjectData" block.
+ *
+ * The normal matrix is the inverse transpose of the model's upper 3x3, computed once on
+ * the CPU and stored as a mat4 (a std140 mat3 would take the same three padded columns).
+ */
+struct ObjectUniforms {
+    glm::mat4 model;
+    glm::mat4 normalMatrix;
+};
+
+static_assert(sizeof(FrameUniforms) == 176, "FrameUniforms must match the std140 FrameData block");
+static_assert(sizeof(ObjectUniforms) == 128, "ObjectUniforms must match the std140 ObjectData block");
+
+/**
+ * @class UniformBuffer
+ * @brief Uniform buffer object attached to one binding point, with a shadow copy of its contents.
+ *
+ * update() compares against the shadow copy and only calls glBufferSubData when the
+ * contents changed, so a static camera costs no buffer traffic at all.
+ */
+class UniformBuffer {
+    private:
+        unsigned int _id;
+        unsigned int _binding;
+        std::vector<unsigned char> _shadow;
+        bool _initialized;
+
+    public:
+        static const unsigned int FRAME_BINDING = 0;
+        static const unsigned int OBJECT_BINDING = 1;
+
+        UniformBuffer(size_t size, unsigned int binding);
+        ~UniformBuffer();
+
+        UniformBuffer(const UniformBuffer &) = delete;
+        UniformBuffer &operator=(const UniformBuffer &) = delete;
+
+        bool update(const void *data, size_t size);
+
+        unsigned int getID() const;
+        unsigned int getBinding() const;
+
+        static void bindProgramBlocks(unsigned int program);
+};
+
+#endif
@@ -1,85 +1,148 @@
 #shader vertex
 #version 330 core
 
+// Variants (exactly one is defined by the renderer):
+//   LINE       - flat line color (wireframe / line render mode)
+//   POINT      - flat vertex color with program point size
+//   TEXTURED   - lit, base color sampled from u_texture
+//   UNTEXTURED - lit, base color from u_color
+#if defined(TEXTURED) || defined(UNTEXTURED)
+# define LIT
+#endif
+
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aTexCoord;
 layout (location = 2) in vec3 aNormal;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-uniform bool u_isVertexMode;
+// Shared std140 blocks, attached to binding points 0 and 1 by the application
+layout (std140) uniform FrameData {
+    mat4 u_view;
+    mat4 u_projection;
+    vec4 u_viewPos;
+    vec4 u_lightPos;
+    vec4 u_lightColor;
+};
+
+layout (std140) uniform ObjectData {
+    mat4 u_model;
+    mat4 u_normalMatrix;    // inverse transpose of the model's upper 3x3, computed on the CPU
+};
+
+// Quantized meshes: aPos is unorm16 relative to the bounding box, aNormal.xy is octahedral
+uniform bool u_quantized;
+uniform vec3 u_quantOffset;
+uniform vec3 u_quantScale;
 
+#ifdef LIT
 out vec3 FragPos;
 out vec3 Normal;
+#endif
+#ifdef TEXTURED
 out vec2 TexCoord;
+#endif
+
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
 
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    vec3 position = u_quantized ? u_quantOffset + aPos * u_quantScale : aPos;
+    vec4 worldPos = u_model * vec4(position, 1.0);
+
+#ifdef LIT
+    vec3 normal = u_quantized ? octDecode(aNormal.xy) : aNormal;
+    FragPos = vec3(worldPos);
+    Normal = mat3(u_normalMatrix) * normal;
+#endif
+#ifdef TEXTURED
     TexCoord = aTexCoord;
+#endif
     
-    gl_Position = projection * view * vec4(FragPos, 1.0);
+    gl_Position = u_projection * u_view * worldPos;
     
-    // Set point size for vertex visualization
-    if (u_isVertexMode) {
-        gl_PointSize = 8.0;
-    }
+#ifdef POINT
+    // Point size for vertex visualization
+    gl_PointSize = 8.0;
+#endif
 }
 
 #shader fragment
 #version 330 core
 
-in vec3 FragPos;
-in vec3 Normal;
-in vec2 TexCoord;
+#if defined(TEXTURED) || defined(UNTEXTURED)
+# define LIT
+#endif
+
+out vec4 FragColor;
+
+#if defined(LINE)
 
-uniform vec3 u_color;
-uniform vec3 u_lightPos;
-uniform vec3 u_lightColor;
-uniform vec3 u_viewPos;
 uniform vec3 u_lineColor;
+
+void main()
+{
+    FragColor = vec4(u_lineColor, 1.0);
+}
+
+#elif defined(POINT)
+
 uniform vec3 u_vertexColor;
-uniform bool u_isLineMode;
-uniform bool u_isVertexMode;
-uniform bool useTexture;
+
+void main()
+{
+    FragColor = vec4(u_vertexColor, 1.0);
+}
+
+#else
+
+in vec3 FragPos;
+in vec3 Normal;
+#ifdef TEXTURED
+in vec2 TexCoord;
 uniform sampler2D u_texture;
+#else
+uniform vec3 u_color;
+#endif
 
-out vec4 FragColor;
+// Must match the vertex stage declaration (one block, one binding point)
+layout (std140) uniform FrameData {
+    mat4 u_view;
+    mat4 u_projection;
+    vec4 u_viewPos;
+    vec4 u_lightPos;
+    vec4 u_lightColor;
+};
 
 void main()
 {
-    vec4 texColor = texture(u_texture, TexCoord);
-    
-    if (u_isVertexMode) {
-        FragColor = vec4(u_vertexColor, 1.0);
-        return;
-    }
-    
-    if (u_isLineMode) {
-        FragColor = vec4(u_lineColor, 1.0);
-        return;
-    }
-    
-    vec3 ambient = 0.5 * u_lightColor;
+#ifdef TEXTURED
+    vec3 baseColor = texture(u_texture, TexCoord).rgb;
+#else
+    vec3 baseColor = u_color;
+#endif
 
-    vec3 baseColor;
-    if (useTexture) {
-        baseColor = texColor.rgb;
-    }
+    vec3 lightColor = u_lightColor.rgb;
+    vec3 ambient = 0.5 * lightColor;
     
     vec3 norm = normalize(Normal);
-    vec3 lightDir = normalize(u_lightPos - FragPos);
+    vec3 lightDir = normalize(u_lightPos.xyz - FragPos);
     float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * u_lightColor;
+    vec3 diffuse = diff * lightColor;
     
-    vec3 viewDir = normalize(u_viewPos - FragPos);
+    vec3 viewDir = normalize(u_viewPos.xyz - FragPos);
     vec3 reflectDir = reflect(-lightDir, norm);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
     float specStrength = 0.2f;
-    vec3 specular = spec * u_lightColor * specStrength;
+    vec3 specular = spec * lightColor * specStrength;
     
-    vec3 result = (ambient + diffuse + specular) * (useTexture ? baseColor : u_color);
+    vec3 result = (ambient + diffuse + specular) * baseColor;
     FragColor = vec4(result, 1.0);
-}
\ No newline at end of file
+}
+
+#endif
@@ -18,75 +18,74 @@ void main()
 in vec2 TexCoord;
 
 uniform sampler2D u_screenTexture;
+uniform vec2 u_uvScale;
 uniform float u_time;
 uniform vec2 u_resolution;
-uniform bool u_enableCRT;
 
-out vec4 FragColor;
+// CRT effect parameters (set by the post-process chain)
+uniform float u_scanlineIntensity;
+uniform float u_vignetteStrength;
+uniform float u_curvature;
+uniform float u_aberrationStrength;
 
-// CRT Effect Parameters
-const float scanlineIntensity = 0.02;
-const float vignetteStrength = 0.3;
-const float curvature = 5;
-const float aberrationStrength = 0.003;
+out vec4 FragColor;
 
 vec2 curveRemapUV(vec2 uv) {
     uv = uv * 2.0 - 1.0;
-    vec2 offset = abs(uv.yx) / vec2(curvature, curvature);
+    vec2 offset = abs(uv.yx) / vec2(u_curvature, u_curvature);
     uv = uv + uv * offset * offset;
     uv = uv * 0.5 + 0.5;
     return uv;
 }
 
 vec3 scanlineEffect(vec3 color, vec2 uv) {
-    float scanline = sin(uv.y * u_resolution.y * 0.75) * scanlineIntensity;
+    float scanline = sin(uv.y * u_resolution.y * 0.75) * u_scanlineIntensity;
     return color - scanline;
 }
 
 vec3 vignetteEffect(vec3 color, vec2 uv) {
     float vignette = distance(uv, vec2(0.5));
     vignette = smoothstep(0.0, 0.7, vignette);
-    return color * (1.0 - vignette * vignetteStrength);
+    return color * (1.0 - vignette * u_vignetteStrength);
 }
 
-vec3 chromaticAberration(sampler2D tex, vec2 uv) {
+// The input texture may be larger than the image (render target capacity): map [0,1] onto
+// the used corner and clamp half a texel inside it so filtering never reads past the edge
+vec3 sampleScreen(vec2 uv) {
+    vec2 limit = u_uvScale - 0.5 / vec2(textureSize(u_screenTexture, 0));
+    return texture(u_screenTexture, clamp(uv * u_uvScale, vec2(0.0), limit)).rgb;
+}
+
+vec3 chromaticAberration(vec2 uv) {
     vec2 center = vec2(0.5);
     vec2 direction = normalize(uv - center);
-    vec2 offset = direction * aberrationStrength;
+    vec2 offset = direction * u_aberrationStrength;
     
-    float r = texture(tex, uv + offset).r;
-    float g = texture(tex, uv).g;
-    float b = texture(tex, uv - offset).b;
+    float r = sampleScreen(uv + offset).r;
+    float g = sampleScreen(uv).g;
+    float b = sampleScreen(uv - offset).b;
     
     return vec3(r, g, b);
 }
 
 void main()
 {
-    vec2 uv = TexCoord;
-    vec3 color;
+    vec2 uv = curveRemapUV(TexCoord);
     
-    if (u_enableCRT) {
-        uv = curveRemapUV(uv);
-        
-        if (uv.x < 0.0 || uv.x > 1.0 || uv.y < 0.0 || uv.y > 1.0) {
-            FragColor = vec4(0.0, 0.0, 0.0, 1.0);
-            return;
-        }
-        
-        color = chromaticAberration(u_screenTexture, uv);
-        
-        color = scanlineEffect(color, uv);
-        
-        color = vignetteEffect(color, uv);
-        
-        color += 0.05 * sin(u_time * 1.5) * 0.3;
-        
-        color.g *= 1.02;
-        
-    } else {
-        color = texture(u_screenTexture, uv).rgb;
+    if (uv.x < 0.0 || uv.x > 1.0 || uv.y < 0.0 || uv.y > 1.0) {
+        FragColor = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
     }
     
+    vec3 color = chromaticAberration(uv);
+    
+    color = scanlineEffect(color, uv);
+    
+    color = vignetteEffect(color, uv);
+    
+    color += 0.05 * sin(u_time * 1.5) * 0.3;
+    
+    color.g *= 1.02;
+    
     FragColor = vec4(color, 1.0);
 }
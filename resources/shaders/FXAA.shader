@@ -0,0 +1,69 @@
+#shader vertex
+#version 330 core
+
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTexCoord;
+
+out vec2 TexCoord;
+
+void main()
+{
+    TexCoord = aTexCoord;
+    gl_Position = vec4(aPos, 0.0, 1.0);
+}
+
+#shader fragment
+#version 330 core
+
+in vec2 TexCoord;
+
+uniform sampler2D u_screenTexture;
+uniform vec2 u_uvScale;
+
+// FXAA parameters (set by the post-process chain)
+uniform float u_spanMax;        // Longest blur along the edge, in texels
+uniform float u_reduceMul;      // Damps the edge direction on bright areas
+uniform float u_reduceMin;      // Floor of that damping, keeps dark edges stable
+
+out vec4 FragColor;
+
+const vec3 LUMA = vec3(0.299, 0.587, 0.114);
+
+// The input texture may be larger than the image (render target capacity): clamp half a
+// texel inside the used corner so filtering never reads past the edge
+vec3 sampleScreen(vec2 uv, vec2 texel) {
+    return texture(u_screenTexture, clamp(uv, vec2(0.0), u_uvScale - 0.5 * texel)).rgb;
+}
+
+// Single-pass FXAA: estimate the local edge direction from the luma of the four diagonal
+// neighbours, blur along it, and fall back to the narrower blur when the wider one pulls
+// in luma from outside the neighbourhood (i.e. it crossed the edge)
+void main()
+{
+    vec2 texel = 1.0 / vec2(textureSize(u_screenTexture, 0));
+    vec2 uv = TexCoord * u_uvScale;
+
+    vec3 rgbM = sampleScreen(uv, texel);
+    float lumaNW = dot(sampleScreen(uv + vec2(-1.0, -1.0) * texel, texel), LUMA);
+    float lumaNE = dot(sampleScreen(uv + vec2( 1.0, -1.0) * texel, texel), LUMA);
+    float lumaSW = dot(sampleScreen(uv + vec2(-1.0,  1.0) * texel, texel), LUMA);
+    float lumaSE = dot(sampleScreen(uv + vec2( 1.0,  1.0) * texel, texel), LUMA);
+    float lumaM = dot(rgbM, LUMA);
+
+    float lumaMin = min(lumaM, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+    float lumaMax = max(lumaM, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+
+    vec2 dir = vec2(-((lumaNW + lumaNE) - (lumaSW + lumaSE)),
+                      (lumaNW + lumaSW) - (lumaNE + lumaSE));
+    float dirReduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * 0.25 * u_reduceMul, u_reduceMin);
+    float rcpDirMin = 1.0 / (min(abs(dir.x), abs(dir.y)) + dirReduce);
+    dir = clamp(dir * rcpDirMin, vec2(-u_spanMax), vec2(u_spanMax)) * texel;
+
+    vec3 rgbA = 0.5 * (sampleScreen(uv + dir * (1.0 / 3.0 - 0.5), texel)
+                     + sampleScreen(uv + dir * (2.0 / 3.0 - 0.5), texel));
+    vec3 rgbB = rgbA * 0.5 + 0.25 * (sampleScreen(uv - dir * 0.5, texel)
+                                   + sampleScreen(uv + dir * 0.5, texel));
+    float lumaB = dot(rgbB, LUMA);
+
+    FragColor = vec4((lumaB < lumaMin || lumaB > lumaMax) ? rgbA : rgbB, 1.0);
+}
@@ -24,8 +24,8 @@
  * 6. Create and initialize all subsystem managers
  * 7. Set up UI callback system for user interaction
  */
-App::App(int mode, Mesh *mesh, Shader *shader, Renderer *renderer, Parser *parser)
-    : _mode(mode), _parser(parser), _mesh(mesh), _shader(shader), _renderer(renderer), 
+App::App(int mode, Mesh *mesh, Renderer *renderer, Parser *parser)
+    : _mode(mode), _parser(parser), _mesh(mesh), _renderer(renderer), 
       _window(nullptr), _wireframeMode(false), _showVertices(false) {
         
     if (!glfwInit()) {
@@ -36,8 +36,25 @@ App::App(int mode, Mesh *mesh, Shader *shader, Renderer *renderer, Parser *parse
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef SCOP_GL_DEBUG
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
+
+#ifdef GLFW_SCALE_TO_MONITOR
+    glfwWindowHint(GLFW_SCALE_TO_MONITOR, GLFW_TRUE);
+#endif
+
+    // Default size, shrunk to fit smaller monitors; everything after this follows the
+    // actual window and framebuffer sizes
+    int windowWidth = 1920, windowHeight = 1080;
+    if (GLFWmonitor *monitor = glfwGetPrimaryMonitor()) {
+        if (const GLFWvidmode *videoMode = glfwGetVideoMode(monitor)) {
+            windowWidth = std::min(windowWidth, videoMode->width);
+            windowHeight = std::min(windowHeight, videoMode->height);
+        }
+    }
 
-    _window = glfwCreateWindow(1920, 1080, "SCOP aka FDFGL aka the renderer of worlds", nullptr, nullptr);
+    _window = glfwCreateWindow(windowWidth, windowHeight, "SCOP aka FDFGL aka the renderer of worlds", nullptr, nullptr);
 
     if (!_window) {
         std::cerr << "Failed to create GLFW window\n";
@@ -53,16 +70,31 @@ App::App(int mode, Mesh *mesh, Shader *shader, Renderer *renderer, Parser *parse
         _window = nullptr;
         return;
     }
+    GLExtensions::load((GLADloadproc)glfwGetProcAddress);
+#ifdef SCOP_GL_DEBUG
+    ErrorManager::enableDebugOutput();
+#endif
+    StartupTimer::mark("Window and GL context");
 
-    glViewport(0, 0, 1920, 1080);
-    glEnable(GL_DEPTH_TEST);
+    int framebufferWidth = 0, framebufferHeight = 0;
+    glfwGetFramebufferSize(_window, &framebufferWidth, &framebufferHeight);
+    GLState::viewport(0, 0, framebufferWidth, framebufferHeight);
+    GLState::enable(GL_DEPTH_TEST);
 
     float optimalDistance = _parser->getOptimalCameraDistance();
     
     _inputManager = std::make_unique<InputManager>(_window, _mode, optimalDistance, _parser->getBoundingBox());
     _textureLoader = std::make_unique<TextureLoader>();
     _uiManager = std::make_unique<UIManager>(_window);
-    _postProcessor = std::make_unique<PostProcessor>(1920, 1080);
+    _scheduler = std::make_unique<RenderScheduler>();
+    _pacer = std::make_unique<FramePacer>(_window);
+    StartupTimer::mark("Input and scheduling");
+    _resolution = std::make_unique<ResolutionScaler>();
+    _postProcessor = std::make_unique<PostProcessor>(framebufferWidth, framebufferHeight);
+    StartupTimer::mark("Post-process");
+    _capture = std::make_unique<FrameCapture>();
+    _recorder = std::make_unique<TurntableRecorder>();
+    StartupTimer::mark("Capture");
 
     if (!_uiManager->initialize()) {
         std::cerr << "Failed to initialize UI\n";
@@ -70,10 +102,21 @@ App::App(int mode, Mesh *mesh, Shader *shader, Renderer *renderer, Parser *parse
 
     _inputManager->resetView();
 
+    UIState initialState = _uiManager->getState();
+    initialState.maxSamples = _postProcessor->getMaxSamples();
+    _uiManager->updateState(initialState);
+
     setupUICallbacks();
+    StartupTimer::mark("UI");
 }
 
 App::~App() {
+	// Pending screenshots and turntable frames are read back and written while the
+	// context still exists
+	_recorder.reset();
+	_capture.reset();
+	GpuTimer::shutdown();
+
 	if (_window) {
 		glfwDestroyWindow(_window);
 	}
@@ -86,8 +129,15 @@ App::~App() {
  * 
  * FLOW:
  * 1. INITIALIZATION PHASE: Load textures and prepare rendering resources
- * 2. MAIN LOOP: Process input → Update UI → Calculate viewport → Render scene → Present frame
- * 3. Each frame performs: Input → UI Update → Viewport Setup → 3D Rendering → Post-Processing → UI Overlay → Buffer Swap
+ * 2. MAIN LOOP: Wait for events → Check dirty state → Process input → Update UI → Calculate viewport → Select LOD → Render scene → Present frame
+ * 3. Dirty state: window events (InputManager), UI control changes (UIManager) and animations
+ *    (auto-rotation, animated CRT effect). When none is set the iteration renders nothing and
+ *    the last presented frame stays on screen while the scheduler blocks for the next event
+ * 4. Each rendered frame performs: Begin Frame (CPU and GPU timers) → Input → UI Update → Viewport Setup → 3D Rendering → Post-Processing → UI Overlay → Buffer Swap
+ *    (with no post effect active the scene is drawn directly into the backbuffer, scissored
+ *    to the render area, and the off-screen target and composite pass are skipped)
+ * 5. Frame pacing: the FramePacer waits for the next frame slot after presenting, or, in
+ *    low-latency mode, before events are polled so the frame uses the freshest input
  */
 void App::run() {
     if (!_window) return;
@@ -111,20 +161,57 @@ void App::run() {
     if (_currentTexture) {
         _currentTexture->Bind();
     }
+    StartupTimer::mark("Textures");
 
     _mesh->bind();
+    StartupTimer::mark("Mesh upload");
 
-    _shader->compile();
-    _shader->use();
-    _shader->setUniform("u_texture", 0);
+    _renderer->initialize();
+    _renderer->setMeshUniforms(*_mesh);
+    StartupTimer::mark("Shader compile");
+
+    const ProgramCacheStats &cacheStats = ProgramCache::getStats();
+    StartupTimer::report();
+    std::cout << "Program cache: " << cacheStats.hits << " hit(s), " << cacheStats.misses << " compiled, "
+              << cacheStats.rejected << " rejected (" << ProgramCache::getDirectory() << ")" << std::endl;
 
     while (!glfwWindowShouldClose(_window)) {
+        if (_pacer->isLowLatency() && _scheduler->isActive() && !_turntableActive) {
+            _pacer->waitForNextFrame();
+        }
+        _scheduler->waitForEvents();
+        _capture->update();
+        _recorder->update();
+        if (_inputManager->consumeEvents() || _uiManager->consumeStateChanged()) {
+            _scheduler->requestRedraw();
+        }
+        _scheduler->setAnimating(_inputManager->getAutorotationStatus() || _uiManager->getState().enableCRT
+                                 || _capture->hasPendingReadback() || _recorder->isActive());
+        if (!_scheduler->beginFrame()) {
+            continue;
+        }
+
+        _pacer->beginFrame();
+        GpuTimer::beginFrame();
+
         float currentFrame = glfwGetTime();
+        if (_scheduler->resumedFromIdle()) {
+            _inputManager->resetFrameClock(currentFrame);
+            _pacer->resetTiming();
+        }
         _inputManager->setDeltaTime(currentFrame);
         
         _uiManager->updateMeshInfo(_parser);
         _uiManager->updateCameraInfo(_inputManager.get());
-        _uiManager->updatePerformanceStats(_inputManager->getDeltaTime());
+        _uiManager->updatePerformanceStats(_pacer->getStats());
+        _uiManager->updateUniformStats(Shader::getFrameStats());
+        Shader::resetFrameStats();
+        _uiManager->updateGLStateStats(GLState::getFrameStats());
+        GLState::resetFrameStats();
+        _uiManager->updateSchedulerStats(_scheduler->getStats());
+        _uiManager->updateGpuTimerStats(GpuTimer::getStats());
+        _uiManager->updateCaptureStats(_capture->getStats());
+        _uiManager->updateTurntableStats(_recorder->getStats());
         
         _uiManager->newFrame();
         
@@ -142,6 +229,31 @@ void App::run() {
         
         viewportWidth = std::max(viewportWidth, 1);
         viewportHeight = std::max(viewportHeight, 1);
+
+        // The layout is in window coordinates; GL works in framebuffer pixels, which differ
+        // on HiDPI displays. The scene then renders at a fraction of the pixel area, except
+        // for the last frame before the scheduler idles, which stays on screen at full size
+        int framebufferWidth = 0, framebufferHeight = 0;
+        glfwGetFramebufferSize(_window, &framebufferWidth, &framebufferHeight);
+        float pixelScaleX = layout.windowWidth > 0.0f ? framebufferWidth / layout.windowWidth : 1.0f;
+        float pixelScaleY = layout.windowHeight > 0.0f ? framebufferHeight / layout.windowHeight : 1.0f;
+
+        int areaX = static_cast<int>(viewportX * pixelScaleX);
+        int areaY = static_cast<int>((layout.windowHeight - viewportY - viewportHeight) * pixelScaleY);
+        int areaWidth = std::max(static_cast<int>(viewportWidth * pixelScaleX), 1);
+        int areaHeight = std::max(static_cast<int>(viewportHeight * pixelScaleY), 1);
+
+        // Turntable frames are driven by the frame index and always render at full size
+        bool recording = _recorder->isRecording();
+        if (recording) {
+            glm::vec3 rotation = _inputManager->getModelRotation();
+            _inputManager->setModelRotation(rotation.x, _recorder->getAngle());
+        }
+
+        int sceneWidth = 0, sceneHeight = 0;
+        _resolution->update(GpuTimer::getStats().totalMs);
+        _resolution->apply(areaWidth, areaHeight, sceneWidth, sceneHeight, !_scheduler->isActive() || recording);
+        _uiManager->updateResolutionStats(_resolution->getStats());
         
         float aspectRatio = static_cast<float>(viewportWidth) / static_cast<float>(viewportHeight);
         
@@ -151,7 +263,11 @@ void App::run() {
         
         std::vector<glm::mat4> matrices = _inputManager->getMatrices();
         
-        _renderer->setMatrices(matrices[0], matrices[1], matrices[2]);
+        _renderer->setFrameData(matrices[1], matrices[2], _inputManager->getCameraPosition());
+        _renderer->setObjectData(matrices[0]);
+        
+        _activeLOD = _renderer->selectLOD(*_mesh, _inputManager->getProjectedSize(static_cast<float>(sceneHeight)));
+        _uiManager->updateLODInfo(_mesh, _activeLOD);
         
         // DEBUG
         static bool firstRun = true;
@@ -177,190 +293,110 @@ void App::run() {
         );
         _inputManager->setViewportBounds(viewportBounds);
         
-        if (viewportWidth > 0 && viewportHeight > 0) {
-            static int lastWidth = 0, lastHeight = 0;
-            if (lastWidth != viewportWidth || lastHeight != viewportHeight) {
-                _postProcessor->resize(viewportWidth, viewportHeight);
-                lastWidth = viewportWidth;
-                lastHeight = viewportHeight;
-            }
-        }
-        
-        _postProcessor->updateTime(currentFrame);
-        
-        _postProcessor->bind();
-
-        glDisable(GL_SCISSOR_TEST);
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(GL_LESS);
-        glDepthMask(GL_TRUE);
-
-        glDisable(GL_CULL_FACE);
-        
-        setClearColor(Colors::BLACK_CHARCOAL_1);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        
-        const auto& materialGroups = _parser->getMaterialGroups();
-        
-        if (!materialGroups.empty() && !_materialTextures.empty()) {
-            static bool debugMaterials = true;
-            if (debugMaterials) {
-                std::cout << "Rendering with materials: " << materialGroups.size() << " groups" << std::endl;
-                debugMaterials = false;
-            }
-            renderWithMaterials();
-        } else {
-            static bool debugFallback = true;
-            if (debugFallback) {
-                std::cout << "Rendering with fallback (no materials)" << std::endl;
-                debugFallback = false;
-            }
-            if (_currentTexture && _useTexture) {
-                _currentTexture->Bind(0);
-            }
-            _renderer->draw(*_mesh, _mode, _inputManager->getCameraPosition(), _showVertices, _wireframeMode, _useTexture);
-        }
-        
-        _postProcessor->unbind();
-        
-        glViewport(0, 0, 1920, 1080);
-        setClearColor(Colors::BLACK_CHARCOAL_1);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        _postProcessor->resize(sceneWidth, sceneHeight);
         
+        _postProcessor->updateTime(recording ? _recorder->getTime() : currentFrame);
         _postProcessor->setEnableCRT(_uiManager->getState().enableCRT);
-        
-        glViewport(viewportX, 1080 - viewportY - viewportHeight, viewportWidth, viewportHeight);
 
-        glDisable(GL_DEPTH_TEST);
-        glDisable(GL_CULL_FACE);
+        // With no post effect or MSAA active and the scene at full scale it goes straight to
+        // the backbuffer, scissored to the render area; otherwise it renders off-screen and
+        // the post pass composites it, resolving MSAA and upscaling when the scale is below 1
+        bool postProcess = _postProcessor->isActive() || sceneWidth != areaWidth || sceneHeight != areaHeight;
 
-        _postProcessor->render();
+        {
+            GL_DEBUG_GROUP("Scene pass");
+            GpuTimer::begin(GpuPass::SCENE);
+            GLState::disable(GL_SCISSOR_TEST);
+            setClearColor(Colors::BLACK_CHARCOAL_1);
 
-        glViewport(0, 0, 1920, 1080);
-        _uiManager->render();
+            if (postProcess) {
+                _postProcessor->bind();
+            } else {
+                GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
+                GLState::viewport(0, 0, framebufferWidth, framebufferHeight);
+            }
 
-        glfwSwapBuffers(_window);
-        glfwPollEvents();
-    }
-}
+            GLState::enable(GL_DEPTH_TEST);
+            GLState::depthFunc(GL_LESS);
+            GLState::depthMask(true);
 
-/**
- * Multi-Material Rendering - Renders 3D models with multiple materials/textures
- * 
- * FLOW:
- * 1. Iterate through each material group in the parsed model
- * 2. For each group: Bind appropriate texture → Configure shader → Render geometry
- * 3. Handle different rendering modes (wireframe, solid, lines)
- * 4. Optionally render vertex points for debugging
- * 
- * This method enables complex models (like those from OBJ files with MTL materials)
- * to display with proper texturing on different parts of the mesh.
- */
-void App::renderWithMaterials() {
-    const auto& materialGroups = _parser->getMaterialGroups();
+            GLState::disable(GL_CULL_FACE);
 
-    for (const auto& group : materialGroups) {
-        if (group.indices.empty()) continue;
-        
-        if (_useTexture) {
-            auto textureIt = _materialTextures.find(group.materialIndex);
-            if (textureIt != _materialTextures.end()) {
-                textureIt->second->Bind(0);
-            } else if (_currentTexture) {
-                _currentTexture->Bind(0);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            if (!postProcess) {
+                GLState::viewport(areaX, areaY, areaWidth, areaHeight);
+                GLState::scissor(areaX, areaY, areaWidth, areaHeight);
+                GLState::enable(GL_SCISSOR_TEST);
             }
-        }
-        
-        _shader->use();
-        
-        if (_wireframeMode) {
 
-            int lineColorLoc = glGetUniformLocation(_shader->getID(), "u_lineColor");
-            int isLineModeLoc = glGetUniformLocation(_shader->getID(), "u_isLineMode");
-            int isVertexModeLoc = glGetUniformLocation(_shader->getID(), "u_isVertexMode");
-            
-            setLineColor(lineColorLoc, Colors::OFF_WHITE);
-            glLineWidth(1.0f);
-            glUniform1i(isLineModeLoc, 1);
-            glUniform1i(isVertexModeLoc, 0);
-            
-            GLCall(glBindVertexArray(_mesh->getVAO()));
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _mesh->getWireframeIBO());
-            GLCall(glDrawElements(GL_LINES, static_cast<GLsizei>(_mesh->getWireframeIndexCount()), GL_UNSIGNED_INT, nullptr));
-            
-            break;
-        } else {
-            int renderMode = _mode == 0 ? GL_TRIANGLES : GL_LINES;
-            
-            if (renderMode == GL_LINES) {
-                int lineColorLoc = glGetUniformLocation(_shader->getID(), "u_lineColor");
-                int isLineModeLoc = glGetUniformLocation(_shader->getID(), "u_isLineMode");
-                int isVertexModeLoc = glGetUniformLocation(_shader->getID(), "u_isVertexMode");
-                
-                setLineColor(lineColorLoc, Colors::OFF_WHITE);
-                glLineWidth(1.0f);
-                glUniform1i(isLineModeLoc, 1);
-                glUniform1i(isVertexModeLoc, 0);
+            const auto& materialGroups = _parser->getMaterialGroups();
+            float depth = glm::length(_inputManager->getCameraPosition() - glm::vec3(matrices[0][3]));
+
+            if (!materialGroups.empty() && !_materialTextures.empty()) {
+                static bool debugMaterials = true;
+                if (debugMaterials) {
+                    std::cout << "Rendering with materials: " << materialGroups.size() << " groups" << std::endl;
+                    debugMaterials = false;
+                }
             } else {
-                int isLineModeLoc = glGetUniformLocation(_shader->getID(), "u_isLineMode");
-                int isVertexModeLoc = glGetUniformLocation(_shader->getID(), "u_isVertexMode");
-                glUniform1i(isLineModeLoc, 0);
-                glUniform1i(isVertexModeLoc, 0);
-                
-                int colorLoc = glGetUniformLocation(_shader->getID(), "u_color");
-                int lightPosLoc = glGetUniformLocation(_shader->getID(), "u_lightPos");
-                int lightColorLoc = glGetUniformLocation(_shader->getID(), "u_lightColor");
-                int viewPosLoc = glGetUniformLocation(_shader->getID(), "u_viewPos");
-                int textureLoc = glGetUniformLocation(_shader->getID(), "u_texture");
-                int useTextureLoc = glGetUniformLocation(_shader->getID(), "useTexture");
-                
-                glUniform3f(colorLoc, 0.5, 0.5, 0.9);
-                
-                glm::vec3 lightPos(5.0f, 5.0f, 5.0f);
-                glUniform3fv(lightPosLoc, 1, glm::value_ptr(lightPos));
-                
-                glm::vec3 lightColor(1.0f, 1.0f, 1.0f);
-                glUniform3fv(lightColorLoc, 1, glm::value_ptr(lightColor));
-                
-                glUniform3fv(viewPosLoc, 1, glm::value_ptr(_inputManager->getCameraPosition()));
-                
-                glUniform1i(textureLoc, 0);
-                glUniform1i(useTextureLoc, _useTexture ? 1 : 0);
+                static bool debugFallback = true;
+                if (debugFallback) {
+                    std::cout << "Rendering with fallback (no materials)" << std::endl;
+                    debugFallback = false;
+                }
             }
+            _renderer->submitModel(*_mesh, materialGroups, _materialTextures, _currentTexture.get(), _mode,
+                                   _showVertices, _wireframeMode, _useTexture, _activeLOD, depth);
+
+            _renderer->flush();
+            _uiManager->updateQueueStats(_renderer->getQueueStats());
 
-            static unsigned int tempIBO = 0;
-            if (tempIBO == 0) {
-                glGenBuffers(1, &tempIBO);
+            if (postProcess) {
+                _postProcessor->unbind();
+            } else {
+                GLState::disable(GL_SCISSOR_TEST);
             }
-            
-            GLCall(glBindVertexArray(_mesh->getVAO()));
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tempIBO);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, 
-                         group.indices.size() * sizeof(unsigned int), 
-                         group.indices.data(), 
-                         GL_STREAM_DRAW);
-            
-            GLCall(glDrawElements(renderMode, static_cast<GLsizei>(group.indices.size()), GL_UNSIGNED_INT, nullptr));
         }
-    }
-    
-    if (_showVertices) {
-        _shader->use();
-        int isVertexModeLoc = glGetUniformLocation(_shader->getID(), "u_isVertexMode");
-        int isLineModeLoc = glGetUniformLocation(_shader->getID(), "u_isLineMode");
-        glUniform1i(isVertexModeLoc, 1);
-        glUniform1i(isLineModeLoc, 0);
-        
-        int vertexColorLoc = glGetUniformLocation(_shader->getID(), "u_vertexColor");
-        glUniform3f(vertexColorLoc, 1.0f, 1.0f, 0.0f);
-        
-        glEnable(GL_PROGRAM_POINT_SIZE);
-        glPointSize(10.0f);
         
-        GLCall(glBindVertexArray(_mesh->getVAO()));
-        GLCall(glDrawArrays(GL_POINTS, 0, _mesh->getVertexCount()));
-        
-        glDisable(GL_PROGRAM_POINT_SIZE);
+        if (postProcess) {
+            GL_DEBUG_GROUP("Post-process pass");
+            GpuTimer::begin(GpuPass::POST_PROCESS);
+            GLState::viewport(0, 0, framebufferWidth, framebufferHeight);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            GLState::disable(GL_DEPTH_TEST);
+            GLState::disable(GL_CULL_FACE);
+
+            _postProcessor->render(areaX, areaY, areaWidth, areaHeight);
+        }
+        _postProcessor->endFrame();
+        _uiManager->updatePostTargetStats(_postProcessor->getTargetStats());
+
+        // The render area now holds the final image on both paths; read it before the UI
+        // draws over it
+        if (_capture->hasRequest()) {
+            _capture->captureRequested(0, areaX, areaY, areaWidth, areaHeight);
+        }
+        if (recording) {
+            _recorder->captureFrame(0, areaX, areaY, areaWidth, areaHeight);
+        }
+        if (_turntableActive && !_recorder->isRecording()) {
+            handleTurntableEnd();
+        }
+
+        GLState::viewport(0, 0, framebufferWidth, framebufferHeight);
+        {
+            GL_DEBUG_GROUP("UI pass");
+            GpuTimer::begin(GpuPass::UI);
+            _uiManager->render();
+            GpuTimer::end();
+        }
+
+        _pacer->present();
+        if (!_pacer->isLowLatency() && !_turntableActive) {
+            _pacer->waitForNextFrame();
+        }
     }
 }
 
@@ -405,6 +441,10 @@ void App::setupUICallbacks() {
     _inputManager->setTextureToggleCallback([this](bool useTexture) {
         this->handleTextureToggle(useTexture);
     });
+
+    _inputManager->setScreenshotCallback([this]() {
+        this->handleScreenshot();
+    });
     
     _uiManager->onWireframeModeChanged = [this](bool wireframeMode) {
         this->handleWireframeToggle(wireframeMode);
@@ -433,6 +473,50 @@ void App::setupUICallbacks() {
     _uiManager->onTextureModeChanged = [this](bool useTexture) {
         this->handleTextureToggle(useTexture);
     };
+
+    _uiManager->onRenderOnDemandChanged = [this](bool onDemand) {
+        _scheduler->setOnDemand(onDemand);
+    };
+
+    _uiManager->onVSyncModeChanged = [this](int mode) {
+        _pacer->setVSync(static_cast<VSyncMode>(mode));
+    };
+
+    _uiManager->onTargetFPSChanged = [this](int fps) {
+        _pacer->setTargetFPS(static_cast<float>(fps));
+    };
+
+    _uiManager->onLowLatencyChanged = [this](bool lowLatency) {
+        _pacer->setLowLatency(lowLatency);
+    };
+
+    _uiManager->onDynamicResolutionChanged = [this](bool dynamic) {
+        _resolution->setDynamic(dynamic);
+    };
+
+    _uiManager->onRenderScaleChanged = [this](float scale) {
+        _resolution->setManualScale(scale);
+    };
+
+    _uiManager->onGpuBudgetChanged = [this](float budgetMs) {
+        _resolution->setBudget(budgetMs);
+    };
+
+    _uiManager->onAntiAliasingChanged = [this](int mode) {
+        _postProcessor->setAntiAliasing(static_cast<AntiAliasing>(mode));
+    };
+
+    _uiManager->onScreenshot = [this]() {
+        this->handleScreenshot();
+    };
+
+    _uiManager->onTurntableStart = [this](int frames) {
+        this->handleTurntableStart(frames);
+    };
+
+    _uiManager->onTurntableStop = [this]() {
+        _recorder->stop();
+    };
     
     _uiManager->onResetCamera = [this]() {
         if (_inputManager) {
@@ -529,4 +613,43 @@ void App::handleTextureToggle(bool useTexture) {
     }
     
     std::cout << "Texture mode " << (_useTexture ? "ON" : "OFF") << std::endl;
-}
\ No newline at end of file
+}
+void App::handleScreenshot() {
+    _capture->requestScreenshot();
+    _scheduler->requestRedraw();
+    std::cout << "Screenshot requested" << std::endl;
+}
+
+/**
+ * Turntable Start - Begins recording a full turn of the model
+ *
+ * FLOW:
+ * 1. Auto-rotation is turned off (the recorder sets the angle each frame) and restored
+ *    when the recording ends
+ * 2. VSync is turned off and the frame limiter skipped, so frames are produced as fast
+ *    as the GPU and the encoders allow rather than in real time
+ * 3. The turn starts from the model's current rotation
+ */
+void App::handleTurntableStart(int frames) {
+    if (!_turntableActive) {
+        _turntableAutoRotation = _inputManager->getAutorotationStatus();
+        handleAutoRotationToggle(false);
+        _pacer->setVSync(VSyncMode::OFF);
+    }
+
+    _recorder->start(frames, _inputManager->getModelRotation().y);
+    _turntableActive = true;
+    _scheduler->requestRedraw();
+}
+
+/**
+ * Turntable End - Restores the settings the recording overrode once its last frame is captured
+ *
+ * Encoding may still be running; the recorder finishes it in the background.
+ */
+void App::handleTurntableEnd() {
+    _turntableActive = false;
+    _pacer->setVSync(static_cast<VSyncMode>(_uiManager->getState().vsyncMode));
+    handleAutoRotationToggle(_turntableAutoRotation);
+    _pacer->resetTiming();
+}
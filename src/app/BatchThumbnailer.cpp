@@ -0,0 +1,292 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BatchThumbnailer.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/27 09:31:52 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/27 17:13:20 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/BatchThumbnailer.hpp"
+#include "../../include/Mesh.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <streambuf>
+#include <utility>
+
+namespace {
+    const size_t QUEUED_MODELS_PER_PARSER = 2;
+    const size_t MAX_CACHED_TEXTURES = 64;
+
+    /**
+     * Swallows everything written to it. The parser and texture loader log every model they
+     * load; over thousands of models that is megabytes of console output serialized on one
+     * lock, so std::cout is pointed here for the length of a batch.
+     */
+    class NullBuffer : public std::streambuf {
+        protected:
+            int overflow(int c) override { return c; }
+    };
+
+    /** Points std::cout at a NullBuffer for its lifetime; the old buffer is restored on any exit. */
+    class SilencedCout {
+        private:
+            NullBuffer _null;
+            std::streambuf *_previous;
+
+        public:
+            SilencedCout() : _previous(std::cout.rdbuf(&_null)) {}
+            ~SilencedCout() { std::cout.rdbuf(_previous); }
+
+            SilencedCout(const SilencedCout &) = delete;
+            SilencedCout &operator=(const SilencedCout &) = delete;
+    };
+}
+
+BatchThumbnailer::BatchThumbnailer(HeadlessRenderer *headless, size_t parsers, size_t queueCapacity, bool quantize)
+    : _headless(headless), _software(nullptr), _parserCount(std::max<size_t>(parsers, 1)), _queueCapacity(queueCapacity), _quantize(quantize),
+      _optimize(false), _reduceOverdraw(false), _generateLODs(false),
+      _nextFile(0), _activeParsers(0), _parseFailures(0), _renderWait(0.0), _stopping(false) {
+    if (_queueCapacity == 0) {
+        _queueCapacity = _parserCount * QUEUED_MODELS_PER_PARSER;
+    }
+}
+
+BatchThumbnailer::BatchThumbnailer(SoftwareRenderer *software, size_t parsers, size_t queueCapacity)
+    : BatchThumbnailer(static_cast<HeadlessRenderer *>(nullptr), parsers, queueCapacity) {
+    _software = software;
+}
+
+/**
+ * BatchThumbnailer Destructor - Stops parsers left running by an exception in run()
+ *
+ * A parser blocked on a full queue wakes up and drops its model; the others stop at their
+ * next file.
+ */
+BatchThumbnailer::~BatchThumbnailer() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+        _queue.clear();
+    }
+    _consumed.notify_all();
+    for (std::thread &parser : _parsers) {
+        if (parser.joinable()) {
+            parser.join();
+        }
+    }
+}
+
+bool BatchThumbnailer::isModelFile(const std::filesystem::path &path) {
+    std::string extension = path.extension().string();
+    return extension == ".obj" || extension == ".fdf";
+}
+
+/**
+ * Collect - Lists the model files under input and where their thumbnails go
+ *
+ * Sorted so runs are reproducible and the output order follows the tree. Unreadable
+ * directories are skipped rather than ending the batch.
+ */
+void BatchThumbnailer::collect(const std::filesystem::path &input, const std::filesystem::path &output) {
+    std::error_code error;
+    std::filesystem::recursive_directory_iterator it(input, std::filesystem::directory_options::skip_permission_denied, error);
+    for (; !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+        if (!it->is_regular_file(error) || !isModelFile(it->path())) {
+            continue;
+        }
+        Job job;
+        job.file = it->path();
+        job.output = output / std::filesystem::relative(it->path(), input).replace_extension(".png");
+        _files.push_back(std::move(job));
+    }
+    if (error) {
+        std::cerr << "Warning: stopped listing " << input.string() << ": " << error.message() << std::endl;
+    }
+
+    std::sort(_files.begin(), _files.end(), [](const Job &a, const Job &b) { return a.file < b.file; });
+}
+
+/**
+ * Set Mesh Processing - The --optimize, --overdraw and --lod passes, run by the parser
+ * threads after each parse, in the order the viewer runs them. Call before run().
+ */
+void BatchThumbnailer::setMeshProcessing(bool optimize, bool reduceOverdraw, bool generateLODs) {
+    _optimize = optimize || reduceOverdraw;
+    _reduceOverdraw = reduceOverdraw;
+    _generateLODs = generateLODs;
+}
+
+/**
+ * Parser Loop - Parses files until none are left, handing each model to the GL thread
+ *
+ * FLOW:
+ * 1. Take the next file index under the lock
+ * 2. Parse outside the lock (the expensive part), then run the mesh passes asked for;
+ *    a file that fails is reported and counted
+ * 3. Wait for room in the queue, push the parsed model and wake the GL thread
+ * 4. Last parser out wakes the GL thread so it sees the end of the input
+ */
+void BatchThumbnailer::parserLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_stopping || _nextFile >= _files.size()) {
+                break;
+            }
+            job.file = _files[_nextFile].file;
+            job.output = _files[_nextFile].output;
+            _nextFile++;
+        }
+
+        std::string path = job.file.string();
+        try {
+            job.parser = std::make_unique<Parser>();
+            job.parser->setMode(path);
+            job.parser->parse(path);
+            if (_optimize) {
+                job.parser->optimize(_reduceOverdraw);
+            }
+            if (_generateLODs) {
+                job.parser->generateLODs();
+            }
+        } catch (const std::exception &e) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _parseFailures++;
+            std::cerr << "Failed to parse " << path << ": " << e.what() << std::endl;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _consumed.wait(lock, [this] { return _queue.size() < _queueCapacity || _stopping; });
+        if (_stopping) {
+            break;
+        }
+        _queue.push_back(std::move(job));
+        _parsed.notify_one();
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _activeParsers--;
+    _parsed.notify_all();
+}
+
+/**
+ * Pop - Blocks until a parsed model is available; false once every parser has finished
+ *
+ * The time spent waiting is accumulated: if it is a large part of the run the GPU is
+ * starved and more parser threads would help.
+ */
+bool BatchThumbnailer::pop(Job &job) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto waitStart = std::chrono::steady_clock::now();
+    _parsed.wait(lock, [this] { return !_queue.empty() || _activeParsers == 0; });
+    _renderWait += std::chrono::duration<double>(std::chrono::steady_clock::now() - waitStart).count();
+
+    if (_queue.empty()) {
+        return false;
+    }
+    job = std::move(_queue.front());
+    _queue.pop_front();
+    _consumed.notify_one();
+    return true;
+}
+
+/**
+ * Render - Draws one parsed model and writes (or queues) its thumbnail
+ *
+ * GL: the mesh is uploaded, drawn and freed right away, the pixels already being in the
+ * readback ring. Software: the rasterizer reads the parser's arrays directly.
+ */
+bool BatchThumbnailer::render(Job &job) {
+    try {
+        bool rendered;
+        if (_software) {
+            rendered = _software->renderImage(*job.parser, job.output.string());
+            _software->trimTextureCache(MAX_CACHED_TEXTURES);
+        } else {
+            Mesh mesh(job.parser.get(), _quantize);
+            rendered = _headless->renderImage(*job.parser, mesh, job.output.string());
+            _headless->trimTextureCache(MAX_CACHED_TEXTURES);
+        }
+        if (!rendered) {
+            std::cerr << "Failed to render " << job.file.string() << std::endl;
+        }
+        return rendered;
+    } catch (const std::exception &e) {
+        std::cerr << "Failed to render " << job.file.string() << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
+/**
+ * Run - Renders a thumbnail for every model under inputDirectory
+ *
+ * FLOW:
+ * 1. List the models and silence std::cout for the duration (see SilencedCout)
+ * 2. Start the parser threads
+ * 3. On this (GL) thread: render each parsed model as it arrives, then free its parser
+ * 4. Wait for the parsers and the last PNG writes; leaving the scope restores std::cout
+ * 5. Written and failed writes come from the renderer's counters over this run
+ */
+BatchStats BatchThumbnailer::run(const std::string &inputDirectory, const std::string &outputDirectory) {
+    BatchStats stats;
+    auto start = std::chrono::steady_clock::now();
+    auto writeCounts = [this]() {
+        if (_software) {
+            return std::make_pair(_software->getStats().written, _software->getStats().failed);
+        }
+        FrameCaptureStats capture = _headless->getCaptureStats();
+        return std::make_pair(capture.written, capture.failed);
+    };
+    std::pair<size_t, size_t> before = writeCounts();
+
+    _files.clear();
+    collect(inputDirectory, outputDirectory);
+    stats.found = _files.size();
+    if (_files.empty()) {
+        return stats;
+    }
+
+    size_t renderFailures = 0;
+    {
+        SilencedCout silenced;
+
+        _nextFile = 0;
+        _parseFailures = 0;
+        _renderWait = 0.0;
+        _activeParsers = std::min(_parserCount, _files.size());
+        for (size_t i = 0; i < _activeParsers; ++i) {
+            _parsers.emplace_back(&BatchThumbnailer::parserLoop, this);
+        }
+
+        Job job;
+        while (pop(job)) {
+            if (!render(job)) {
+                renderFailures++;
+            }
+            job.parser.reset();
+        }
+
+        for (std::thread &parser : _parsers) {
+            parser.join();
+        }
+        _parsers.clear();
+        if (_headless) {
+            _headless->flush();
+        }
+    }
+
+    std::pair<size_t, size_t> after = writeCounts();
+    stats.written = after.first - before.first;
+    stats.failed = _parseFailures + renderFailures + (after.second - before.second);
+    stats.seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+    stats.assetsPerSecond = stats.seconds > 0.0f ? static_cast<float>(stats.written) / stats.seconds : 0.0f;
+    stats.renderWaitSeconds = static_cast<float>(_renderWait);
+    return stats;
+}
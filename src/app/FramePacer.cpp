@@ -0,0 +1,205 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FramePacer.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/20 09:06:02 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/20 17:22:40 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/FramePacer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+namespace {
+    // Bounds for the part of the wait left to spinning instead of the OS sleep
+    const double MIN_SPIN = 0.0002;
+    const double MAX_SPIN = 0.004;
+    const float CPU_TIME_SMOOTHING = 0.1f;
+}
+
+/**
+ * FramePacer Constructor - Detects adaptive vsync and applies the default swap interval
+ *
+ * Must run with the window's context current: swap interval and the swap_control_tear
+ * extension query both apply to the current context.
+ */
+FramePacer::FramePacer(GLFWwindow *window)
+    : _window(window), _vsync(VSyncMode::ON), _adaptiveSupported(false), _lowLatency(false),
+      _targetFrameTime(0.0), _deadline(Clock::now()), _frameStarted(false), _hasLastPresent(false), _sleepOvershoot(0.001),
+      _intervals{}, _intervalCount(0), _intervalNext(0) {
+    _adaptiveSupported = glfwExtensionSupported("WGL_EXT_swap_control_tear")
+                      || glfwExtensionSupported("GLX_EXT_swap_control_tear");
+    _stats.adaptiveSupported = _adaptiveSupported;
+    setVSync(VSyncMode::ON);
+}
+
+/**
+ * Set VSync - Applies the swap interval for a vsync mode
+ *
+ * FLOW:
+ * 1. OFF → 0, ON → 1, ADAPTIVE → -1 (late frames tear instead of waiting a full refresh)
+ * 2. Adaptive without swap_control_tear falls back to plain vsync; the requested mode is
+ *    still reported so the UI shows what was asked and adaptiveSupported explains the rest
+ * 3. A new interval changes frame timing, so the history is restarted
+ */
+void FramePacer::setVSync(VSyncMode mode) {
+    int interval = 0;
+    if (mode == VSyncMode::ON) {
+        interval = 1;
+    } else if (mode == VSyncMode::ADAPTIVE) {
+        interval = _adaptiveSupported ? -1 : 1;
+        if (!_adaptiveSupported) {
+            std::cerr << "Warning: adaptive vsync unsupported (no swap_control_tear), using vsync" << std::endl;
+        }
+    }
+
+    glfwSwapInterval(interval);
+    _vsync = mode;
+    _stats.vsync = mode;
+    resetTiming();
+}
+
+void FramePacer::setTargetFPS(float fps) {
+    _targetFrameTime = fps > 0.0f ? 1.0 / fps : 0.0;
+    _stats.targetFrameTime = static_cast<float>(_targetFrameTime);
+    resetTiming();
+}
+
+void FramePacer::setLowLatency(bool lowLatency) {
+    _lowLatency = lowLatency;
+    _stats.lowLatency = lowLatency;
+    resetTiming();
+}
+
+/**
+ * Reset Timing - Restarts the limiter schedule and the interval history
+ *
+ * Used after settings change and after the render scheduler resumes from idle, where
+ * the gap since the last present says nothing about pacing.
+ */
+void FramePacer::resetTiming() {
+    _deadline = Clock::now();
+    _hasLastPresent = false;
+    _intervalCount = 0;
+    _intervalNext = 0;
+}
+
+/**
+ * Wait For Next Frame - Holds the loop until the next frame slot of the target rate
+ *
+ * FLOW:
+ * 1. Unlimited: return immediately (vsync, if on, paces in the swap)
+ * 2. More than a whole period late: restart the schedule from now instead of rushing
+ *    several frames out back to back to catch up
+ * 3. Sleep until the deadline minus the expected sleep overshoot, measuring how late
+ *    the OS actually woke us (decaying maximum, so one bad wakeup is forgotten slowly)
+ * 4. Spin (yielding) for the remainder, which is accurate to a few microseconds
+ * 5. Advance the deadline by one period, keeping the schedule drift-free
+ */
+void FramePacer::waitForNextFrame() {
+    if (_targetFrameTime <= 0.0) {
+        return;
+    }
+
+    const Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(_targetFrameTime));
+    Clock::time_point now = Clock::now();
+
+    if (now > _deadline + period) {
+        _deadline = now;
+    }
+
+    if (now < _deadline) {
+        double spin = std::min(std::max(_sleepOvershoot * 1.25, MIN_SPIN), MAX_SPIN);
+        Clock::time_point wake = _deadline - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(spin));
+        if (wake > now) {
+            std::this_thread::sleep_until(wake);
+            double overshoot = std::chrono::duration<double>(Clock::now() - wake).count();
+            _sleepOvershoot = std::max(overshoot, _sleepOvershoot * 0.99);
+        }
+        while (Clock::now() < _deadline) {
+            std::this_thread::yield();
+        }
+    }
+
+    _deadline += period;
+}
+
+/**
+ * Begin Frame - Marks the start of a rendered frame's CPU work
+ *
+ * Called once per rendered frame, after any pacing wait and the event wait, so cpuTime
+ * covers only input, UI and render submission. present() closes the measurement; a
+ * present with no matching beginFrame leaves cpuTime unchanged.
+ */
+void FramePacer::beginFrame() {
+    _frameStart = Clock::now();
+    _frameStarted = true;
+}
+
+/**
+ * Present - Swaps buffers and records the interval since the previous present
+ *
+ * The CPU time of the frame is taken before the swap, which may block on vsync.
+ * In low-latency mode glFinish blocks until the GPU is done with the frame, so the CPU
+ * cannot run ahead and the next frame samples input against what is actually on screen.
+ */
+void FramePacer::present() {
+    if (_frameStarted) {
+        float cpuTime = std::chrono::duration<float>(Clock::now() - _frameStart).count();
+        _stats.cpuTime = _stats.cpuTime > 0.0f ? _stats.cpuTime + CPU_TIME_SMOOTHING * (cpuTime - _stats.cpuTime) : cpuTime;
+        _frameStarted = false;
+    }
+
+    glfwSwapBuffers(_window);
+    if (_lowLatency) {
+        glFinish();
+    }
+
+    Clock::time_point now = Clock::now();
+    if (_hasLastPresent) {
+        recordInterval(std::chrono::duration<float>(now - _lastPresent).count());
+    }
+    _lastPresent = now;
+    _hasLastPresent = true;
+}
+
+/**
+ * Record Interval - Adds a frame interval to the ring and refreshes the statistics
+ *
+ * FLOW:
+ * 1. Store the interval in the ring buffer (oldest overwritten after HISTORY frames)
+ * 2. Mean and standard deviation over the ring → frame time, FPS, jitter
+ * 3. Max deviation against the limiter period when one is set (how well the target is
+ *    held), otherwise against the mean (how even the frames are)
+ */
+void FramePacer::recordInterval(float interval) {
+    _intervals[_intervalNext] = interval;
+    _intervalNext = (_intervalNext + 1) % HISTORY;
+    _intervalCount = std::min(_intervalCount + 1, HISTORY);
+
+    double sum = 0.0;
+    for (size_t i = 0; i < _intervalCount; ++i) {
+        sum += _intervals[i];
+    }
+    double mean = sum / static_cast<double>(_intervalCount);
+    double reference = _targetFrameTime > 0.0 ? _targetFrameTime : mean;
+
+    double variance = 0.0;
+    double maxDeviation = 0.0;
+    for (size_t i = 0; i < _intervalCount; ++i) {
+        double delta = _intervals[i] - mean;
+        variance += delta * delta;
+        maxDeviation = std::max(maxDeviation, std::fabs(_intervals[i] - reference));
+    }
+
+    _stats.frameTime = static_cast<float>(mean);
+    _stats.fps = mean > 0.0 ? static_cast<float>(1.0 / mean) : 0.0f;
+    _stats.jitter = static_cast<float>(std::sqrt(variance / static_cast<double>(_intervalCount)));
+    _stats.maxDeviation = static_cast<float>(maxDeviation);
+}
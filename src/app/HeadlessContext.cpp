@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HeadlessContext.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/26 09:06:20 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/26 12:31:40 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/HeadlessContext.hpp"
+#include "../../include/GLExtensions.hpp"
+#include <glad/glad.h>
+#include <iostream>
+
+#ifdef __linux__
+# include <EGL/egl.h>
+# include <EGL/eglext.h>
+
+namespace {
+    /**
+     * Open Display - Picks an EGL display that needs no window system
+     *
+     * Mesa's surfaceless platform first (no X11/Wayland connection, no DRM device needed);
+     * otherwise the default display, which on NVIDIA and other vendor drivers is headless
+     * capable by itself.
+     */
+    EGLDisplay openDisplay() {
+        const char *extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+        if (extensions && getPlatformDisplay && std::string(extensions).find("EGL_MESA_platform_surfaceless") != std::string::npos) {
+            EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr)) {
+                return display;
+            }
+        }
+
+        EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr)) {
+            return display;
+        }
+        return EGL_NO_DISPLAY;
+    }
+}
+
+/**
+ * HeadlessContext Constructor - Creates and makes current a windowless GL 3.3 core context
+ *
+ * FLOW:
+ * 1. Open a display that needs no window system
+ * 2. Bind the desktop OpenGL API and create a 3.3 core context with no config
+ *    (EGL_KHR_no_config_context) and no surface (EGL_KHR_surfaceless_context);
+ *    there is no default framebuffer, all rendering targets FBOs
+ * 3. Load GL entry points through eglGetProcAddress, as App does through GLFW
+ *
+ * On failure the error is reported and isValid() stays false.
+ */
+HeadlessContext::HeadlessContext() : _display(nullptr), _context(nullptr) {
+    EGLDisplay display = openDisplay();
+    if (display == EGL_NO_DISPLAY) {
+        std::cerr << "Failed to open an EGL display for headless rendering" << std::endl;
+        return;
+    }
+    _display = display;
+
+    const char *extensions = eglQueryString(display, EGL_EXTENSIONS);
+    std::string available = extensions ? extensions : "";
+    if (available.find("EGL_KHR_surfaceless_context") == std::string::npos
+        || available.find("EGL_KHR_no_config_context") == std::string::npos) {
+        std::cerr << "EGL display lacks surfaceless/no-config context support" << std::endl;
+        return;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cerr << "EGL cannot bind the desktop OpenGL API" << std::endl;
+        return;
+    }
+
+    const EGLint attributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+#ifdef SCOP_GL_DEBUG
+        EGL_CONTEXT_OPENGL_DEBUG, EGL_TRUE,
+#endif
+        EGL_NONE
+    };
+    EGLContext context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attributes);
+    if (context == EGL_NO_CONTEXT) {
+        std::cerr << "Failed to create a headless OpenGL 3.3 context (EGL error 0x" << std::hex << eglGetError() << std::dec << ")" << std::endl;
+        return;
+    }
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        std::cerr << "Failed to make the headless context current" << std::endl;
+        eglDestroyContext(display, context);
+        return;
+    }
+
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress))) {
+        std::cerr << "Failed to initialize GLAD\n";
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display, context);
+        return;
+    }
+    GLExtensions::load(reinterpret_cast<GLADloadproc>(eglGetProcAddress));
+
+    _context = context;
+    const GLubyte *renderer = glGetString(GL_RENDERER);
+    _renderer = renderer ? reinterpret_cast<const char *>(renderer) : "unknown";
+}
+
+HeadlessContext::~HeadlessContext() {
+    if (_context) {
+        eglMakeCurrent(static_cast<EGLDisplay>(_display), EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(static_cast<EGLDisplay>(_display), static_cast<EGLContext>(_context));
+    }
+    if (_display) {
+        eglTerminate(static_cast<EGLDisplay>(_display));
+    }
+}
+
+#else
+
+HeadlessContext::HeadlessContext() : _display(nullptr), _context(nullptr) {
+    std::cerr << "Headless rendering needs EGL, which is only supported on Linux" << std::endl;
+}
+
+HeadlessContext::~HeadlessContext() {}
+
+#endif
@@ -0,0 +1,231 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HeadlessRenderer.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/26 10:12:41 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/26 16:55:02 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/HeadlessRenderer.hpp"
+#include "../../include/TurntableRecorder.hpp"
+#include "../../include/GLState.hpp"
+#include "../../include/GpuTimer.hpp"
+#include "../../include/ErrorManager.hpp"
+#include "../../include/Colors.hpp"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <chrono>
+
+namespace {
+    const size_t QUEUED_IMAGES_PER_ENCODER = 2;
+}
+
+/**
+ * HeadlessRenderer Constructor - Sets up the off-screen frame for the requested image size
+ *
+ * FLOW:
+ * 1. Compile the renderer's programs (the windowed viewer does this at the start of run())
+ * 2. Post-processor sized to the image, with the requested anti-aliasing and CRT effect
+ * 3. Output target with a depth buffer: the "backbuffer" the frame is composited into and
+ *    read back from
+ * 4. Capture ring with its encoder threads
+ */
+HeadlessRenderer::HeadlessRenderer(Renderer *renderer, const HeadlessOptions &options, size_t encoders)
+    : _renderer(renderer), _options(options), _output(nullptr), _encoders(std::max<size_t>(encoders, 1)) {
+    _renderer->initialize();
+
+    _textureLoader = std::make_unique<TextureLoader>();
+    _postProcessor = std::make_unique<PostProcessor>(_options.width, _options.height);
+    _postProcessor->resize(_options.width, _options.height);
+    _postProcessor->setAntiAliasing(_options.antiAliasing);
+    _postProcessor->setEnableCRT(_options.crt);
+
+    _targets = std::make_unique<RenderTargetPool>();
+    RenderTargetDesc desc;
+    desc.width = _options.width;
+    desc.height = _options.height;
+    desc.depth = true;
+    _output = _targets->acquire(desc);
+    if (!_output) {
+        std::cerr << "Failed to create the " << _options.width << "x" << _options.height << " headless output target" << std::endl;
+    }
+
+    _capture = std::make_unique<FrameCapture>("captures", _encoders);
+}
+
+HeadlessRenderer::~HeadlessRenderer() {
+    flush();
+    if (_output) {
+        _targets->release(_output);
+    }
+    GpuTimer::shutdown();
+}
+
+void HeadlessRenderer::flush() {
+    _capture->flush();
+}
+
+/**
+ * Trim Texture Cache - Drops the cached textures once there are more than maxTextures
+ *
+ * The loader keeps every texture it has loaded, which suits one model but not thousands of
+ * them in a row. Textures still referenced by a scene stay alive through their shared_ptr.
+ */
+void HeadlessRenderer::trimTextureCache(size_t maxTextures) {
+    if (_textureLoader->getCacheSize() > maxTextures) {
+        _textureLoader->clearCache();
+    }
+}
+
+/**
+ * Prepare - Uploads a model and sets up its textures and camera
+ *
+ * FLOW:
+ * 1. Upload the mesh and its per-mesh uniforms
+ * 2. Material textures, falling back to the default texture, as the viewer does
+ * 3. Camera: an InputManager without a window (no input callbacks) so the framing, FDF
+ *    projection and LOD metric are exactly the viewer's default view
+ */
+bool HeadlessRenderer::prepare(Scene &scene, Parser &parser, Mesh &mesh) {
+    if (!_output) {
+        return false;
+    }
+
+    scene.parser = &parser;
+    scene.mesh = &mesh;
+    mesh.bind();
+    _renderer->setMeshUniforms(mesh);
+
+    const auto &materials = parser.getMaterials();
+    if (!materials.empty()) {
+        scene.materialTextures = _textureLoader->loadAllMaterialTextures(materials);
+        if (!scene.materialTextures.empty()) {
+            scene.texture = scene.materialTextures.begin()->second;
+        }
+    }
+    if (!scene.texture) {
+        scene.texture = _textureLoader->loadTexture("resources/textures/Unicorn.png");
+    }
+
+    scene.camera = std::make_unique<InputManager>(nullptr, parser.getMode(), parser.getOptimalCameraDistance(), parser.getBoundingBox());
+    scene.camera->resetView();
+    scene.camera->setAspectRatio(static_cast<float>(_options.width) / static_cast<float>(_options.height));
+    if (_options.orthographic) {
+        scene.camera->setUseOrthographic(true);
+        scene.camera->setModelRotation(35.265f, 45.0f);
+    }
+    return true;
+}
+
+/**
+ * Render Frame - One viewer frame into the output target
+ *
+ * FLOW:
+ * 1. Camera matrices and LOD for the image height
+ * 2. No post effect: scene straight into the output target; otherwise into the
+ *    post-processor's target, then composited (MSAA resolve, FXAA, CRT) into the output
+ * 3. GPU timer ring advanced per frame as in the windowed loop, so its queries are recycled
+ */
+void HeadlessRenderer::renderFrame(Scene &scene, float time) {
+    GpuTimer::beginFrame();
+
+    InputManager &camera = *scene.camera;
+    camera.createMatrices();
+    std::vector<glm::mat4> matrices = camera.getMatrices();
+    _renderer->setFrameData(matrices[1], matrices[2], camera.getCameraPosition());
+    _renderer->setObjectData(matrices[0]);
+
+    size_t lod = _renderer->selectLOD(*scene.mesh, camera.getProjectedSize(static_cast<float>(_options.height)));
+    float depth = glm::length(camera.getCameraPosition() - glm::vec3(matrices[0][3]));
+
+    _postProcessor->updateTime(time);
+    bool postProcess = _postProcessor->isActive();
+
+    {
+        GL_DEBUG_GROUP("Scene pass");
+        GpuTimer::begin(GpuPass::SCENE);
+        GLState::disable(GL_SCISSOR_TEST);
+        setClearColor(Colors::BLACK_CHARCOAL_1);
+
+        if (postProcess) {
+            _postProcessor->bind();
+        } else {
+            GLState::bindFramebuffer(GL_FRAMEBUFFER, _output->framebuffer);
+            GLState::viewport(0, 0, _options.width, _options.height);
+        }
+
+        GLState::enable(GL_DEPTH_TEST);
+        GLState::depthFunc(GL_LESS);
+        GLState::depthMask(true);
+        GLState::disable(GL_CULL_FACE);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        _renderer->submitModel(*scene.mesh, scene.parser->getMaterialGroups(), scene.materialTextures, scene.texture.get(),
+                               scene.parser->getMode(), false, _options.wireframe, _options.useTexture, lod, depth);
+        _renderer->flush();
+    }
+
+    if (postProcess) {
+        GL_DEBUG_GROUP("Post-process pass");
+        GpuTimer::begin(GpuPass::POST_PROCESS);
+        GLState::bindFramebuffer(GL_FRAMEBUFFER, _output->framebuffer);
+        GLState::viewport(0, 0, _options.width, _options.height);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        GLState::disable(GL_DEPTH_TEST);
+        _postProcessor->render(0, 0, _options.width, _options.height, _output->framebuffer);
+    }
+    _postProcessor->endFrame();
+    GpuTimer::end();
+}
+
+/**
+ * Render Image - Renders the model's default view and queues it for writing to path
+ *
+ * Returns once the readback is queued; the file is written in the background.
+ */
+bool HeadlessRenderer::renderImage(Parser &parser, Mesh &mesh, const std::string &path) {
+    Scene scene;
+    if (!prepare(scene, parser, mesh)) {
+        return false;
+    }
+
+    renderFrame(scene, 0.0f);
+    _capture->waitForSlot(_encoders * QUEUED_IMAGES_PER_ENCODER);
+    bool queued = _capture->capture(_output->framebuffer, 0, 0, _options.width, _options.height, path);
+    _capture->update();
+    return queued;
+}
+
+/**
+ * Render Turntable - Writes a full turn of the model as numbered frames into directory
+ *
+ * Same recorder as the viewer's, so the frames match a windowed recording of the same size.
+ * Blocks until every frame is written.
+ */
+bool HeadlessRenderer::renderTurntable(Parser &parser, Mesh &mesh, const std::string &directory, int frames) {
+    Scene scene;
+    if (!prepare(scene, parser, mesh)) {
+        return false;
+    }
+
+    TurntableRecorder recorder(_encoders);
+    glm::vec3 rotation = scene.camera->getModelRotation();
+    recorder.start(frames, rotation.y, directory);
+
+    while (recorder.isActive()) {
+        recorder.update();
+        if (!recorder.isRecording()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        scene.camera->setModelRotation(rotation.x, recorder.getAngle());
+        renderFrame(scene, recorder.getTime());
+        recorder.captureFrame(_output->framebuffer, 0, 0, _options.width, _options.height);
+    }
+    return recorder.getStats().written == static_cast<size_t>(frames);
+}
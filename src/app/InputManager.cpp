@@ -17,7 +17,8 @@
  * 
  * FLOW:
  * 1. Initialize member variables with default values
- * 2. Set up GLFW callback system using wrapper functions
+ * 2. Set up GLFW callback system using wrapper functions (ImGui, initialized later,
+ *    chains to them, so they see every event including the ones over the UI)
  * 3. Configure cursor mode for normal interaction
  * 4. Calculate optimal camera position based on model bounding box
  * 
@@ -32,14 +33,21 @@ InputManager::InputManager(GLFWwindow *window, int mode, float optimalDistance,
     _showVertices(false), _autoRotation(false), _autoRotationSpeed(30.0f),
     _defaultDistance(optimalDistance) {
     
-    glfwSetWindowUserPointer(window, this);
-    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
-    glfwSetMouseButtonCallback(window, mouseButtonCallbackWrapper);
-    glfwSetCursorPosCallback(window, mouseCallbackWrapper);
-    glfwSetScrollCallback(window, scrollCallbackWrapper);
-    glfwSetKeyCallback(window, keyCallbackWrapper);
-    
-    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+    // No window (headless rendering): only the camera and model transform are used
+    if (window) {
+        glfwSetWindowUserPointer(window, this);
+        glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+        glfwSetMouseButtonCallback(window, mouseButtonCallbackWrapper);
+        glfwSetCursorPosCallback(window, mouseCallbackWrapper);
+        glfwSetScrollCallback(window, scrollCallbackWrapper);
+        glfwSetKeyCallback(window, keyCallbackWrapper);
+        glfwSetCharCallback(window, charCallbackWrapper);
+        glfwSetCursorEnterCallback(window, cursorEnterCallbackWrapper);
+        glfwSetWindowFocusCallback(window, windowFocusCallbackWrapper);
+        glfwSetWindowRefreshCallback(window, windowRefreshCallbackWrapper);
+        
+        glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+    }
     
     calculateOptimalCameraPosition();
 }
@@ -66,6 +74,30 @@ std::vector<glm::mat4> InputManager::getMatrices() const {
 	return (matrices);
 }
 
+/**
+ * Get Projected Size - Estimates the on-screen size of the model in pixels
+ * 
+ * FLOW:
+ * 1. Move the bounding box center to view space with the current model and view matrices
+ * 2. Use the depth of the nearest point of the bounding sphere (clamped in front of the camera)
+ * 3. Pixels per world unit:
+ *    - Perspective: projection[1][1] * viewportHeight / 2 / depth
+ *    - Orthographic: projection[1][1] * viewportHeight / 2
+ * 4. Return the largest bounding box dimension in pixels
+ */
+float InputManager::getProjectedSize(float viewportHeight) const {
+	glm::vec3 center = glm::vec3(_view * _model * glm::vec4(_boundingBox.getCenter(), 1.0f));
+	float radius = _boundingBox.getDiagonal() * 0.5f;
+	float pixelsPerUnit = _projection[1][1] * viewportHeight * 0.5f;
+
+	if (_projection[3][3] == 0.0f) {
+		float depth = std::max(-center.z - radius, 1e-3f);
+		pixelsPerUnit /= depth;
+	}
+
+	return _boundingBox.getMaxDimension() * pixelsPerUnit;
+}
+
 bool InputManager::getAutorotationStatus() const {
     return _autoRotation;
 }
@@ -75,6 +107,23 @@ void InputManager::setDeltaTime(float currentFrame) {
 	_lastFrame = currentFrame;
 }
 
+void InputManager::resetFrameClock(float currentFrame) {
+	_lastFrame = currentFrame;
+}
+
+/**
+ * Consume Events - Reports whether any window event arrived since the last call
+ * 
+ * Every callback sets the flag, including the ones that only matter to ImGui
+ * (characters, focus, cursor enter) and window damage, so the render scheduler
+ * can tell a static scene from one that needs a redraw.
+ */
+bool InputManager::consumeEvents() {
+	bool pending = _pendingEvents;
+	_pendingEvents = false;
+	return pending;
+}
+
 void InputManager::setAspectRatio(float aspectRatio) {
 	_aspectRatio = aspectRatio;
 }
@@ -109,12 +158,32 @@ void InputManager::setModelRotation(float x, float y) {
 }
 
 void InputManager::framebufferSizeCallback(GLFWwindow* window, int width, int height) {
-	(void)window;
-	glViewport(0, 0, width, height);
+	static_cast<InputManager*>(glfwGetWindowUserPointer(window))->_pendingEvents = true;
+	GLState::viewport(0, 0, width, height);
+}
+
+void InputManager::charCallbackWrapper(GLFWwindow* window, unsigned int codepoint) {
+	(void)codepoint;
+	static_cast<InputManager*>(glfwGetWindowUserPointer(window))->_pendingEvents = true;
+}
+
+void InputManager::cursorEnterCallbackWrapper(GLFWwindow* window, int entered) {
+	(void)entered;
+	static_cast<InputManager*>(glfwGetWindowUserPointer(window))->_pendingEvents = true;
+}
+
+void InputManager::windowFocusCallbackWrapper(GLFWwindow* window, int focused) {
+	(void)focused;
+	static_cast<InputManager*>(glfwGetWindowUserPointer(window))->_pendingEvents = true;
+}
+
+void InputManager::windowRefreshCallbackWrapper(GLFWwindow* window) {
+	static_cast<InputManager*>(glfwGetWindowUserPointer(window))->_pendingEvents = true;
 }
 
 void InputManager::mouseButtonCallbackWrapper(GLFWwindow* window, int button, int action, int mods) {
     InputManager* inputManager = static_cast<InputManager*>(glfwGetWindowUserPointer(window));
+    inputManager->_pendingEvents = true;
     inputManager->mouseButtonCallback(window, button, action, mods);
 }
 
@@ -160,6 +229,7 @@ void InputManager::mouseButtonCallback(GLFWwindow* window, int button, int actio
 
 void InputManager::mouseCallbackWrapper(GLFWwindow* window, double xpos, double ypos) {
     InputManager* inputManager = static_cast<InputManager*>(glfwGetWindowUserPointer(window));
+    inputManager->_pendingEvents = true;
     inputManager->mouseCallback(window, xpos, ypos);
 }
 
@@ -209,11 +279,13 @@ void InputManager::mouseCallback(GLFWwindow* window, double xpos, double ypos) {
 
 void InputManager::scrollCallbackWrapper(GLFWwindow* window, double xoffset, double yoffset) {
     InputManager* inputManager = static_cast<InputManager*>(glfwGetWindowUserPointer(window));
+    inputManager->_pendingEvents = true;
     inputManager->scrollCallback(window, xoffset, yoffset);
 }
 
 void InputManager::keyCallbackWrapper(GLFWwindow* window, int key, int scancode, int action, int mods) {
     InputManager* inputManager = static_cast<InputManager*>(glfwGetWindowUserPointer(window));
+    inputManager->_pendingEvents = true;
     inputManager->keyCallback(window, key, scancode, action, mods);
 }
 
@@ -265,6 +337,7 @@ void InputManager::scrollCallback(GLFWwindow* window, double xoffset, double yof
  *    - X: Toggle vertex visualization
  *    - C: Toggle CRT post-processing effect
  *    - T: Toggle texture rendering mode
+ *    - F12: Save a screenshot of the viewport
  * 3. Trigger appropriate callback to notify other components
  */
 void InputManager::keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
@@ -332,6 +405,12 @@ void InputManager::keyCallback(GLFWwindow* window, int key, int scancode, int ac
     if (key == GLFW_KEY_R && action == GLFW_PRESS) {
         resetView();
     }
+
+    if (key == GLFW_KEY_F12 && action == GLFW_PRESS) {
+        if (_onScreenshot) {
+            _onScreenshot();
+        }
+    }
 }
 
 void InputManager::setVertexToggleCallback(std::function<void(bool)> callback) {
@@ -350,6 +429,10 @@ void InputManager::setTextureToggleCallback(std::function<void(bool)> callback)
     _onTextureToggle = callback;
 }
 
+void InputManager::setScreenshotCallback(std::function<void()> callback) {
+    _onScreenshot = callback;
+}
+
 void InputManager::calculateOptimalCameraPosition() {
     float boundingBoxDiagonal = _boundingBox.getDiagonal();
     float distance = boundingBoxDiagonal * 1.5f;
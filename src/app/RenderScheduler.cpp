@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RenderScheduler.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/19 09:13:10 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/19 16:48:21 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/RenderScheduler.hpp"
+
+RenderScheduler::RenderScheduler(double idleTimeout)
+    : _onDemand(true), _animating(false), _pendingFrames(REDRAW_FRAMES), _idleTimeout(idleTimeout),
+      _idle(false), _resumed(false), _idleStart(0.0), _idleClock(0), _idleWakeups(0),
+      _windowStart(glfwGetTime()), _windowClock(std::clock()), _windowFrames(0) {}
+
+float RenderScheduler::cpuPercent(std::clock_t cpuStart, double wallSeconds) {
+    if (wallSeconds <= 0.0) {
+        return 0.0f;
+    }
+    double cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    return static_cast<float>(100.0 * cpuSeconds / wallSeconds);
+}
+
+void RenderScheduler::setOnDemand(bool onDemand) {
+    _onDemand = onDemand;
+    _stats.onDemand = onDemand;
+    requestRedraw();
+}
+
+void RenderScheduler::setAnimating(bool animating) {
+    _animating = animating;
+    _stats.animating = animating;
+}
+
+void RenderScheduler::requestRedraw(int frames) {
+    if (frames > _pendingFrames) {
+        _pendingFrames = frames;
+    }
+}
+
+/**
+ * Wait For Events - Processes window events, blocking while there is nothing to draw
+ *
+ * FLOW:
+ * 1. Continuous mode, running animation or pending redraws: poll and return immediately
+ * 2. Idle: block until an event arrives or the timeout expires; the timeout keeps the
+ *    loop responsive to window close and to state changed outside of event callbacks
+ */
+void RenderScheduler::waitForEvents() {
+    if (isActive()) {
+        glfwPollEvents();
+    } else {
+        glfwWaitEventsTimeout(_idleTimeout);
+    }
+}
+
+/**
+ * Begin Frame - Decides whether this iteration renders and keeps the usage counters
+ *
+ * FLOW:
+ * 1. Nothing dirty: enter (or stay in) the idle period, count the wakeup and return false;
+ *    the previously presented frame stays on screen
+ * 2. Rendering after an idle period: close it, recording its length and CPU usage, and
+ *    restart the active measurement window so it only covers rendered time
+ * 3. Consume one pending redraw and roll the one-second active window (fps, CPU usage)
+ */
+bool RenderScheduler::beginFrame() {
+    double now = glfwGetTime();
+    _resumed = false;
+
+    if (!isActive()) {
+        if (!_idle) {
+            _idle = true;
+            _idleStart = now;
+            _idleClock = std::clock();
+            _idleWakeups = 0;
+        } else {
+            _idleWakeups++;
+        }
+        return false;
+    }
+
+    if (_idle) {
+        _idle = false;
+        _resumed = true;
+        _stats.idleSeconds = static_cast<float>(now - _idleStart);
+        _stats.idleCpuUsage = cpuPercent(_idleClock, now - _idleStart);
+        _stats.idleWakeups = _idleWakeups;
+        _windowStart = now;
+        _windowClock = std::clock();
+        _windowFrames = 0;
+    }
+
+    if (_pendingFrames > 0) {
+        _pendingFrames--;
+    }
+
+    _windowFrames++;
+    double elapsed = now - _windowStart;
+    if (elapsed >= 1.0) {
+        _stats.framesPerSecond = static_cast<float>(_windowFrames / elapsed);
+        _stats.cpuUsage = cpuPercent(_windowClock, elapsed);
+        _windowStart = now;
+        _windowClock = std::clock();
+        _windowFrames = 0;
+    }
+    return true;
+}
@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ResolutionScaler.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/23 09:32:40 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/23 17:05:58 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/ResolutionScaler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Raise the scale only below this fraction of the budget, so a scale that just fits
+    // is not pushed back over it; lower it as soon as the budget is exceeded
+    const float HEADROOM = 0.8f;
+    // Aim adjustments slightly under the budget
+    const float TARGET = 0.9f;
+    const float MAX_SCALE = 1.0f;
+}
+
+ResolutionScaler::ResolutionScaler(float budgetMs, float minScale)
+    : _dynamic(true), _manualScale(MAX_SCALE), _scale(MAX_SCALE), _budgetMs(budgetMs),
+      _minScale(minScale), _settleFrames(0) {
+    _stats.budgetMs = budgetMs;
+}
+
+void ResolutionScaler::setDynamic(bool dynamic) {
+    _dynamic = dynamic;
+    _stats.dynamic = dynamic;
+    _settleFrames = 0;
+    if (!dynamic) {
+        _scale = _manualScale;
+    }
+}
+
+void ResolutionScaler::setManualScale(float scale) {
+    _manualScale = std::min(std::max(scale, _minScale), MAX_SCALE);
+    if (!_dynamic) {
+        _scale = _manualScale;
+    }
+}
+
+void ResolutionScaler::setBudget(float budgetMs) {
+    _budgetMs = budgetMs;
+    _stats.budgetMs = budgetMs;
+    _settleFrames = 0;
+}
+
+/**
+ * Update - Adjusts the render scale from the latest smoothed GPU frame time
+ *
+ * FLOW:
+ * 1. Manual mode, or no timer sample yet (0 ms): keep the current scale
+ * 2. Wait SETTLE_FRAMES after a change: timer results arrive a few frames late and are
+ *    smoothed, so earlier samples still describe the previous scale
+ * 3. Inside the dead band (HEADROOM..1 of the budget) the scale holds
+ * 4. Otherwise scale by sqrt(TARGET * budget / time), quantized to SCALE_STEP and clamped
+ *    to [minScale, 1]; a change restarts the settle period
+ */
+void ResolutionScaler::update(float gpuMs) {
+    if (!_dynamic || gpuMs <= 0.0f) {
+        return;
+    }
+    if (_settleFrames > 0) {
+        _settleFrames--;
+        return;
+    }
+    if (gpuMs <= _budgetMs && gpuMs >= _budgetMs * HEADROOM) {
+        return;
+    }
+
+    float target = _scale * std::sqrt(TARGET * _budgetMs / gpuMs);
+    target = std::round(target / SCALE_STEP) * SCALE_STEP;
+    target = std::min(std::max(target, _minScale), MAX_SCALE);
+
+    if (std::fabs(target - _scale) >= SCALE_STEP * 0.5f) {
+        _scale = target;
+        _settleFrames = SETTLE_FRAMES;
+        _stats.changes++;
+    }
+}
+
+/**
+ * Apply - Computes the scene target size for a viewport at the current scale
+ *
+ * Sizes are rounded and kept at least one pixel; at scale 1 they equal the viewport,
+ * which lets the caller skip the off-screen target altogether. fullScale overrides the
+ * scale for one frame (the last one before the render loop idles, which stays on screen).
+ */
+void ResolutionScaler::apply(int viewportWidth, int viewportHeight, int &renderWidth, int &renderHeight, bool fullScale) {
+    float scale = fullScale ? MAX_SCALE : _scale;
+    renderWidth = std::max(1, static_cast<int>(std::lround(viewportWidth * scale)));
+    renderHeight = std::max(1, static_cast<int>(std::lround(viewportHeight * scale)));
+
+    _stats.scale = scale;
+    _stats.viewportWidth = viewportWidth;
+    _stats.viewportHeight = viewportHeight;
+    _stats.renderWidth = renderWidth;
+    _stats.renderHeight = renderHeight;
+}
@@ -0,0 +1,206 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SoftwareRenderer.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/29 09:14:40 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/29 18:31:52 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/SoftwareRenderer.hpp"
+#include "../../include/Mesh.hpp"
+#include "../../include/PngWriter.hpp"
+#include "../../include/Colors.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+namespace {
+    // Renderer::execute's flat colors
+    const glm::vec3 SURFACE_COLOR(0.5f, 0.5f, 0.9f);
+    const glm::vec3 LINE_COLOR(Colors::OFF_WHITE.r, Colors::OFF_WHITE.g, Colors::OFF_WHITE.b);
+    const glm::vec3 CLEAR_COLOR(Colors::BLACK_CHARCOAL_1.r, Colors::BLACK_CHARCOAL_1.g, Colors::BLACK_CHARCOAL_1.b);
+}
+
+SoftwareRenderer::SoftwareRenderer(const HeadlessOptions &options, size_t threads)
+    : _options(options), _rasterizer(std::make_unique<SoftwareRasterizer>(threads)), _valid(false) {
+    _valid = _rasterizer->resize(_options.width, _options.height);
+
+    if (_options.antiAliasing != AntiAliasing::OFF || _options.crt) {
+        std::cerr << "Warning: the software rasterizer has no anti-aliasing or CRT effect, ignoring them" << std::endl;
+    }
+}
+
+/**
+ * Load Texture - Loads a texture once and keeps it for later models (see trimTextureCache)
+ */
+std::shared_ptr<SoftwareTexture> SoftwareRenderer::loadTexture(const std::string &path) {
+    if (path.empty()) {
+        return nullptr;
+    }
+    auto it = _textureCache.find(path);
+    if (it != _textureCache.end()) {
+        return it->second;
+    }
+    if (!std::filesystem::exists(path)) {
+        std::cerr << "Warning: Texture file not found: " << path << std::endl;
+        return nullptr;
+    }
+
+    std::shared_ptr<SoftwareTexture> texture = SoftwareTexture::load(path);
+    if (texture) {
+        _textureCache[path] = texture;
+    }
+    return texture;
+}
+
+void SoftwareRenderer::trimTextureCache(size_t maxTextures) {
+    if (_textureCache.size() > maxTextures) {
+        _textureCache.clear();
+    }
+}
+
+/**
+ * Prepare - Sets up a model's textures, wireframe and camera the way HeadlessRenderer does
+ *
+ * FLOW:
+ * 1. Material textures (diffuse map, else ambient map, as TextureLoader picks them) with
+ *    the default texture as fallback
+ * 2. Wireframe line list built like the mesh's wireframe index buffer
+ * 3. Camera: a windowless InputManager in the viewer's default view
+ */
+bool SoftwareRenderer::prepare(Scene &scene, Parser &parser) {
+    if (!_valid) {
+        return false;
+    }
+
+    scene.parser = &parser;
+    const auto &materials = parser.getMaterials();
+    for (size_t i = 0; i < materials.size(); ++i) {
+        std::shared_ptr<SoftwareTexture> texture = loadTexture(materials[i].diffuseMap);
+        if (!texture) {
+            texture = loadTexture(materials[i].ambientMap);
+        }
+        if (texture) {
+            scene.materialTextures[static_cast<int>(i)] = texture;
+        }
+    }
+    if (!scene.materialTextures.empty()) {
+        scene.texture = scene.materialTextures.begin()->second;
+    }
+    if (!scene.texture) {
+        scene.texture = loadTexture("resources/textures/Unicorn.png");
+    }
+
+    if (_options.wireframe) {
+        scene.wireframe = Mesh::buildLineList(parser.getIndices());
+    }
+
+    scene.camera = std::make_unique<InputManager>(nullptr, parser.getMode(), parser.getOptimalCameraDistance(), parser.getBoundingBox());
+    scene.camera->resetView();
+    scene.camera->setAspectRatio(static_cast<float>(_options.width) / static_cast<float>(_options.height));
+    if (_options.orthographic) {
+        scene.camera->setUseOrthographic(true);
+        scene.camera->setModelRotation(35.265f, 45.0f);
+    }
+    return true;
+}
+
+/**
+ * Render Frame - Draws the model with the draws the GL renderer would queue
+ *
+ * planSceneDraws() picks them, as for Renderer::submitModel: wireframe or FDF lines as flat
+ * lines, otherwise the whole mesh or one draw per non-empty material group with its texture.
+ * Always the full-detail mesh: the rasterizer has no use for the LOD chain.
+ */
+void SoftwareRenderer::renderFrame(Scene &scene) {
+    InputManager &camera = *scene.camera;
+    camera.createMatrices();
+    std::vector<glm::mat4> matrices = camera.getMatrices();
+
+    SoftwareFrameData frame;
+    frame.model = matrices[0];
+    frame.view = matrices[1];
+    frame.projection = matrices[2];
+    frame.viewPos = camera.getCameraPosition();
+    _rasterizer->beginFrame(frame, CLEAR_COLOR);
+
+    const Parser &parser = *scene.parser;
+    const std::vector<Vertex> &vertices = parser.getVertices();
+    const auto &materialGroups = parser.getMaterialGroups();
+    auto draws = planSceneDraws(materialGroups, parser.getMode(), scene.materialTextures, scene.texture.get(),
+                                _options.useTexture, _options.wireframe);
+
+    for (const auto &draw : draws) {
+        if (draw.kind == DrawKind::WIREFRAME) {
+            _rasterizer->submitLines(vertices, scene.wireframe, LINE_COLOR);
+            continue;
+        }
+
+        const std::vector<unsigned int> &indices = draw.group < 0 ? parser.getIndices()
+                                                                  : materialGroups[static_cast<size_t>(draw.group)].indices;
+        if (draw.kind == DrawKind::LINES) {
+            _rasterizer->submitLines(vertices, indices, LINE_COLOR);
+        } else {
+            _rasterizer->submitTriangles(vertices, indices, SURFACE_COLOR, draw.useTexture ? draw.texture : nullptr);
+        }
+    }
+
+    _rasterizer->flush();
+}
+
+/**
+ * Write - Saves the color buffer as PNG, bottom row first like a GL capture
+ */
+bool SoftwareRenderer::write(const std::string &path) {
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(parent, error);
+    }
+
+    _rasterizer->readPixels(_pixels);
+    if (!PngWriter::write(path, _pixels.data(), _options.width, _options.height, 3, true)) {
+        std::cerr << "Failed to write " << path << std::endl;
+        _stats.failed++;
+        return false;
+    }
+    _stats.written++;
+    return true;
+}
+
+bool SoftwareRenderer::renderImage(Parser &parser, const std::string &path) {
+    Scene scene;
+    if (!prepare(scene, parser)) {
+        return false;
+    }
+    renderFrame(scene);
+    return write(path);
+}
+
+/**
+ * Render Turntable - Writes a full turn as numbered frames, like TurntableRecorder
+ *
+ * Same angles and file names as a GL turntable, so the two can be diffed frame by frame.
+ */
+bool SoftwareRenderer::renderTurntable(Parser &parser, const std::string &directory, int frames) {
+    Scene scene;
+    if (!prepare(scene, parser)) {
+        return false;
+    }
+
+    glm::vec3 rotation = scene.camera->getModelRotation();
+    bool written = true;
+    for (int frame = 0; frame < frames; ++frame) {
+        scene.camera->setModelRotation(rotation.x, rotation.y + 360.0f * static_cast<float>(frame) / static_cast<float>(frames));
+        renderFrame(scene);
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%04d.png", frame);
+        written = write(directory + "/" + name) && written;
+    }
+    return written;
+}
@@ -0,0 +1,145 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TurntableRecorder.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/25 09:19:02 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/25 16:40:27 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/TurntableRecorder.hpp"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <cstdio>
+
+namespace {
+    // Encoded frames allowed to wait per encoder before the render loop waits for them
+    const size_t QUEUED_FRAMES_PER_ENCODER = 2;
+}
+
+/**
+ * TurntableRecorder Constructor - Picks the encoder pool size
+ *
+ * Encoding a frame costs more CPU than rendering it, so by default every core but the
+ * one running the render loop encodes.
+ */
+TurntableRecorder::TurntableRecorder(size_t encoders)
+    : _encoders(encoders), _frame(0), _frames(0), _startAngle(0.0f) {
+    if (_encoders == 0) {
+        unsigned int cores = std::thread::hardware_concurrency();
+        _encoders = cores > 1 ? cores - 1 : 1;
+    }
+}
+
+/**
+ * Start - Begins a recording of frames images covering one full turn
+ *
+ * FLOW:
+ * 1. A recording already running is stopped first; its frames are still written
+ * 2. The frames go to directory (default: captures/turntable_<timestamp>) as
+ *    frame_0000.png, frame_0001.png, ...
+ * 3. A dedicated capture with the encoder pool is created; it lives until the last
+ *    frame is written, so no encoder threads exist between recordings
+ */
+void TurntableRecorder::start(int frames, float startAngle, const std::string &directory) {
+    if (_capture) {
+        _capture->flush();
+        finish();
+    }
+
+    _frames = std::max(frames, 1);
+    _frame = 0;
+    _startAngle = startAngle;
+    _directory = directory.empty() ? "captures/turntable_" + FrameCapture::timestamp() : directory;
+    _capture = std::make_unique<FrameCapture>(_directory, _encoders);
+    _start = std::chrono::steady_clock::now();
+
+    _stats = TurntableStats();
+    _stats.recording = true;
+    _stats.frames = _frames;
+    _stats.directory = _directory;
+    std::cout << "Recording " << _frames << " turntable frames to " << _directory << " (" << _encoders
+              << " encoder threads)" << std::endl;
+}
+
+/**
+ * Stop - Ends the recording early; frames already captured are still written
+ */
+void TurntableRecorder::stop() {
+    if (isRecording()) {
+        _frames = _frame;
+        _stats.frames = _frames;
+    }
+}
+
+float TurntableRecorder::getAngle() const {
+    return _frames > 0 ? _startAngle + 360.0f * static_cast<float>(_frame) / static_cast<float>(_frames) : _startAngle;
+}
+
+/**
+ * Capture Frame - Saves the current frame and advances the turntable
+ *
+ * Waits (instead of dropping the frame) while the capture ring is full or the encoders are
+ * behind: that wait is what paces the recording.
+ */
+void TurntableRecorder::captureFrame(unsigned int framebuffer, int x, int y, int width, int height) {
+    if (!isRecording()) {
+        return;
+    }
+
+    _capture->waitForSlot(_encoders * QUEUED_FRAMES_PER_ENCODER);
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame_%04d.png", _frame);
+    _capture->capture(framebuffer, x, y, width, height, _directory + "/" + name);
+    _frame++;
+    _stats.frame = _frame;
+    _stats.recording = isRecording();
+}
+
+/**
+ * Update - Forwards finished readbacks to the encoders and detects the end of the recording
+ *
+ * Called once per loop iteration while active. Once every frame is rendered and nothing is
+ * pending the capture (and its encoder threads) is released.
+ */
+void TurntableRecorder::update() {
+    if (!_capture) {
+        return;
+    }
+
+    _capture->update();
+    FrameCaptureStats capture = _capture->getStats();
+    float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - _start).count();
+
+    _stats.written = capture.written;
+    _stats.pending = capture.pending;
+    _stats.framesPerSecond = elapsed > 0.0f ? static_cast<float>(capture.written) / elapsed : 0.0f;
+    _stats.encoding = !isRecording() && capture.pending > 0;
+
+    if (!isRecording() && capture.pending == 0) {
+        finish();
+    }
+}
+
+void TurntableRecorder::finish() {
+    FrameCaptureStats capture = _capture->getStats();
+    float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - _start).count();
+
+    _stats.recording = false;
+    _stats.encoding = false;
+    _stats.written = capture.written;
+    _stats.pending = 0;
+    std::cout << "Turntable: " << capture.written << " of " << _frames << " frames written to " << _directory
+              << " in " << elapsed << " s";
+    if (capture.failed > 0) {
+        std::cout << " (" << capture.failed << " failed)";
+    }
+    std::cout << std::endl;
+
+    _capture.reset();
+}
@@ -29,10 +29,184 @@
 #include "../include/Mesh.hpp"
 #include "../include/Shader.hpp"
 #include "../include/Renderer.hpp"
+#include "../include/StartupTimer.hpp"
+#include "../include/HeadlessContext.hpp"
+#include "../include/HeadlessRenderer.hpp"
+#include "../include/SoftwareRenderer.hpp"
+#include "../include/BatchThumbnailer.hpp"
+#include <memory>
+#include <filesystem>
+#include <thread>
+#include <cstdlib>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "../include/stb_image/stb_image.h"
 
+static const int BATCH_THUMBNAIL_SIZE = 256;
+
+/**
+ * @brief Parses "WIDTHxHEIGHT" (e.g. 1280x720) into positive dimensions.
+ */
+static bool parseSize(const std::string &value, int &width, int &height) {
+    size_t separator = value.find('x');
+    if (separator == std::string::npos) {
+        return false;
+    }
+    try {
+        width = std::stoi(value.substr(0, separator));
+        height = std::stoi(value.substr(separator + 1));
+    } catch (const std::exception &) {
+        return false;
+    }
+    return width > 0 && height > 0;
+}
+
+static bool parseAntiAliasing(const std::string &value, AntiAliasing &mode) {
+    const char *names[] = {"off", "fxaa", "msaa2", "msaa4", "msaa8"};
+    for (int i = 0; i < 5; ++i) {
+        if (value == names[i]) {
+            mode = static_cast<AntiAliasing>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Renders the model without a window and writes the image (or turntable frames).
+ *
+ * The output defaults to captures/<model name>.png, or captures/<model name>_turntable/
+ * for a turntable. Returns the process exit code.
+ */
+static int runHeadless(Parser &parser, Mesh &mesh, Renderer &renderer, const HeadlessOptions &options,
+                       const std::string &file, std::string output, int turntableFrames) {
+    std::string name = std::filesystem::path(file).stem().string();
+    if (output.empty()) {
+        output = turntableFrames > 0 ? "captures/" + name + "_turntable" : "captures/" + name + ".png";
+    }
+
+    unsigned int cores = std::thread::hardware_concurrency();
+    HeadlessRenderer headless(&renderer, options, cores > 1 ? cores - 1 : 1);
+    StartupTimer::mark("Headless setup");
+
+    bool rendered = turntableFrames > 0 ? headless.renderTurntable(parser, mesh, output, turntableFrames)
+                                        : headless.renderImage(parser, mesh, output);
+    headless.flush();
+    StartupTimer::mark("Render and write");
+    StartupTimer::report();
+
+    FrameCaptureStats stats = headless.getCaptureStats();
+    if (!rendered || stats.failed > 0) {
+        std::cerr << "Error: headless render of " << file << " failed" << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << output << " (" << options.width << "x" << options.height << ")" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Renders the model with the CPU rasterizer and writes the image (or turntable frames).
+ *
+ * Same outputs as runHeadless, without any GL context. Returns the process exit code.
+ */
+static int runSoftware(Parser &parser, const HeadlessOptions &options, const std::string &file,
+                       std::string output, int turntableFrames) {
+    std::string name = std::filesystem::path(file).stem().string();
+    if (output.empty()) {
+        output = turntableFrames > 0 ? "captures/" + name + "_turntable" : "captures/" + name + ".png";
+    }
+
+    SoftwareRenderer software(options);
+    StartupTimer::mark("Software setup");
+
+    bool rendered = turntableFrames > 0 ? software.renderTurntable(parser, output, turntableFrames)
+                                        : software.renderImage(parser, output);
+    StartupTimer::mark("Render and write");
+    StartupTimer::report();
+
+    const SoftwareRasterStats &raster = software.getRasterStats();
+    std::cout << "Software rasterizer: " << raster.triangles << " triangles, " << raster.lines << " lines, "
+              << raster.binned << " binned over " << raster.tiles << " tiles, " << raster.threads << " thread"
+              << (raster.threads > 1 ? "s" : "") << "\n"
+              << "  transform " << raster.transformMs << " ms, bin " << raster.binMs << " ms, raster "
+              << raster.rasterMs << " ms (last frame)" << std::endl;
+
+    if (!rendered || software.getStats().failed > 0) {
+        std::cerr << "Error: software render of " << file << " failed" << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << output << " (" << options.width << "x" << options.height << ")" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Renders a thumbnail for every OBJ/FDF file under a directory.
+ *
+ * The spare cores are split between parser threads and PNG encoders; the main thread owns
+ * the GL context and only uploads and renders. Output defaults to captures/thumbnails/.
+ * With software set, the rasterizer takes every core and half the spare ones parse.
+ * --optimize, --overdraw and --lod run on the parser threads, after each parse.
+ * Returns the process exit code: 1 if any model failed.
+ */
+static int runBatch(const HeadlessOptions &options, const std::string &directory, std::string output,
+                    bool quantize, bool software, bool optimize, bool reduceOverdraw, bool generateLODs) {
+    if (!std::filesystem::is_directory(directory)) {
+        std::cerr << "Error: " << directory << " is not a directory" << std::endl;
+        return 1;
+    }
+    if (output.empty()) {
+        output = "captures/thumbnails";
+    }
+
+    unsigned int cores = std::thread::hardware_concurrency();
+    size_t spare = cores > 1 ? cores - 1 : 1;
+    BatchStats stats;
+    std::string setup;
+
+    if (software) {
+        size_t parsers = std::max<size_t>(spare / 2, 1);
+        SoftwareRenderer renderer(options);
+        BatchThumbnailer batch(&renderer, parsers);
+        batch.setMeshProcessing(optimize, reduceOverdraw, generateLODs);
+        StartupTimer::mark("Software setup");
+        StartupTimer::report();
+
+        stats = batch.run(directory, output);
+        setup = std::to_string(parsers) + " parser" + (parsers > 1 ? "s" : "") + ", software rasterizer";
+    } else {
+        Shader shader("resources/shaders/3D.shader");
+        Renderer renderer(&shader);
+        StartupTimer::mark("Shader source");
+
+        size_t encoders = std::max<size_t>(spare / 2, 1);
+        size_t parsers = std::max<size_t>(spare - encoders, 1);
+
+        HeadlessRenderer headless(&renderer, options, encoders);
+        BatchThumbnailer batch(&headless, parsers, 0, quantize);
+        batch.setMeshProcessing(optimize, reduceOverdraw, generateLODs);
+        StartupTimer::mark("Headless setup");
+        StartupTimer::report();
+
+        stats = batch.run(directory, output);
+        setup = std::to_string(parsers) + " parser" + (parsers > 1 ? "s" : "") + ", "
+              + std::to_string(encoders) + " encoder" + (encoders > 1 ? "s" : "");
+    }
+    if (stats.found == 0) {
+        std::cerr << "Error: no .obj or .fdf files under " << directory << std::endl;
+        return 1;
+    }
+
+    std::cout << "Thumbnails: " << stats.written << "/" << stats.found << " written to " << output
+              << " (" << options.width << "x" << options.height << ", " << setup << ")" << std::endl;
+    std::cout << "  " << stats.seconds << " s, " << stats.assetsPerSecond << " assets/s, renderer waited "
+              << stats.renderWaitSeconds << " s for parsed models" << std::endl;
+    if (stats.failed > 0) {
+        std::cerr << "Error: " << stats.failed << " model" << (stats.failed > 1 ? "s" : "") << " failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
 /**
  * @brief Main entry point for the SCOP application.
  *
@@ -40,10 +214,15 @@
  * 1. Validates command-line arguments
  * 2. Creates and configures the Parser for file format detection
  * 3. Parses the input file (OBJ or FDF) into vertex/index data
- * 4. Builds the Mesh from parsed geometry data
- * 5. Compiles and links the 3D shader program
- * 6. Creates the Renderer with shader binding
- * 7. Launches the main App with UI, input handling, and render loop
+ *    (optionally reordered for the vertex cache with --optimize, and for
+ *    overdraw on top of that with --overdraw, and simplified into a LOD chain with --lod)
+ * 4. Builds the Mesh from parsed geometry data (packed 16-byte vertices with --quantize)
+ * 5. Loads the 3D shader source
+ * 6. Creates the Renderer, which compiles one program per shader variant from it
+ * 7. Launches the main App with UI, input handling, and render loop, or with --headless
+ *    renders into an off-screen target of an EGL context with no window and writes a PNG;
+ *    with --batch the first argument is a directory and every model in it gets a thumbnail;
+ *    --software draws either of those on the CPU instead, without any GL context
  *
  * @param argc Number of command-line arguments
  * @param argv Array of command-line argument strings
@@ -54,23 +233,135 @@
  */
 int main(int argc, char** argv) {
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <path_to_obj_file>\n";
+        std::cerr << "Usage: " << argv[0] << " <path_to_obj_file> [--optimize] [--overdraw] [--quantize] [--lod]\n"
+                  << "       " << argv[0] << " <directory> --batch [--output <directory>] [--size <W>x<H>] [headless options]\n"
+                  << "       [--headless [--output <path>] [--size <W>x<H>] [--turntable <frames>] [--software]\n"
+                  << "        [--aa off|fxaa|msaa2|msaa4|msaa8] [--crt] [--texture] [--wireframe] [--ortho]]\n";
+        return 1;
+    }
+
+    bool optimizeMesh = false;
+    bool reduceOverdraw = false;
+    bool quantizeVertices = false;
+    bool generateLODs = false;
+    bool headless = false;
+    bool batch = false;
+    bool software = false;
+    bool sizeSet = false;
+    HeadlessOptions headlessOptions;
+    std::string output;
+    int turntableFrames = 0;
+    for (int i = 2; i < argc; ++i) {
+        std::string option(argv[i]);
+        bool hasValue = i + 1 < argc;
+        if (option == "--optimize") {
+            optimizeMesh = true;
+        } else if (option == "--overdraw") {
+            optimizeMesh = true;
+            reduceOverdraw = true;
+        } else if (option == "--quantize") {
+            quantizeVertices = true;
+        } else if (option == "--lod") {
+            generateLODs = true;
+        } else if (option == "--headless") {
+            headless = true;
+        } else if (option == "--batch") {
+            headless = true;
+            batch = true;
+        } else if (option == "--software") {
+            software = true;
+        } else if (option == "--output" && hasValue) {
+            output = argv[++i];
+        } else if (option == "--size" && hasValue) {
+            if (!parseSize(argv[++i], headlessOptions.width, headlessOptions.height)) {
+                std::cerr << "Invalid size: " << argv[i] << " (expected WIDTHxHEIGHT)\n";
+                return 1;
+            }
+            sizeSet = true;
+        } else if (option == "--turntable" && hasValue) {
+            turntableFrames = std::atoi(argv[++i]);
+            if (turntableFrames <= 0) {
+                std::cerr << "Invalid turntable frame count: " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (option == "--aa" && hasValue) {
+            if (!parseAntiAliasing(argv[++i], headlessOptions.antiAliasing)) {
+                std::cerr << "Unknown anti-aliasing mode: " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (option == "--crt") {
+            headlessOptions.crt = true;
+        } else if (option == "--texture") {
+            headlessOptions.useTexture = true;
+        } else if (option == "--wireframe") {
+            headlessOptions.wireframe = true;
+        } else if (option == "--ortho") {
+            headlessOptions.orthographic = true;
+        } else {
+            std::cerr << "Unknown option: " << option << "\n";
+            return 1;
+        }
+    }
+
+    if (software && !headless) {
+        std::cerr << "--software needs --headless or --batch\n";
         return 1;
     }
 
     try {
+        StartupTimer::begin();
+
+        // Created first so it outlives the mesh, whose destructor deletes GL objects
+        std::unique_ptr<HeadlessContext> headlessContext;
+        if (headless && !software) {
+            headlessContext = std::make_unique<HeadlessContext>();
+            if (!headlessContext->isValid()) {
+                return 1;
+            }
+            std::cout << "Headless context: " << headlessContext->getRendererName() << std::endl;
+            StartupTimer::mark("Headless context");
+        }
+
+        if (batch) {
+            if (!sizeSet) {
+                headlessOptions.width = BATCH_THUMBNAIL_SIZE;
+                headlessOptions.height = BATCH_THUMBNAIL_SIZE;
+            }
+            return runBatch(headlessOptions, argv[1], output, quantizeVertices, software,
+                            optimizeMesh, reduceOverdraw, generateLODs);
+        }
+
         Parser parser;
         parser.checkExtension(argv[1]);
 
         std::string modeStr(argv[1]);
         parser.setMode(modeStr);
         parser.parse(argv[1]);
+        StartupTimer::mark("Parse");
+
+        if (optimizeMesh) {
+            parser.optimize(reduceOverdraw);
+            StartupTimer::mark("Mesh optimization");
+        }
+        if (generateLODs) {
+            parser.generateLODs();
+            StartupTimer::mark("LOD generation");
+        }
+        if (software) {
+            return runSoftware(parser, headlessOptions, argv[1], output, turntableFrames);
+        }
         
-        Mesh mesh(&parser);
+        Mesh mesh(&parser, quantizeVertices);
+        StartupTimer::mark("Mesh build");
         Shader shader("resources/shaders/3D.shader");
         Renderer renderer(&shader);
+        StartupTimer::mark("Shader source");
+
+        if (headless) {
+            return runHeadless(parser, mesh, renderer, headlessOptions, argv[1], output, turntableFrames);
+        }
 
-        App app(parser.getMode(), &mesh, &shader, &renderer, &parser);
+        App app(parser.getMode(), &mesh, &renderer, &parser);
         
         app.setCurrentFile(argv[1]);
 
@@ -0,0 +1,564 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MeshOptimizer.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/11 10:02:17 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/12 16:20:05 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/MeshOptimizer.hpp"
+#include <limits>
+#include <algorithm>
+#include <cfloat>
+
+/**
+ * Analyze Vertex Cache - Simulates a FIFO post-transform cache over an index buffer
+ *
+ * FLOW:
+ * 1. Give every vertex a cache timestamp (0 = never transformed)
+ * 2. Walk the index buffer in draw order:
+ *    - A vertex is a hit if it entered the cache fewer than cacheSize insertions ago
+ *    - Otherwise it is transformed again and re-enters the cache
+ * 3. Count the distinct vertices actually referenced by the buffer
+ * 4. Derive ACMR (misses per triangle) and ATVR (misses per referenced vertex)
+ */
+VertexCacheStats MeshOptimizer::analyzeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount, unsigned int cacheSize) {
+    VertexCacheStats stats;
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0) {
+        return stats;
+    }
+
+    std::vector<unsigned int> cacheTimestamps(vertexCount, 0);
+    std::vector<bool> referenced(vertexCount, false);
+    unsigned int timestamp = cacheSize + 1;
+    size_t uniqueVertices = 0;
+
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        unsigned int index = indices[i];
+        if (index >= vertexCount) continue;
+
+        if (timestamp - cacheTimestamps[index] > cacheSize) {
+            cacheTimestamps[index] = timestamp++;
+            stats.transformedVertices++;
+        }
+        if (!referenced[index]) {
+            referenced[index] = true;
+            uniqueVertices++;
+        }
+    }
+
+    stats.acmr = static_cast<float>(stats.transformedVertices) / static_cast<float>(triangleCount);
+    stats.atvr = uniqueVertices ? static_cast<float>(stats.transformedVertices) / static_cast<float>(uniqueVertices) : 0.0f;
+    return stats;
+}
+
+/**
+ * Optimize Vertex Cache - Reorders a triangle list with the Tipsify algorithm
+ *
+ * FLOW:
+ * 1. Build vertex-to-triangle adjacency (CSR layout) and live triangle counts
+ * 2. Start fanning around the first vertex that still has live triangles
+ * 3. For the current fanning vertex:
+ *    - Emit all of its not-yet-emitted triangles
+ *    - Push their vertices to the dead-end stack and the candidate list
+ *    - Update live counts and cache timestamps of the emitted vertices
+ * 4. Pick the next fanning vertex among the candidates:
+ *    - Prefer vertices that will still be in cache after their remaining fan is emitted
+ *    - Among those, the one that entered the cache earliest (about to be evicted)
+ * 5. When no candidate qualifies, skip the dead end:
+ *    - Pop recently used vertices from the dead-end stack, then scan forward in vertex order
+ *    - Each such jump is a cache flush, recorded as a cluster start when requested
+ * 6. Stop once every vertex has run out of live triangles
+ */
+std::vector<unsigned int> MeshOptimizer::optimizeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount,
+                                                             unsigned int cacheSize, std::vector<size_t> *clusterStarts) {
+    size_t triangleCount = indices.size() / 3;
+    std::vector<unsigned int> result;
+    result.reserve(triangleCount * 3);
+
+    if (clusterStarts) {
+        clusterStarts->clear();
+    }
+    if (triangleCount == 0 || vertexCount == 0) {
+        return result;
+    }
+
+    std::vector<unsigned int> liveTriangles(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        liveTriangles[indices[i]]++;
+    }
+
+    std::vector<size_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v];
+    }
+
+    std::vector<unsigned int> adjacency(adjacencyOffsets[vertexCount]);
+    std::vector<size_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int j = 0; j < 3; ++j) {
+            unsigned int v = indices[t * 3 + j];
+            adjacency[fill[v]++] = static_cast<unsigned int>(t);
+        }
+    }
+
+    std::vector<unsigned int> cacheTimestamps(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<unsigned int> deadEnd;
+    std::vector<unsigned int> candidates;
+    unsigned int timestamp = cacheSize + 1;
+    size_t cursor = 0;
+
+    auto skipDeadEnd = [&]() -> long long {
+        while (!deadEnd.empty()) {
+            unsigned int v = deadEnd.back();
+            deadEnd.pop_back();
+            if (liveTriangles[v] > 0) {
+                return v;
+            }
+        }
+        while (cursor < vertexCount) {
+            if (liveTriangles[cursor] > 0) {
+                return static_cast<long long>(cursor);
+            }
+            cursor++;
+        }
+        return -1;
+    };
+
+    long long fanning = skipDeadEnd();
+    while (fanning >= 0) {
+        if (clusterStarts && (clusterStarts->empty() || candidates.empty())) {
+            clusterStarts->push_back(result.size() / 3);
+        }
+
+        candidates.clear();
+        for (size_t a = adjacencyOffsets[fanning]; a < adjacencyOffsets[fanning + 1]; ++a) {
+            unsigned int t = adjacency[a];
+            if (emitted[t]) continue;
+
+            for (int j = 0; j < 3; ++j) {
+                unsigned int v = indices[t * 3 + j];
+                result.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                liveTriangles[v]--;
+                if (timestamp - cacheTimestamps[v] > cacheSize) {
+                    cacheTimestamps[v] = timestamp++;
+                }
+            }
+            emitted[t] = true;
+        }
+
+        long long next = -1;
+        long long bestPriority = -1;
+        for (unsigned int v : candidates) {
+            if (liveTriangles[v] == 0) continue;
+
+            long long priority = 0;
+            if (timestamp - cacheTimestamps[v] + 2 * liveTriangles[v] <= cacheSize) {
+                priority = timestamp - cacheTimestamps[v];
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next = v;
+            }
+        }
+
+        if (next == -1) {
+            candidates.clear();
+            next = skipDeadEnd();
+        }
+        fanning = next;
+    }
+
+    return result;
+}
+
+namespace {
+    /**
+     * Raster Overdraw Triangle - Depth-tests one screen-space triangle (x, y in pixels, z = depth)
+     * into a square depth buffer, counting the fragments that pass (LESS, no culling)
+     */
+    void rasterOverdrawTriangle(const glm::vec3 p[3], std::vector<float> &depthBuffer, int resolution, size_t &pixelsShaded) {
+        float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+        if (std::abs(area) < 1e-8f) return;
+
+        int minX = std::max(0, static_cast<int>(std::floor(std::min({p[0].x, p[1].x, p[2].x}))));
+        int maxX = std::min(resolution - 1, static_cast<int>(std::ceil(std::max({p[0].x, p[1].x, p[2].x}))));
+        int minY = std::max(0, static_cast<int>(std::floor(std::min({p[0].y, p[1].y, p[2].y}))));
+        int maxY = std::min(resolution - 1, static_cast<int>(std::ceil(std::max({p[0].y, p[1].y, p[2].y}))));
+
+        for (int y = minY; y <= maxY; ++y) {
+            for (int x = minX; x <= maxX; ++x) {
+                float px = x + 0.5f;
+                float py = y + 0.5f;
+                float w0 = ((p[2].x - p[1].x) * (py - p[1].y) - (p[2].y - p[1].y) * (px - p[1].x)) / area;
+                float w1 = ((p[0].x - p[2].x) * (py - p[2].y) - (p[0].y - p[2].y) * (px - p[2].x)) / area;
+                float w2 = 1.0f - w0 - w1;
+                if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) continue;
+
+                float depth = w0 * p[0].z + w1 * p[1].z + w2 * p[2].z;
+                float &stored = depthBuffer[y * resolution + x];
+                if (depth < stored) {
+                    stored = depth;
+                    pixelsShaded++;
+                }
+            }
+        }
+    }
+
+    size_t countCoveredPixels(const std::vector<float> &depthBuffer) {
+        size_t covered = 0;
+        for (float depth : depthBuffer) {
+            if (depth != FLT_MAX) {
+                covered++;
+            }
+        }
+        return covered;
+    }
+}
+
+/**
+ * Analyze Overdraw - Counts shaded fragments per covered pixel for a triangle order
+ * 
+ * FLOW:
+ * 1. Fit a square raster grid to the bounding box of the referenced vertices
+ * 2. Outside views, for each of the six axis-aligned directions (both signs of X, Y, Z):
+ *    - Orthographically project triangles onto the plane of the other two axes
+ * 3. Inside views, from the bounding box center, one 90 degree perspective view per axis
+ *    direction (a cube map, so every direction is seen once), which is how an interior
+ *    scene is looked at:
+ *    - Clip each triangle against a near plane and project it, depth = -1/distance
+ *      (affine in screen space, so it interpolates exactly)
+ * 4. Every view rasterizes the triangles in index order with a LESS depth test and no
+ *    culling, counts every fragment that passes (it would be shaded) and every pixel
+ *    left covered once all triangles are drawn
+ * 5. Overdraw = shaded fragments / covered pixels (1.0 means perfect front-to-back order)
+ *    for each set of views, and the mean of the two as the overall figure; the shaded
+ *    count of every view is kept too (covered pixels do not depend on the order)
+ */
+OverdrawStats MeshOptimizer::analyzeOverdraw(const std::vector<unsigned int> &indices, const std::vector<Vertex> &vertices) {
+    const int resolution = 256;
+    OverdrawStats stats;
+
+    glm::vec3 boundsMin(FLT_MAX);
+    glm::vec3 boundsMax(-FLT_MAX);
+    for (unsigned int index : indices) {
+        boundsMin = glm::min(boundsMin, vertices[index].position);
+        boundsMax = glm::max(boundsMax, vertices[index].position);
+    }
+
+    glm::vec3 size = boundsMax - boundsMin;
+    float extent = std::max(std::max(size.x, size.y), size.z);
+    if (indices.size() < 3 || extent <= 0.0f) {
+        return stats;
+    }
+
+    float scale = (resolution - 1) / extent;
+    std::vector<float> depthBuffer(resolution * resolution);
+    size_t outsideShaded = 0, outsideCovered = 0;
+    size_t insideShaded = 0, insideCovered = 0;
+    stats.viewShaded.reserve(12);
+
+    for (int axis = 0; axis < 3; ++axis) {
+        int uAxis = (axis + 1) % 3;
+        int vAxis = (axis + 2) % 3;
+
+        for (float direction : {1.0f, -1.0f}) {
+            std::fill(depthBuffer.begin(), depthBuffer.end(), FLT_MAX);
+            size_t viewShaded = 0;
+
+            for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                glm::vec3 p[3];
+                for (int j = 0; j < 3; ++j) {
+                    const glm::vec3 &position = vertices[indices[i + j]].position;
+                    p[j] = glm::vec3((position[uAxis] - boundsMin[uAxis]) * scale,
+                                     (position[vAxis] - boundsMin[vAxis]) * scale,
+                                     position[axis] * direction);
+                }
+                rasterOverdrawTriangle(p, depthBuffer, resolution, viewShaded);
+            }
+            outsideShaded += viewShaded;
+            outsideCovered += countCoveredPixels(depthBuffer);
+            stats.viewShaded.push_back(viewShaded);
+        }
+    }
+
+    const glm::vec3 eye = (boundsMin + boundsMax) * 0.5f;
+    const float nearPlane = extent * 1e-3f;
+    const float halfResolution = resolution * 0.5f;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        int uAxis = (axis + 1) % 3;
+        int vAxis = (axis + 2) % 3;
+
+        for (float direction : {1.0f, -1.0f}) {
+            std::fill(depthBuffer.begin(), depthBuffer.end(), FLT_MAX);
+            size_t viewShaded = 0;
+
+            for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                // View space: (u, v, distance along the view axis)
+                glm::vec3 view[3];
+                for (int j = 0; j < 3; ++j) {
+                    glm::vec3 offset = vertices[indices[i + j]].position - eye;
+                    view[j] = glm::vec3(offset[uAxis], offset[vAxis], offset[axis] * direction);
+                }
+
+                // Near plane clip (Sutherland-Hodgman against distance >= nearPlane)
+                glm::vec3 polygon[4];
+                int count = 0;
+                for (int j = 0; j < 3; ++j) {
+                    const glm::vec3 &a = view[j];
+                    const glm::vec3 &b = view[(j + 1) % 3];
+                    bool aInside = a.z >= nearPlane;
+                    bool bInside = b.z >= nearPlane;
+                    if (aInside) {
+                        polygon[count++] = a;
+                    }
+                    if (aInside != bInside) {
+                        float t = (nearPlane - a.z) / (b.z - a.z);
+                        polygon[count++] = a + (b - a) * t;
+                    }
+                }
+                if (count < 3) continue;
+
+                glm::vec3 screen[4];
+                for (int j = 0; j < count; ++j) {
+                    float inverseDistance = 1.0f / polygon[j].z;
+                    screen[j] = glm::vec3(halfResolution + polygon[j].x * inverseDistance * halfResolution,
+                                          halfResolution + polygon[j].y * inverseDistance * halfResolution,
+                                          -inverseDistance);
+                }
+                for (int j = 1; j + 1 < count; ++j) {
+                    glm::vec3 p[3] = {screen[0], screen[j], screen[j + 1]};
+                    rasterOverdrawTriangle(p, depthBuffer, resolution, viewShaded);
+                }
+            }
+            insideShaded += viewShaded;
+            insideCovered += countCoveredPixels(depthBuffer);
+            stats.viewShaded.push_back(viewShaded);
+        }
+    }
+
+    stats.pixelsShaded = outsideShaded + insideShaded;
+    stats.pixelsCovered = outsideCovered + insideCovered;
+    stats.outsideOverdraw = outsideCovered ? static_cast<float>(outsideShaded) / static_cast<float>(outsideCovered) : 0.0f;
+    stats.insideOverdraw = insideCovered ? static_cast<float>(insideShaded) / static_cast<float>(insideCovered) : 0.0f;
+    // Equal weight per view set: the inside views cover far more pixels than the outside ones
+    stats.overdraw = insideCovered ? (stats.outsideOverdraw + stats.insideOverdraw) * 0.5f : stats.outsideOverdraw;
+    return stats;
+}
+
+/**
+ * Optimize Overdraw - Sorts Tipsify clusters so occluding surfaces are drawn first
+ * 
+ * FLOW:
+ * 1. Split every hard cluster (cache flush boundary from Tipsify) into soft clusters:
+ *    - Replay the cluster through a cold FIFO cache
+ *    - Cut as soon as the running ACMR is within threshold of the whole cluster's ACMR,
+ *      so shorter clusters cost at most (threshold - 1) extra vertex transforms
+ * 2. For every cluster compute its area-weighted centroid and average facing direction
+ * 3. Key = dot(cluster centroid - mesh centroid, cluster normal), two candidate orders:
+ *    - Outward (descending): clusters on the outer hull facing away from the center
+ *      occlude the rest from most orbiting view directions
+ *    - Inward (ascending): walls facing the center come first, which is front-to-back
+ *      for a camera inside a room (interior scenes)
+ * 4. Concatenate the clusters in each order (stable sorts)
+ * 5. Measure the input order once, then each distinct candidate; a candidate is only
+ *    accepted if no single view shades more fragments than the input does, and the
+ *    lowest mean overdraw among the accepted ones (or the input) wins
+ */
+std::vector<unsigned int> MeshOptimizer::optimizeOverdraw(const std::vector<unsigned int> &indices, const std::vector<Vertex> &vertices,
+                                                          const std::vector<size_t> &clusterStarts, float threshold,
+                                                          unsigned int cacheSize) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || clusterStarts.empty()) {
+        return indices;
+    }
+
+    std::vector<unsigned int> cacheTimestamps(vertices.size(), 0);
+    unsigned int timestamp = cacheSize + 1;
+
+    auto touch = [&](size_t triangle) {
+        unsigned int misses = 0;
+        for (int j = 0; j < 3; ++j) {
+            unsigned int v = indices[triangle * 3 + j];
+            if (timestamp - cacheTimestamps[v] > cacheSize) {
+                cacheTimestamps[v] = timestamp++;
+                misses++;
+            }
+        }
+        return misses;
+    };
+
+    std::vector<size_t> softStarts;
+    for (size_t c = 0; c < clusterStarts.size(); ++c) {
+        size_t start = clusterStarts[c];
+        size_t end = (c + 1 < clusterStarts.size()) ? clusterStarts[c + 1] : triangleCount;
+
+        timestamp += cacheSize + 1;
+        unsigned int clusterMisses = 0;
+        for (size_t t = start; t < end; ++t) {
+            clusterMisses += touch(t);
+        }
+        float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+        softStarts.push_back(start);
+        timestamp += cacheSize + 1;
+        unsigned int runningMisses = 0;
+        size_t runningTriangles = 0;
+        for (size_t t = start; t < end; ++t) {
+            runningMisses += touch(t);
+            runningTriangles++;
+
+            if (t + 1 < end && runningMisses <= clusterThreshold * runningTriangles) {
+                softStarts.push_back(t + 1);
+                timestamp += cacheSize + 1;
+                runningMisses = 0;
+                runningTriangles = 0;
+            }
+        }
+    }
+
+    struct ClusterInfo {
+        size_t start;
+        size_t end;
+        float sortKey;
+    };
+
+    std::vector<ClusterInfo> clusters(softStarts.size());
+    std::vector<glm::vec3> centroids(softStarts.size(), glm::vec3(0.0f));
+    std::vector<glm::vec3> normals(softStarts.size(), glm::vec3(0.0f));
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+
+    for (size_t c = 0; c < softStarts.size(); ++c) {
+        clusters[c].start = softStarts[c];
+        clusters[c].end = (c + 1 < softStarts.size()) ? softStarts[c + 1] : triangleCount;
+
+        float clusterArea = 0.0f;
+        for (size_t t = clusters[c].start; t < clusters[c].end; ++t) {
+            const glm::vec3 &p0 = vertices[indices[t * 3]].position;
+            const glm::vec3 &p1 = vertices[indices[t * 3 + 1]].position;
+            const glm::vec3 &p2 = vertices[indices[t * 3 + 2]].position;
+
+            glm::vec3 faceNormal = glm::cross(p1 - p0, p2 - p0);
+            float area = glm::length(faceNormal);
+            glm::vec3 center = (p0 + p1 + p2) / 3.0f;
+
+            centroids[c] += center * area;
+            normals[c] += faceNormal;
+            clusterArea += area;
+        }
+
+        meshCentroid += centroids[c];
+        meshArea += clusterArea;
+        if (clusterArea > 0.0f) {
+            centroids[c] /= clusterArea;
+        }
+    }
+
+    if (meshArea > 0.0f) {
+        meshCentroid /= meshArea;
+    }
+
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        float normalLength = glm::length(normals[c]);
+        glm::vec3 direction = normalLength > 0.0f ? normals[c] / normalLength : glm::vec3(0.0f);
+        clusters[c].sortKey = glm::dot(centroids[c] - meshCentroid, direction);
+    }
+
+    auto concatenate = [&](const std::vector<ClusterInfo> &order) {
+        std::vector<unsigned int> result;
+        result.reserve(triangleCount * 3);
+        for (const auto &cluster : order) {
+            result.insert(result.end(), indices.begin() + cluster.start * 3, indices.begin() + cluster.end * 3);
+        }
+        return result;
+    };
+
+    std::vector<ClusterInfo> outward = clusters;
+    std::stable_sort(outward.begin(), outward.end(), [](const ClusterInfo &a, const ClusterInfo &b) {
+        return a.sortKey > b.sortKey;
+    });
+    std::vector<ClusterInfo> inward = clusters;
+    std::stable_sort(inward.begin(), inward.end(), [](const ClusterInfo &a, const ClusterInfo &b) {
+        return a.sortKey < b.sortKey;
+    });
+
+    if (clusters.size() < 2) {
+        return indices;
+    }
+
+    // The input is measured once; each distinct candidate once more
+    const OverdrawStats input = analyzeOverdraw(indices, vertices);
+    std::vector<unsigned int> best = indices;
+    float bestOverdraw = input.overdraw;
+    std::vector<unsigned int> candidates[2] = {concatenate(outward), concatenate(inward)};
+    for (size_t c = 0; c < 2; ++c) {
+        std::vector<unsigned int> &candidate = candidates[c];
+        if (candidate == indices || (c == 1 && candidate == candidates[0])) {
+            continue;
+        }
+
+        OverdrawStats stats = analyzeOverdraw(candidate, vertices);
+        bool regresses = false;
+        for (size_t view = 0; view < stats.viewShaded.size() && view < input.viewShaded.size(); ++view) {
+            regresses = regresses || stats.viewShaded[view] > input.viewShaded[view];
+        }
+        if (!regresses && stats.overdraw < bestOverdraw) {
+            best = std::move(candidate);
+            bestOverdraw = stats.overdraw;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * Build Fetch Remap - Orders vertices by first use in the index buffer
+ *
+ * FLOW:
+ * 1. Walk the index buffer and assign consecutive new slots on first reference
+ * 2. Append vertices never referenced by a triangle (kept for point rendering)
+ * 3. Return remap table where remap[oldIndex] = newIndex
+ */
+std::vector<unsigned int> MeshOptimizer::buildFetchRemap(const std::vector<unsigned int> &indices, size_t vertexCount) {
+    const unsigned int unassigned = std::numeric_limits<unsigned int>::max();
+    std::vector<unsigned int> remap(vertexCount, unassigned);
+    unsigned int next = 0;
+
+    for (unsigned int index : indices) {
+        if (index < vertexCount && remap[index] == unassigned) {
+            remap[index] = next++;
+        }
+    }
+
+    for (size_t v = 0; v < vertexCount; ++v) {
+        if (remap[v] == unassigned) {
+            remap[v] = next++;
+        }
+    }
+
+    return remap;
+}
+
+void MeshOptimizer::remapVertices(std::vector<Vertex> &vertices, const std::vector<unsigned int> &remap) {
+    std::vector<Vertex> reordered(vertices.size());
+    for (size_t v = 0; v < vertices.size(); ++v) {
+        reordered[remap[v]] = vertices[v];
+    }
+    vertices.swap(reordered);
+}
+
+void MeshOptimizer::remapIndices(std::vector<unsigned int> &indices, const std::vector<unsigned int> &remap) {
+    for (auto &index : indices) {
+        index = remap[index];
+    }
+}
@@ -0,0 +1,338 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MeshSimplifier.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/13 09:41:52 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/13 18:05:37 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/MeshSimplifier.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Symmetric 4x4 error quadric (A, b, c) of Garland & Heckbert, accumulated with area weights.
+ * Q(p) = p^T A p + 2 b.p + c is the weighted sum of squared distances from p to the planes.
+ */
+struct Quadric {
+    float a00 = 0.0f, a11 = 0.0f, a22 = 0.0f;
+    float a01 = 0.0f, a02 = 0.0f, a12 = 0.0f;
+    float b0 = 0.0f, b1 = 0.0f, b2 = 0.0f;
+    float c = 0.0f;
+    float weight = 0.0f;
+
+    void addPlane(const glm::vec3 &normal, float distance, float planeWeight) {
+        a00 += planeWeight * normal.x * normal.x;
+        a11 += planeWeight * normal.y * normal.y;
+        a22 += planeWeight * normal.z * normal.z;
+        a01 += planeWeight * normal.x * normal.y;
+        a02 += planeWeight * normal.x * normal.z;
+        a12 += planeWeight * normal.y * normal.z;
+        b0 += planeWeight * normal.x * distance;
+        b1 += planeWeight * normal.y * distance;
+        b2 += planeWeight * normal.z * distance;
+        c += planeWeight * distance * distance;
+        weight += planeWeight;
+    }
+
+    void add(const Quadric &other) {
+        a00 += other.a00; a11 += other.a11; a22 += other.a22;
+        a01 += other.a01; a02 += other.a02; a12 += other.a12;
+        b0 += other.b0; b1 += other.b1; b2 += other.b2;
+        c += other.c;
+        weight += other.weight;
+    }
+
+    float evaluate(const glm::vec3 &p) const {
+        float result = a00 * p.x * p.x + a11 * p.y * p.y + a22 * p.z * p.z
+                     + 2.0f * (a01 * p.x * p.y + a02 * p.x * p.z + a12 * p.y * p.z)
+                     + 2.0f * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+        return std::max(result, 0.0f);
+    }
+};
+
+/**
+ * Simplify - Reduces a triangle list with quadric-error half-edge collapses
+ *
+ * FLOW:
+ * 1. Compact the referenced vertices into a local range and normalize their positions
+ *    by the bounding box, so errors are relative to the model size
+ * 2. Weld vertices by position: attribute copies of one position (UV/normal seams)
+ *    share a canonical id used for topology and quadrics
+ * 3. Lock canonical vertices that must not move:
+ *    - Seams (more than one attribute copy)
+ *    - Open borders, including material group boundaries since groups are simplified
+ *      separately, and edges with inconsistent winding
+ * 4. Accumulate area-weighted plane quadrics of every triangle on its corners
+ * 5. Repeat collapse passes until the target index count or error limit is reached:
+ *    - For every edge pick the cheaper direction whose source vertex is free;
+ *      cost = (Q_source + Q_target)(target position) / total weight
+ *    - Visit candidates by increasing cost, skipping vertices already touched this pass
+ *      and collapses that would flip (or fold beyond ~75 degrees) a surrounding triangle
+ *    - Redirect the source to the target copy found on the collapsed edge, merge quadrics
+ *    - Rewrite the index list and drop triangles that became degenerate
+ * 6. Map indices back to the original vertex buffer and report the largest error used
+ */
+std::vector<unsigned int> MeshSimplifier::simplify(const std::vector<unsigned int> &indices, const std::vector<Vertex> &vertices,
+                                                   const BoundingBox &bounds, size_t targetIndexCount, float targetError,
+                                                   float *resultError) {
+    if (resultError) {
+        *resultError = 0.0f;
+    }
+
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || triangleCount * 3 <= targetIndexCount) {
+        return indices;
+    }
+
+    std::vector<unsigned int> used(indices.begin(), indices.begin() + triangleCount * 3);
+    std::sort(used.begin(), used.end());
+    used.erase(std::unique(used.begin(), used.end()), used.end());
+    size_t vertexCount = used.size();
+
+    std::vector<unsigned int> triangles(triangleCount * 3);
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        triangles[i] = static_cast<unsigned int>(std::lower_bound(used.begin(), used.end(), indices[i]) - used.begin());
+    }
+
+    float extent = bounds.getMaxDimension();
+    if (!(extent > 0.0f)) {
+        extent = 1.0f;
+    }
+
+    std::vector<glm::vec3> positions(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        positions[v] = (vertices[used[v]].position - bounds.min) / extent;
+    }
+
+    std::vector<unsigned int> order(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        order[v] = static_cast<unsigned int>(v);
+    }
+    std::sort(order.begin(), order.end(), [&positions](unsigned int a, unsigned int b) {
+        const glm::vec3 &pa = positions[a];
+        const glm::vec3 &pb = positions[b];
+        if (pa.x != pb.x) return pa.x < pb.x;
+        if (pa.y != pb.y) return pa.y < pb.y;
+        if (pa.z != pb.z) return pa.z < pb.z;
+        return a < b;
+    });
+
+    std::vector<unsigned int> canonical(vertexCount);
+    std::vector<unsigned char> locked(vertexCount, 0);
+    for (size_t i = 0; i < vertexCount;) {
+        size_t end = i + 1;
+        while (end < vertexCount && positions[order[end]] == positions[order[i]]) {
+            end++;
+        }
+        for (size_t k = i; k < end; ++k) {
+            canonical[order[k]] = order[i];
+        }
+        if (end - i > 1) {
+            locked[order[i]] = 1;
+        }
+        i = end;
+    }
+
+    std::vector<unsigned int> adjacencyOffsets;
+    std::vector<unsigned int> adjacency;
+
+    auto buildAdjacency = [&]() {
+        size_t count = triangles.size() / 3;
+        adjacencyOffsets.assign(vertexCount + 1, 0);
+        for (size_t i = 0; i < count * 3; ++i) {
+            adjacencyOffsets[canonical[triangles[i]] + 1]++;
+        }
+        for (size_t v = 0; v < vertexCount; ++v) {
+            adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+        }
+        adjacency.assign(count * 3, 0);
+        std::vector<unsigned int> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t t = 0; t < count; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                adjacency[fill[canonical[triangles[t * 3 + k]]]++] = static_cast<unsigned int>(t);
+            }
+        }
+    };
+
+    buildAdjacency();
+
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            unsigned int a = canonical[triangles[t * 3 + k]];
+            unsigned int b = canonical[triangles[t * 3 + (k + 1) % 3]];
+            if (a == b) continue;
+
+            bool hasTwin = false;
+            for (unsigned int j = adjacencyOffsets[b]; j < adjacencyOffsets[b + 1] && !hasTwin; ++j) {
+                unsigned int other = adjacency[j];
+                for (int m = 0; m < 3; ++m) {
+                    if (canonical[triangles[other * 3 + m]] == b && canonical[triangles[other * 3 + (m + 1) % 3]] == a) {
+                        hasTwin = true;
+                        break;
+                    }
+                }
+            }
+            if (!hasTwin) {
+                locked[a] = 1;
+                locked[b] = 1;
+            }
+        }
+    }
+
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        unsigned int c0 = canonical[triangles[t * 3]];
+        unsigned int c1 = canonical[triangles[t * 3 + 1]];
+        unsigned int c2 = canonical[triangles[t * 3 + 2]];
+
+        glm::vec3 normal = glm::cross(positions[c1] - positions[c0], positions[c2] - positions[c0]);
+        float doubleArea = glm::length(normal);
+        if (!(doubleArea > 0.0f)) continue;
+
+        normal /= doubleArea;
+        float distance = -glm::dot(normal, positions[c0]);
+        float area = doubleArea * 0.5f;
+
+        quadrics[c0].addPlane(normal, distance, area);
+        quadrics[c1].addPlane(normal, distance, area);
+        quadrics[c2].addPlane(normal, distance, area);
+    }
+
+    struct Collapse {
+        unsigned int from;
+        unsigned int to;
+        float cost;
+    };
+
+    auto collapseCost = [&](unsigned int from, unsigned int to) {
+        const Quadric &qa = quadrics[from];
+        const Quadric &qb = quadrics[to];
+        float weight = qa.weight + qb.weight;
+        float error = qa.evaluate(positions[to]) + qb.evaluate(positions[to]);
+        return weight > 0.0f ? error / weight : 0.0f;
+    };
+
+    float maxCost = targetError * targetError;
+    float appliedCost = 0.0f;
+    std::vector<unsigned int> remap(vertexCount);
+    std::vector<unsigned char> touched(vertexCount);
+    std::vector<Collapse> candidates;
+
+    while (triangleCount * 3 > targetIndexCount) {
+        candidates.clear();
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                unsigned int a = triangles[t * 3 + k];
+                unsigned int b = triangles[t * 3 + (k + 1) % 3];
+                unsigned int ca = canonical[a];
+                unsigned int cb = canonical[b];
+                if (ca >= cb) continue;
+
+                Collapse best = {0, 0, -1.0f};
+                if (!locked[ca]) {
+                    best = {a, b, collapseCost(ca, cb)};
+                }
+                if (!locked[cb]) {
+                    float cost = collapseCost(cb, ca);
+                    if (best.cost < 0.0f || cost < best.cost) {
+                        best = {b, a, cost};
+                    }
+                }
+                if (best.cost >= 0.0f && best.cost <= maxCost) {
+                    candidates.push_back(best);
+                }
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const Collapse &x, const Collapse &y) {
+            return x.cost < y.cost;
+        });
+
+        for (size_t v = 0; v < vertexCount; ++v) {
+            remap[v] = static_cast<unsigned int>(v);
+        }
+        std::fill(touched.begin(), touched.end(), 0);
+
+        size_t collapses = 0;
+        size_t remainingTriangles = triangleCount;
+
+        for (const auto &candidate : candidates) {
+            if (remainingTriangles * 3 <= targetIndexCount) break;
+
+            unsigned int from = canonical[candidate.from];
+            unsigned int to = canonical[candidate.to];
+            if (touched[from] || touched[to]) continue;
+
+            bool rejected = false;
+            size_t removed = 0;
+            for (unsigned int j = adjacencyOffsets[from]; j < adjacencyOffsets[from + 1]; ++j) {
+                unsigned int t = adjacency[j];
+                int corner = 0;
+                while (corner < 2 && canonical[triangles[t * 3 + corner]] != from) {
+                    corner++;
+                }
+                unsigned int x = canonical[triangles[t * 3 + (corner + 1) % 3]];
+                unsigned int y = canonical[triangles[t * 3 + (corner + 2) % 3]];
+                if (x == to || y == to) {
+                    removed++;
+                    continue;
+                }
+
+                glm::vec3 before = glm::cross(positions[x] - positions[from], positions[y] - positions[from]);
+                glm::vec3 after = glm::cross(positions[x] - positions[to], positions[y] - positions[to]);
+                if (glm::dot(before, after) < 0.25f * glm::length(before) * glm::length(after)) {
+                    rejected = true;
+                    break;
+                }
+            }
+            if (rejected) continue;
+
+            remap[candidate.from] = candidate.to;
+            quadrics[to].add(quadrics[from]);
+            for (unsigned int j = adjacencyOffsets[from]; j < adjacencyOffsets[from + 1]; ++j) {
+                unsigned int t = adjacency[j];
+                for (int k = 0; k < 3; ++k) {
+                    touched[canonical[triangles[t * 3 + k]]] = 1;
+                }
+            }
+
+            appliedCost = std::max(appliedCost, candidate.cost);
+            remainingTriangles -= std::min(removed, remainingTriangles);
+            collapses++;
+        }
+
+        if (collapses == 0) break;
+
+        size_t write = 0;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            unsigned int a = remap[triangles[t * 3]];
+            unsigned int b = remap[triangles[t * 3 + 1]];
+            unsigned int c = remap[triangles[t * 3 + 2]];
+            if (canonical[a] == canonical[b] || canonical[b] == canonical[c] || canonical[a] == canonical[c]) continue;
+
+            triangles[write * 3] = a;
+            triangles[write * 3 + 1] = b;
+            triangles[write * 3 + 2] = c;
+            write++;
+        }
+        triangleCount = write;
+        triangles.resize(triangleCount * 3);
+
+        buildAdjacency();
+    }
+
+    std::vector<unsigned int> result(triangleCount * 3);
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = used[triangles[i]];
+    }
+
+    if (resultError) {
+        *resultError = std::sqrt(appliedCost);
+    }
+    return result;
+}
@@ -21,6 +21,14 @@
 #include <glm/glm.hpp>
 
 #include "../../include/Parser.hpp"
+#include "../../include/MeshOptimizer.hpp"
+#include "../../include/MeshSimplifier.hpp"
+#include <thread>
+#include <atomic>
+
+// Each LOD targets half the triangles of the previous one, never beyond 5% of the model size
+#define LOD_REDUCTION 0.5f
+#define LOD_MAX_ERROR 0.05f
 
 Parser::Parser() {}
 
@@ -543,6 +551,10 @@ const std::vector<MaterialGroup> &Parser::getMaterialGroups() const {
 	return _materialGroups;
 }
 
+const std::vector<MeshLOD> &Parser::getLODs() const {
+	return _lods;
+}
+
 int Parser::getMaterialIndex(const std::string& name) const {
 	for (size_t i = 0; i < _materials.size(); ++i) {
 		if (_materials[i].name == name) {
@@ -609,6 +621,171 @@ void Parser::calculateNormals() {
     }
 }
 
+/**
+ * Optimize Mesh - Reorders triangles and vertices for the GPU post-transform cache
+ * 
+ * FLOW:
+ * 1. Skip FDF maps (line lists, nothing to gain) and empty meshes
+ * 2. Measure ACMR/ATVR of the file-order index buffer
+ * 3. Reorder each material group's triangles with Tipsify:
+ *    - With reduceOverdraw, additionally sort the Tipsify clusters front-to-back-friendly
+ *      (outer hulls first, or inward-facing walls first for interiors)
+ *    - If the groups cover every triangle, rebuild the main index buffer from them
+ *      so both draw paths share the optimized order
+ *    - Otherwise reorder the main index buffer on its own as well
+ * 4. Reorder vertices by first use and remap every index list (and the face map)
+ * 5. Report cache (and overdraw) statistics before and after the pass
+ */
+void Parser::optimize(bool reduceOverdraw) {
+    if (_mode != OBJ || _indices.size() < 3) {
+        return;
+    }
+
+    VertexCacheStats before = MeshOptimizer::analyzeVertexCache(_indices, _vertices.size());
+    OverdrawStats overdrawBefore;
+    if (reduceOverdraw) {
+        overdrawBefore = MeshOptimizer::analyzeOverdraw(_indices, _vertices);
+    }
+
+    auto reorder = [this, reduceOverdraw](const std::vector<unsigned int>& indices) {
+        std::vector<size_t> clusters;
+        std::vector<unsigned int> ordered = MeshOptimizer::optimizeVertexCache(indices, _vertices.size(),
+                                                                              MeshOptimizer::CACHE_SIZE, &clusters);
+        if (reduceOverdraw) {
+            ordered = MeshOptimizer::optimizeOverdraw(ordered, _vertices, clusters);
+        }
+        return ordered;
+    };
+
+    size_t groupedIndexCount = 0;
+    for (auto& group : _materialGroups) {
+        groupedIndexCount += group.indices.size();
+        group.indices = reorder(group.indices);
+    }
+
+    if (!_materialGroups.empty() && groupedIndexCount == _indices.size()) {
+        _indices.clear();
+        for (const auto& group : _materialGroups) {
+            _indices.insert(_indices.end(), group.indices.begin(), group.indices.end());
+        }
+    } else {
+        _indices = reorder(_indices);
+    }
+
+    std::vector<unsigned int> remap = MeshOptimizer::buildFetchRemap(_indices, _vertices.size());
+    MeshOptimizer::remapVertices(_vertices, remap);
+    MeshOptimizer::remapIndices(_indices, remap);
+    for (auto& group : _materialGroups) {
+        MeshOptimizer::remapIndices(group.indices, remap);
+    }
+    for (auto& entry : _faceMap) {
+        entry.second = remap[entry.second];
+    }
+
+    VertexCacheStats after = MeshOptimizer::analyzeVertexCache(_indices, _vertices.size());
+
+    std::cout << "Vertex cache optimization (FIFO " << MeshOptimizer::CACHE_SIZE << "):" << std::endl;
+    std::cout << "  ACMR: " << before.acmr << " -> " << after.acmr << std::endl;
+    std::cout << "  ATVR: " << before.atvr << " -> " << after.atvr << std::endl;
+
+    if (reduceOverdraw) {
+        OverdrawStats overdrawAfter = MeshOptimizer::analyzeOverdraw(_indices, _vertices);
+        std::cout << "  Overdraw: " << overdrawBefore.overdraw << " -> " << overdrawAfter.overdraw
+                  << " (outside views " << overdrawBefore.outsideOverdraw << " -> " << overdrawAfter.outsideOverdraw
+                  << ", inside views " << overdrawBefore.insideOverdraw << " -> " << overdrawAfter.insideOverdraw << ")" << std::endl;
+    }
+}
+
+/**
+ * Generate LODs - Builds a chain of simplified index buffers sharing the vertex buffer
+ * 
+ * FLOW:
+ * 1. Skip FDF maps (line lists) and empty meshes
+ * 2. Split the work per material group when the groups cover every triangle,
+ *    otherwise simplify the full index buffer as a single unit
+ * 3. For each level, simplify every unit of the previous level to LOD_REDUCTION of its size:
+ *    - Units run in parallel on a small worker pool (one unit per job)
+ *    - Group borders and UV/normal seams are locked, so groups stay stitched together
+ *    - The result is reordered with Tipsify for the vertex cache
+ *    - The level error accumulates the per-step errors of the chain
+ * 4. Stop when a level no longer removes at least 10% of the triangles
+ * 5. Report triangle counts and errors of every level
+ */
+void Parser::generateLODs(size_t maxLevels) {
+    _lods.clear();
+    if (_mode != OBJ || _indices.size() < 3) {
+        return;
+    }
+
+    size_t groupedIndexCount = 0;
+    for (const auto& group : _materialGroups) {
+        groupedIndexCount += group.indices.size();
+    }
+    bool perGroup = !_materialGroups.empty() && groupedIndexCount == _indices.size();
+
+    std::vector<std::vector<unsigned int>> units;
+    if (perGroup) {
+        for (const auto& group : _materialGroups) {
+            units.push_back(group.indices);
+        }
+    } else {
+        units.push_back(_indices);
+    }
+
+    size_t workerCount = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), units.size()));
+    size_t previousCount = _indices.size();
+    float previousError = 0.0f;
+
+    for (size_t level = 1; level <= maxLevels; ++level) {
+        std::vector<std::vector<unsigned int>> simplified(units.size());
+        std::vector<float> errors(units.size(), 0.0f);
+        std::atomic<size_t> nextUnit(0);
+
+        auto worker = [&]() {
+            for (size_t u = nextUnit++; u < units.size(); u = nextUnit++) {
+                size_t target = static_cast<size_t>(units[u].size() / 3 * LOD_REDUCTION) * 3;
+                simplified[u] = MeshSimplifier::simplify(units[u], _vertices, _boundingBox, target, LOD_MAX_ERROR, &errors[u]);
+                simplified[u] = MeshOptimizer::optimizeVertexCache(simplified[u], _vertices.size());
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t w = 1; w < workerCount; ++w) {
+            workers.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : workers) {
+            thread.join();
+        }
+
+        MeshLOD lod;
+        for (size_t u = 0; u < units.size(); ++u) {
+            lod.indices.insert(lod.indices.end(), simplified[u].begin(), simplified[u].end());
+            lod.error = std::max(lod.error, previousError + errors[u]);
+        }
+
+        if (lod.indices.empty() || lod.indices.size() > previousCount * 9 / 10) {
+            break;
+        }
+
+        if (perGroup) {
+            lod.groupIndices = simplified;
+        }
+
+        previousCount = lod.indices.size();
+        previousError = lod.error;
+        units = std::move(simplified);
+        _lods.push_back(std::move(lod));
+    }
+
+    std::cout << "LOD chain (" << workerCount << " worker" << (workerCount > 1 ? "s" : "") << "):" << std::endl;
+    std::cout << "  LOD0: " << _indices.size() / 3 << " triangles" << std::endl;
+    for (size_t level = 0; level < _lods.size(); ++level) {
+        std::cout << "  LOD" << level + 1 << ": " << _lods[level].indices.size() / 3 << " triangles, error "
+                  << _lods[level].error * 100.0f << "%" << std::endl;
+    }
+}
+
 void Parser::updateMinMaxZ(float newZ) {
     if (newZ > _maxZ) {
         _maxZ = newZ;
@@ -0,0 +1,315 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FrameCapture.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/24 10:27:40 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/24 17:06:12 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/FrameCapture.hpp"
+#include "../../include/GLState.hpp"
+#include "../../include/ErrorManager.hpp"
+#include "../../include/PngWriter.hpp"
+#include <filesystem>
+#include <algorithm>
+#include <iostream>
+#include <chrono>
+#include <ctime>
+#include <cstring>
+#include <cstdio>
+
+namespace {
+    const GLuint64 FLUSH_TIMEOUT_NS = 1000000000ull;
+}
+
+FrameCapture::FrameCapture(const std::string &directory, size_t workers)
+    : _next(0), _inFlight(0), _directory(directory), _encoding(0), _stopping(false),
+      _written(0), _failed(0), _captured(0), _dropped(0) {
+    for (size_t i = 0; i < std::max<size_t>(workers, 1); ++i) {
+        _workers.emplace_back(&FrameCapture::workerLoop, this);
+    }
+}
+
+/**
+ * FrameCapture Destructor - Finishes every capture, then stops the workers
+ *
+ * Needs the GL context still current: readbacks in flight are waited for and saved
+ * rather than lost, and the pixel buffers are deleted.
+ */
+FrameCapture::~FrameCapture() {
+    flush();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _jobReady.notify_all();
+    for (std::thread &worker : _workers) {
+        worker.join();
+    }
+
+    for (Slot &slot : _slots) {
+        if (slot.buffer) {
+            GLState::deleteBuffer(slot.buffer);
+        }
+    }
+}
+
+/**
+ * Timestamp - Local date and time down to milliseconds, for capture file names
+ */
+std::string FrameCapture::timestamp() {
+    auto now = std::chrono::system_clock::now();
+    std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+    int millis = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000);
+
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", std::localtime(&seconds));
+    char result[40];
+    std::snprintf(result, sizeof(result), "%s_%03d", stamp, millis);
+    return result;
+}
+
+std::string FrameCapture::nextPath() const {
+    return (std::filesystem::path(_directory) / ("scop_" + timestamp() + ".png")).string();
+}
+
+/**
+ * Request Screenshot - Queues a capture of the next composited frame
+ *
+ * An empty path picks a timestamped file in the capture directory.
+ */
+void FrameCapture::requestScreenshot(const std::string &path) {
+    _requests.push_back(path.empty() ? nextPath() : path);
+}
+
+void FrameCapture::captureRequested(unsigned int framebuffer, int x, int y, int width, int height) {
+    for (const std::string &path : _requests) {
+        capture(framebuffer, x, y, width, height, path);
+    }
+    _requests.clear();
+}
+
+/**
+ * Capture - Queues an asynchronous readback of a framebuffer region
+ *
+ * FLOW:
+ * 1. All ring slots still in flight: drop the capture (returning false) rather than
+ *    wait; hasFreeSlot() lets callers that must not drop frames flush first
+ * 2. Grow the slot's pixel pack buffer if the region got bigger (GL_STREAM_READ:
+ *    written by the GPU, read once by the CPU)
+ * 3. glReadPixels with a pack buffer bound only queues the copy and returns immediately;
+ *    RGBA8 is the layout drivers copy without conversion
+ * 4. Fence after the copy, so update() can tell when mapping will not block
+ */
+bool FrameCapture::capture(unsigned int framebuffer, int x, int y, int width, int height, const std::string &path) {
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+    if (!hasFreeSlot()) {
+        _dropped++;
+        std::cerr << "Warning: capture ring full, dropped " << path << std::endl;
+        return false;
+    }
+
+    Slot &slot = _slots[(_next + _inFlight) % RING_SIZE];
+    size_t bytes = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+
+    if (!slot.buffer) {
+        GLCall(glGenBuffers(1, &slot.buffer));
+    }
+    GLState::bindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    if (slot.capacity < bytes) {
+        GLCall(glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_READ));
+        slot.capacity = bytes;
+    }
+
+    GLState::bindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    GLCall(glPixelStorei(GL_PACK_ALIGNMENT, 4));
+    GLCall(glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    GLState::bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.width = width;
+    slot.height = height;
+    slot.path = path;
+
+    _inFlight++;
+    _captured++;
+    return true;
+}
+
+/**
+ * Harvest - Maps a finished readback and hands its pixels to the encoders
+ *
+ * FLOW:
+ * 1. Poll the fence (timeout 0, never blocks) unless waiting was asked for; the flush
+ *    bit makes sure the fence is submitted, otherwise it could wait forever
+ * 2. Map the buffer and copy the pixels out, so the slot can be reused at once; the
+ *    copy is a memcpy from memory the driver already holds, not a GPU sync
+ * 3. Queue the encode job and wake a worker
+ */
+bool FrameCapture::harvest(Slot &slot, bool wait) {
+    GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? FLUSH_TIMEOUT_NS : 0);
+    if (status == GL_TIMEOUT_EXPIRED && !wait) {
+        return false;
+    }
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+
+    if (status == GL_WAIT_FAILED || status == GL_TIMEOUT_EXPIRED) {
+        std::cerr << "Warning: capture readback did not complete, skipped " << slot.path << std::endl;
+        _failed++;
+        return true;
+    }
+
+    Job job;
+    job.width = slot.width;
+    job.height = slot.height;
+    job.path = slot.path;
+    size_t bytes = static_cast<size_t>(slot.width) * static_cast<size_t>(slot.height) * 4;
+
+    GLState::bindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    const void *mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes), GL_MAP_READ_BIT);
+    if (mapped) {
+        job.pixels.resize(bytes);
+        std::memcpy(job.pixels.data(), mapped, bytes);
+        GLCall(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+    }
+    GLState::bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (!mapped) {
+        std::cerr << "Warning: failed to map capture buffer, skipped " << slot.path << std::endl;
+        _failed++;
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.push_back(std::move(job));
+    }
+    _jobReady.notify_one();
+    return true;
+}
+
+bool FrameCapture::harvestOldest(bool wait) {
+    if (_inFlight == 0 || !harvest(_slots[_next], wait)) {
+        return false;
+    }
+    _next = (_next + 1) % RING_SIZE;
+    _inFlight--;
+    return true;
+}
+
+/**
+ * Update - Moves every finished readback to the encoders, oldest first
+ *
+ * Called once per loop iteration. Fences signal in submission order, so the first slot
+ * still pending ends the scan.
+ */
+void FrameCapture::update() {
+    while (harvestOldest(false)) {
+    }
+}
+
+/**
+ * Wait For Slot - Blocks until the next capture can be taken without dropping it
+ *
+ * FLOW:
+ * 1. Ring full: wait for the oldest readback, i.e. for the GPU to catch up
+ * 2. More than maxQueuedJobs frames waiting for an encoder: wait for the encoders,
+ *    which bounds the memory held by a long recording to a few frames
+ *
+ * For recordings, where every frame must be kept and the loop should run as fast as the
+ * slower of the GPU and the encoders rather than drop frames.
+ */
+void FrameCapture::waitForSlot(size_t maxQueuedJobs) {
+    if (!hasFreeSlot()) {
+        harvestOldest(true);
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _jobDone.wait(lock, [this, maxQueuedJobs] { return _jobs.size() < std::max<size_t>(maxQueuedJobs, 1); });
+}
+
+/**
+ * Flush - Blocks until every capture is read back and written
+ */
+void FrameCapture::flush() {
+    while (harvestOldest(true)) {
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _jobDone.wait(lock, [this] { return _jobs.empty() && _encoding == 0; });
+}
+
+/**
+ * Worker Loop - Encodes queued frames until the capture is destroyed
+ *
+ * FLOW:
+ * 1. Sleep until a job arrives (or shutdown with an empty queue)
+ * 2. Drop the alpha channel (the backbuffer's alpha is not meaningful) in place
+ * 3. Encode bottom-up rows as a top-down PNG and write it, creating the directory
+ */
+void FrameCapture::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _jobReady.wait(lock, [this] { return _stopping || !_jobs.empty(); });
+            if (_jobs.empty()) {
+                return;
+            }
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+            _encoding++;
+        }
+
+        size_t pixelCount = static_cast<size_t>(job.width) * static_cast<size_t>(job.height);
+        for (size_t i = 0; i < pixelCount; ++i) {
+            job.pixels[i * 3 + 0] = job.pixels[i * 4 + 0];
+            job.pixels[i * 3 + 1] = job.pixels[i * 4 + 1];
+            job.pixels[i * 3 + 2] = job.pixels[i * 4 + 2];
+        }
+
+        std::error_code error;
+        std::filesystem::path parent = std::filesystem::path(job.path).parent_path();
+        if (!parent.empty()) {
+            std::filesystem::create_directories(parent, error);
+        }
+
+        bool written = PngWriter::write(job.path, job.pixels.data(), job.width, job.height, 3, true);
+        if (written) {
+            _written++;
+        } else {
+            _failed++;
+            std::cerr << "Warning: failed to write capture " << job.path << std::endl;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _encoding--;
+            if (written) {
+                _lastPath = job.path;
+            }
+        }
+        _jobDone.notify_all();
+    }
+}
+
+FrameCaptureStats FrameCapture::getStats() {
+    FrameCaptureStats stats;
+    stats.captured = _captured;
+    stats.written = _written;
+    stats.failed = _failed;
+    stats.dropped = _dropped;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    stats.pending = _inFlight + _jobs.size() + _encoding;
+    stats.lastPath = _lastPath;
+    return stats;
+}
@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   GLExtensions.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/18 09:33:26 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/18 15:12:58 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/GLExtensions.hpp"
+#include <iostream>
+
+bool GLExtensions::programBinary = false;
+bool GLExtensions::parallelShaderCompile = false;
+bool GLExtensions::debugOutput = false;
+
+PFNSCOPGETPROGRAMBINARYPROC GLExtensions::getProgramBinary = nullptr;
+PFNSCOPPROGRAMBINARYPROC GLExtensions::programBinaryLoad = nullptr;
+PFNSCOPPROGRAMPARAMETERIPROC GLExtensions::programParameteri = nullptr;
+PFNSCOPMAXSHADERCOMPILERTHREADSPROC GLExtensions::maxShaderCompilerThreads = nullptr;
+PFNSCOPDEBUGMESSAGECALLBACKPROC GLExtensions::debugMessageCallback = nullptr;
+PFNSCOPDEBUGMESSAGECONTROLPROC GLExtensions::debugMessageControl = nullptr;
+PFNSCOPPUSHDEBUGGROUPPROC GLExtensions::pushDebugGroup = nullptr;
+PFNSCOPPOPDEBUGGROUPPROC GLExtensions::popDebugGroup = nullptr;
+
+bool GLExtensions::versionAtLeast(int major, int minor) {
+    return GLVersion.major > major || (GLVersion.major == major && GLVersion.minor >= minor);
+}
+
+bool GLExtensions::has(const std::string &extension) {
+    int count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (int i = 0; i < count; ++i) {
+        const char *name = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        if (name && extension == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Load Extensions - Detects optional features and loads their entry points
+ * 
+ * FLOW:
+ * 1. Program binaries: core since 4.1, otherwise ARB_get_program_binary; a driver that
+ *    reports zero binary formats cannot actually save programs, so it counts as absent
+ * 2. Parallel shader compilation: KHR_ or ARB_parallel_shader_compile; when present,
+ *    let the driver use as many compiler threads as it wants
+ * 3. Debug output: core since 4.3, otherwise KHR_debug (whose desktop entry points
+ *    carry no suffix); only detected here, ErrorManager decides whether to enable it
+ * 4. A feature only counts as available if every entry point it needs was resolved
+ */
+void GLExtensions::load(GLADloadproc loader) {
+    if (versionAtLeast(4, 1) || has("GL_ARB_get_program_binary")) {
+        getProgramBinary = reinterpret_cast<PFNSCOPGETPROGRAMBINARYPROC>(loader("glGetProgramBinary"));
+        programBinaryLoad = reinterpret_cast<PFNSCOPPROGRAMBINARYPROC>(loader("glProgramBinary"));
+        programParameteri = reinterpret_cast<PFNSCOPPROGRAMPARAMETERIPROC>(loader("glProgramParameteri"));
+
+        int formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        programBinary = getProgramBinary && programBinaryLoad && programParameteri && formats > 0;
+    }
+
+    if (has("GL_KHR_parallel_shader_compile")) {
+        maxShaderCompilerThreads = reinterpret_cast<PFNSCOPMAXSHADERCOMPILERTHREADSPROC>(loader("glMaxShaderCompilerThreadsKHR"));
+    } else if (has("GL_ARB_parallel_shader_compile")) {
+        maxShaderCompilerThreads = reinterpret_cast<PFNSCOPMAXSHADERCOMPILERTHREADSPROC>(loader("glMaxShaderCompilerThreadsARB"));
+    }
+    parallelShaderCompile = maxShaderCompilerThreads != nullptr;
+    if (parallelShaderCompile) {
+        maxShaderCompilerThreads(0xFFFFFFFFu);
+    }
+
+    if (versionAtLeast(4, 3) || has("GL_KHR_debug")) {
+        debugMessageCallback = reinterpret_cast<PFNSCOPDEBUGMESSAGECALLBACKPROC>(loader("glDebugMessageCallback"));
+        debugMessageControl = reinterpret_cast<PFNSCOPDEBUGMESSAGECONTROLPROC>(loader("glDebugMessageControl"));
+        pushDebugGroup = reinterpret_cast<PFNSCOPPUSHDEBUGGROUPPROC>(loader("glPushDebugGroup"));
+        popDebugGroup = reinterpret_cast<PFNSCOPPOPDEBUGGROUPPROC>(loader("glPopDebugGroup"));
+        debugOutput = debugMessageCallback && debugMessageControl && pushDebugGroup && popDebugGroup;
+    }
+
+    std::cout << "GL extensions: program binary " << (programBinary ? "yes" : "no")
+              << ", parallel shader compile " << (parallelShaderCompile ? "yes" : "no")
+              << ", debug output " << (debugOutput ? "yes" : "no") << std::endl;
+}
@@ -0,0 +1,358 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   GLState.cpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/15 09:20:34 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/15 13:58:02 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/GLState.hpp"
+#include "../../include/ErrorManager.hpp"
+
+// Everything starts unknown: the first request for each piece of state always reaches GL
+unsigned int GLState::_program = GLState::UNKNOWN;
+unsigned int GLState::_vertexArray = GLState::UNKNOWN;
+std::unordered_map<unsigned int, unsigned int> GLState::_buffers;
+std::unordered_map<unsigned int, unsigned int> GLState::_elementBuffers;
+unsigned int GLState::_drawFramebuffer = GLState::UNKNOWN;
+unsigned int GLState::_readFramebuffer = GLState::UNKNOWN;
+unsigned int GLState::_renderbuffer = GLState::UNKNOWN;
+unsigned int GLState::_activeTexture = GLState::UNKNOWN;
+std::unordered_map<unsigned int, unsigned int> GLState::_textures;
+std::unordered_map<unsigned int, bool> GLState::_capabilities;
+unsigned int GLState::_depthFunc = GLState::UNKNOWN;
+int GLState::_depthMask = -1;
+float GLState::_lineWidth = -1.0f;
+float GLState::_pointSize = -1.0f;
+int GLState::_viewport[4] = { 0, 0, -1, -1 };
+int GLState::_scissor[4] = { 0, 0, -1, -1 };
+float GLState::_clearColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+bool GLState::_clearColorKnown = false;
+
+GLStateStats GLState::_frameStats;
+
+const GLStateStats &GLState::getFrameStats() {
+    return _frameStats;
+}
+
+void GLState::resetFrameStats() {
+    _frameStats = GLStateStats();
+}
+
+/**
+ * Changed - Counts one state request and tells the caller whether to issue it
+ */
+bool GLState::changed(bool differs) {
+    if (differs) {
+        _frameStats.issued++;
+    } else {
+        _frameStats.elided++;
+    }
+    return differs;
+}
+
+void GLState::useProgram(unsigned int program) {
+    if (changed(_program != program)) {
+        GLCall(glUseProgram(program));
+        _program = program;
+    }
+}
+
+/**
+ * Bind Vertex Array - Binds a VAO, which also switches the element buffer binding
+ * 
+ * FLOW:
+ * 1. Skip if the VAO is already bound
+ * 2. GL_ELEMENT_ARRAY_BUFFER is part of VAO state, so its cache is kept per VAO
+ *    (see bindBuffer) and switching VAOs needs no extra bookkeeping
+ */
+void GLState::bindVertexArray(unsigned int vertexArray) {
+    if (changed(_vertexArray != vertexArray)) {
+        GLCall(glBindVertexArray(vertexArray));
+        _vertexArray = vertexArray;
+    }
+}
+
+/**
+ * Bind Buffer - Binds a buffer to a target, tracking index buffers per VAO
+ * 
+ * FLOW:
+ * 1. GL_ELEMENT_ARRAY_BUFFER: look up the binding recorded for the current VAO;
+ *    with an unknown VAO nothing can be assumed and the call always goes through
+ * 2. Any other target: compare against the context-wide binding of that target
+ * 3. Issue the bind and record it when it differs
+ */
+void GLState::bindBuffer(unsigned int target, unsigned int buffer) {
+    if (target == GL_ELEMENT_ARRAY_BUFFER) {
+        bool known = _vertexArray != UNKNOWN;
+        auto it = _elementBuffers.find(_vertexArray);
+        if (changed(!known || it == _elementBuffers.end() || it->second != buffer)) {
+            GLCall(glBindBuffer(target, buffer));
+            if (known) {
+                _elementBuffers[_vertexArray] = buffer;
+            }
+        }
+        return;
+    }
+
+    auto it = _buffers.find(target);
+    if (changed(it == _buffers.end() || it->second != buffer)) {
+        GLCall(glBindBuffer(target, buffer));
+        _buffers[target] = buffer;
+    }
+}
+
+/**
+ * Bind Buffer Base - Attaches a buffer to an indexed binding point
+ * 
+ * Indexed bindings are set once at creation and not cached, but glBindBufferBase also
+ * replaces the generic binding of the target, which is recorded here.
+ */
+void GLState::bindBufferBase(unsigned int target, unsigned int index, unsigned int buffer) {
+    _frameStats.issued++;
+    GLCall(glBindBufferBase(target, index, buffer));
+    _buffers[target] = buffer;
+}
+
+/**
+ * Bind Framebuffer - Binds draw and/or read framebuffers
+ * 
+ * GL_FRAMEBUFFER sets both bindings at once and is only elided when both already match.
+ */
+void GLState::bindFramebuffer(unsigned int target, unsigned int framebuffer) {
+    bool draw = target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER;
+    bool read = target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER;
+
+    if (changed((draw && _drawFramebuffer != framebuffer) || (read && _readFramebuffer != framebuffer))) {
+        GLCall(glBindFramebuffer(target, framebuffer));
+        if (draw) {
+            _drawFramebuffer = framebuffer;
+        }
+        if (read) {
+            _readFramebuffer = framebuffer;
+        }
+    }
+}
+
+void GLState::bindRenderbuffer(unsigned int renderbuffer) {
+    if (changed(_renderbuffer != renderbuffer)) {
+        GLCall(glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer));
+        _renderbuffer = renderbuffer;
+    }
+}
+
+void GLState::activeTexture(unsigned int unit) {
+    if (changed(_activeTexture != unit)) {
+        GLCall(glActiveTexture(unit));
+        _activeTexture = unit;
+    }
+}
+
+/**
+ * Bind Texture - Binds a texture on the active unit
+ * 
+ * FLOW:
+ * 1. Only GL_TEXTURE_2D is cached (per texture unit); other targets always go through
+ * 2. With an unknown active unit nothing can be assumed and the bind is issued
+ */
+void GLState::bindTexture(unsigned int target, unsigned int texture) {
+    if (target != GL_TEXTURE_2D || _activeTexture == UNKNOWN) {
+        changed(true);
+        GLCall(glBindTexture(target, texture));
+        return;
+    }
+
+    auto it = _textures.find(_activeTexture);
+    if (changed(it == _textures.end() || it->second != texture)) {
+        GLCall(glBindTexture(target, texture));
+        _textures[_activeTexture] = texture;
+    }
+}
+
+void GLState::enable(unsigned int capability) {
+    auto it = _capabilities.find(capability);
+    if (changed(it == _capabilities.end() || !it->second)) {
+        GLCall(glEnable(capability));
+        _capabilities[capability] = true;
+    }
+}
+
+void GLState::disable(unsigned int capability) {
+    auto it = _capabilities.find(capability);
+    if (changed(it == _capabilities.end() || it->second)) {
+        GLCall(glDisable(capability));
+        _capabilities[capability] = false;
+    }
+}
+
+/**
+ * Is Enabled - Answers from the cache, querying GL only for capabilities never set
+ */
+bool GLState::isEnabled(unsigned int capability) {
+    auto it = _capabilities.find(capability);
+    if (it != _capabilities.end()) {
+        return it->second;
+    }
+
+    bool enabled = glIsEnabled(capability) == GL_TRUE;
+    _capabilities[capability] = enabled;
+    return enabled;
+}
+
+void GLState::depthFunc(unsigned int func) {
+    if (changed(_depthFunc != func)) {
+        GLCall(glDepthFunc(func));
+        _depthFunc = func;
+    }
+}
+
+void GLState::depthMask(bool write) {
+    if (changed(_depthMask != static_cast<int>(write))) {
+        GLCall(glDepthMask(write ? GL_TRUE : GL_FALSE));
+        _depthMask = static_cast<int>(write);
+    }
+}
+
+void GLState::lineWidth(float width) {
+    if (changed(_lineWidth != width)) {
+        GLCall(glLineWidth(width));
+        _lineWidth = width;
+    }
+}
+
+void GLState::pointSize(float size) {
+    if (changed(_pointSize != size)) {
+        GLCall(glPointSize(size));
+        _pointSize = size;
+    }
+}
+
+void GLState::viewport(int x, int y, int width, int height) {
+    if (changed(_viewport[0] != x || _viewport[1] != y || _viewport[2] != width || _viewport[3] != height)) {
+        GLCall(glViewport(x, y, width, height));
+        _viewport[0] = x;
+        _viewport[1] = y;
+        _viewport[2] = width;
+        _viewport[3] = height;
+    }
+}
+
+void GLState::scissor(int x, int y, int width, int height) {
+    if (changed(_scissor[0] != x || _scissor[1] != y || _scissor[2] != width || _scissor[3] != height)) {
+        GLCall(glScissor(x, y, width, height));
+        _scissor[0] = x;
+        _scissor[1] = y;
+        _scissor[2] = width;
+        _scissor[3] = height;
+    }
+}
+
+void GLState::clearColor(float r, float g, float b, float a) {
+    if (changed(!_clearColorKnown || _clearColor[0] != r || _clearColor[1] != g || _clearColor[2] != b || _clearColor[3] != a)) {
+        GLCall(glClearColor(r, g, b, a));
+        _clearColor[0] = r;
+        _clearColor[1] = g;
+        _clearColor[2] = b;
+        _clearColor[3] = a;
+        _clearColorKnown = true;
+    }
+}
+
+/**
+ * Delete Program - Deletes a program and forgets it as the current one
+ * 
+ * A program deleted while in use stays current until replaced, but its name may be
+ * handed out again afterwards, so the cache treats the binding as unknown.
+ */
+void GLState::deleteProgram(unsigned int program) {
+    if (_program == program) {
+        _program = UNKNOWN;
+    }
+    glDeleteProgram(program);
+}
+
+/**
+ * Delete Vertex Array - Deletes a VAO along with its recorded index buffer binding
+ */
+void GLState::deleteVertexArray(unsigned int vertexArray) {
+    if (_vertexArray == vertexArray) {
+        _vertexArray = 0;
+    }
+    _elementBuffers.erase(vertexArray);
+    glDeleteVertexArrays(1, &vertexArray);
+}
+
+/**
+ * Delete Buffer - Deletes a buffer; GL resets every binding of it to 0, and so does the cache
+ */
+void GLState::deleteBuffer(unsigned int buffer) {
+    for (auto &binding : _buffers) {
+        if (binding.second == buffer) {
+            binding.second = 0;
+        }
+    }
+    for (auto &binding : _elementBuffers) {
+        if (binding.second == buffer) {
+            binding.second = 0;
+        }
+    }
+    glDeleteBuffers(1, &buffer);
+}
+
+void GLState::deleteTexture(unsigned int texture) {
+    for (auto &binding : _textures) {
+        if (binding.second == texture) {
+            binding.second = 0;
+        }
+    }
+    glDeleteTextures(1, &texture);
+}
+
+void GLState::deleteFramebuffer(unsigned int framebuffer) {
+    if (_drawFramebuffer == framebuffer) {
+        _drawFramebuffer = 0;
+    }
+    if (_readFramebuffer == framebuffer) {
+        _readFramebuffer = 0;
+    }
+    glDeleteFramebuffers(1, &framebuffer);
+}
+
+void GLState::deleteRenderbuffer(unsigned int renderbuffer) {
+    if (_renderbuffer == renderbuffer) {
+        _renderbuffer = 0;
+    }
+    glDeleteRenderbuffers(1, &renderbuffer);
+}
+
+/**
+ * Invalidate - Forgets everything, so the next request for each piece of state is issued
+ * 
+ * Needed after any code that changes GL state without going through GLState and
+ * without restoring it (or after a context change).
+ */
+void GLState::invalidate() {
+    _program = UNKNOWN;
+    _vertexArray = UNKNOWN;
+    _buffers.clear();
+    _elementBuffers.clear();
+    _drawFramebuffer = UNKNOWN;
+    _readFramebuffer = UNKNOWN;
+    _renderbuffer = UNKNOWN;
+    _activeTexture = UNKNOWN;
+    _textures.clear();
+    _capabilities.clear();
+    _depthFunc = UNKNOWN;
+    _depthMask = -1;
+    _lineWidth = -1.0f;
+    _pointSize = -1.0f;
+    _viewport[2] = -1;
+    _viewport[3] = -1;
+    _scissor[2] = -1;
+    _scissor[3] = -1;
+    _clearColorKnown = false;
+}
@@ -0,0 +1,144 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   GpuTimer.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/21 09:20:49 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/21 15:58:57 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/GpuTimer.hpp"
+#include "../../include/ErrorManager.hpp"
+
+namespace {
+    const float SMOOTHING = 0.1f;
+}
+
+GpuTimer::FrameQueries GpuTimer::_frames[GpuTimer::FRAME_LATENCY];
+size_t GpuTimer::_frame = 0;
+int GpuTimer::_activePass = -1;
+bool GpuTimer::_hasSample = false;
+GpuTimerStats GpuTimer::_stats;
+
+const char *GpuTimer::getPassName(GpuPass pass) {
+    switch (pass) {
+        case GpuPass::SCENE:            return "Scene";
+        case GpuPass::WIREFRAME_POINTS: return "Wireframe/points";
+        case GpuPass::ANTI_ALIASING:    return "Anti-aliasing";
+        case GpuPass::POST_PROCESS:     return "Post-process";
+        case GpuPass::UI:               return "UI";
+        default:                        return "Unknown";
+    }
+}
+
+/**
+ * Collect - Reads back one frame's queries and folds them into the smoothed times
+ *
+ * FLOW:
+ * 1. Queries complete in submission order, so if the last one is available all are;
+ *    if it is not (GPU more than FRAME_LATENCY frames behind) the frame is dropped
+ *    rather than waited for
+ * 2. Sum the segments of each pass (nanoseconds) into per-pass milliseconds
+ * 3. Exponential moving average per pass; the first frame seeds the averages
+ */
+void GpuTimer::collect(FrameQueries &frame) {
+    if (frame.used == 0) {
+        return;
+    }
+
+    GLint available = 0;
+    GLCall(glGetQueryObjectiv(frame.queries[frame.used - 1], GL_QUERY_RESULT_AVAILABLE, &available));
+    if (!available) {
+        _stats.droppedFrames++;
+        return;
+    }
+
+    float sample[static_cast<size_t>(GpuPass::COUNT)] = {};
+    for (size_t i = 0; i < frame.used; ++i) {
+        GLuint64 elapsed = 0;
+        GLCall(glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &elapsed));
+        sample[static_cast<size_t>(frame.passes[i])] += static_cast<float>(elapsed) * 1e-6f;
+    }
+
+    _stats.totalMs = 0.0f;
+    for (size_t pass = 0; pass < static_cast<size_t>(GpuPass::COUNT); ++pass) {
+        float &smoothed = _stats.passMs[pass];
+        smoothed = _hasSample ? smoothed + SMOOTHING * (sample[pass] - smoothed) : sample[pass];
+        _stats.totalMs += smoothed;
+    }
+    _hasSample = true;
+}
+
+/**
+ * Begin Frame - Moves to the next ring slot, harvesting the results it still holds
+ *
+ * The slot being reused was last filled FRAME_LATENCY frames ago; its queries are read
+ * back (or dropped) before they are reissued for this frame.
+ */
+void GpuTimer::beginFrame() {
+    end();
+    _frame = (_frame + 1) % FRAME_LATENCY;
+    collect(_frames[_frame]);
+    _frames[_frame].used = 0;
+}
+
+/**
+ * Begin Pass - Opens a time-elapsed query for a pass
+ *
+ * FLOW:
+ * 1. Already timing this pass: keep the open query
+ * 2. Close the open query of another pass (queries of one target cannot nest)
+ * 3. Take the frame's next query object, creating it on first use, and begin it
+ */
+void GpuTimer::begin(GpuPass pass) {
+    if (_activePass == static_cast<int>(pass)) {
+        return;
+    }
+    end();
+
+    FrameQueries &frame = _frames[_frame];
+    if (frame.used == frame.queries.size()) {
+        GLuint query = 0;
+        GLCall(glGenQueries(1, &query));
+        frame.queries.push_back(query);
+        frame.passes.push_back(pass);
+    }
+    frame.passes[frame.used] = pass;
+    GLCall(glBeginQuery(GL_TIME_ELAPSED, frame.queries[frame.used]));
+    frame.used++;
+    _activePass = static_cast<int>(pass);
+}
+
+void GpuTimer::end() {
+    if (_activePass < 0) {
+        return;
+    }
+    GLCall(glEndQuery(GL_TIME_ELAPSED));
+    _activePass = -1;
+}
+
+/**
+ * Shutdown - Deletes every query object of the ring while the context is still current
+ *
+ * FLOW:
+ * 1. Close the open query, if any
+ * 2. Delete each slot's queries and reset the slot, so a later context starts from scratch
+ */
+void GpuTimer::shutdown() {
+    end();
+    for (size_t i = 0; i < FRAME_LATENCY; ++i) {
+        FrameQueries &frame = _frames[i];
+        if (!frame.queries.empty()) {
+            GLCall(glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data()));
+        }
+        frame.queries.clear();
+        frame.passes.clear();
+        frame.used = 0;
+    }
+    _frame = 0;
+    _hasSample = false;
+    _stats = GpuTimerStats();
+}
@@ -13,8 +13,16 @@
 #include "../../include/Mesh.hpp"
 #include <glad/glad.h>
 #include <vector>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <climits>
 
-Mesh::Mesh(Parser *parser): _parser(parser) {
+// Splitting below this average chunk size costs more in draw calls than 16-bit indices save
+#define MIN_CHUNK_INDICES 3072
+
+Mesh::Mesh(Parser *parser, bool quantize): _parser(parser), _quantized(quantize),
+	_quantOffset(0.0f), _quantScale(1.0f), _vertexBufferSize(0), _indexType(GL_UNSIGNED_INT), _indexBufferSize(0) {
 	_vertexCount = parser->getVertices().size();
 	_indexCount = parser->getIndices().size();
 	_wireframeIndexCount = 0;
@@ -22,10 +30,10 @@ Mesh::Mesh(Parser *parser): _parser(parser) {
 }
 
 Mesh::~Mesh() {
-	glDeleteVertexArrays(1, &_VAO);
-	glDeleteBuffers(1, &_VBO);
-	glDeleteBuffers(1, &_IBO);
-	glDeleteBuffers(1, &_wireframeIBO);
+	GLState::deleteVertexArray(_VAO);
+	GLState::deleteBuffer(_VBO);
+	GLState::deleteBuffer(_IBO);
+	GLState::deleteBuffer(_wireframeIBO);
 }
 
 int Mesh::getVertexCount() const {
@@ -56,6 +64,176 @@ unsigned int Mesh::getWireframeIBO() const {
 	return _wireframeIBO;
 }
 
+bool Mesh::isQuantized() const {
+	return _quantized;
+}
+
+const glm::vec3 &Mesh::getQuantOffset() const {
+	return _quantOffset;
+}
+
+const glm::vec3 &Mesh::getQuantScale() const {
+	return _quantScale;
+}
+
+size_t Mesh::getVertexBufferSize() const {
+	return _vertexBufferSize;
+}
+
+unsigned int Mesh::getIndexType() const {
+	return _indexType;
+}
+
+size_t Mesh::getIndexBufferSize() const {
+	return _indexBufferSize;
+}
+
+size_t Mesh::getChunkCount() const {
+	return _lods.empty() ? 0 : _lods[0].triangles.size();
+}
+
+size_t Mesh::getLODCount() const {
+	return std::max<size_t>(_lods.size(), 1);
+}
+
+bool Mesh::isLineList() const {
+	return _parser && _parser->getMode() == FDF;
+}
+
+size_t Mesh::getLODPrimitiveCount(size_t lod) const {
+	if (lod < _lods.size()) {
+		return _lods[lod].primitiveCount;
+	}
+	return _indexCount / (isLineList() ? 2 : 3);
+}
+
+float Mesh::getLODError(size_t lod) const {
+	return lod < _lods.size() ? _lods[lod].error : 0.0f;
+}
+
+/**
+ * Float To Half - Converts a 32-bit float to IEEE 754 binary16 (round to nearest even)
+ * 
+ * FLOW:
+ * 1. Split sign, rebiased exponent and mantissa from the float bits
+ * 2. NaN/Inf and values above the half range map to NaN/Inf
+ * 3. Values below the normal range become half subnormals (or signed zero)
+ * 4. Normal values keep the top 10 mantissa bits, rounding on the dropped 13
+ */
+static uint16_t floatToHalf(float value) {
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	uint32_t sign = (bits >> 16) & 0x8000;
+	uint32_t rawExponent = (bits >> 23) & 0xff;
+	uint32_t mantissa = bits & 0x7fffff;
+	int exponent = static_cast<int>(rawExponent) - 127 + 15;
+
+	if (rawExponent == 0xff) {
+		return static_cast<uint16_t>(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+	}
+	if (exponent >= 31) {
+		return static_cast<uint16_t>(sign | 0x7c00);
+	}
+	if (exponent <= 0) {
+		if (exponent < -10) {
+			return static_cast<uint16_t>(sign);
+		}
+		mantissa |= 0x800000;
+		uint32_t shift = static_cast<uint32_t>(14 - exponent);
+		uint32_t half = mantissa >> shift;
+		uint32_t rest = mantissa & ((1u << shift) - 1);
+		uint32_t middle = 1u << (shift - 1);
+		if (rest > middle || (rest == middle && (half & 1))) {
+			half++;
+		}
+		return static_cast<uint16_t>(sign | half);
+	}
+
+	uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+	uint32_t rest = mantissa & 0x1fff;
+	if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) {
+		half++;
+	}
+	return static_cast<uint16_t>(sign | half);
+}
+
+/**
+ * Octahedral Encode - Maps a unit normal onto the [-1,1]^2 octahedron parameterization
+ * 
+ * FLOW:
+ * 1. Project the normal onto the octahedron |x| + |y| + |z| = 1
+ * 2. Fold the lower hemisphere (z < 0) over the diagonals
+ * 3. Quantize both components to 16-bit snorm
+ * 
+ * Decoded in the vertex shader by octDecode(); degenerate normals encode as +Z.
+ */
+static void octahedralEncode(const glm::vec3 &normal, int16_t out[2]) {
+	float sum = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+	glm::vec2 encoded(0.0f);
+
+	if (sum > 0.0f) {
+		glm::vec3 n = normal / sum;
+		encoded = glm::vec2(n.x, n.y);
+		if (n.z < 0.0f) {
+			encoded.x = (1.0f - std::fabs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+			encoded.y = (1.0f - std::fabs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+		}
+	}
+
+	for (int i = 0; i < 2; ++i) {
+		float clamped = std::min(std::max(encoded[i], -1.0f), 1.0f);
+		out[i] = static_cast<int16_t>(std::lround(clamped * 32767.0f));
+	}
+}
+
+/**
+ * Pack Vertices - Builds the quantized 16-byte vertex stream from the parser vertices
+ * 
+ * FLOW:
+ * 1. Take the parser bounding box as quantization frame (offset = min, scale = size)
+ * 2. Positions: (p - offset) / scale stored as 16-bit unorm per axis
+ * 3. Texture coordinates: half floats (keeps tiling UVs outside [0,1] intact)
+ * 4. Normals: octahedral 2 x 16-bit snorm
+ * 
+ * The shader reconstructs positions with u_quantOffset + aPos * u_quantScale.
+ */
+std::vector<PackedVertex> Mesh::packVertices() {
+	const std::vector<Vertex> &vertices = _parser->getVertices();
+	const BoundingBox &bounds = _parser->getBoundingBox();
+
+	_quantOffset = bounds.min;
+	_quantScale = bounds.getSize();
+	for (int axis = 0; axis < 3; ++axis) {
+		if (!(_quantScale[axis] > 0.0f)) {
+			_quantScale[axis] = 0.0f;
+		}
+	}
+
+	std::vector<PackedVertex> packed(vertices.size());
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		const Vertex &vertex = vertices[i];
+		PackedVertex &out = packed[i];
+
+		for (int axis = 0; axis < 3; ++axis) {
+			float normalized = 0.0f;
+			if (_quantScale[axis] > 0.0f) {
+				normalized = (vertex.position[axis] - _quantOffset[axis]) / _quantScale[axis];
+			}
+			normalized = std::min(std::max(normalized, 0.0f), 1.0f);
+			out.position[axis] = static_cast<uint16_t>(std::lround(normalized * 65535.0f));
+		}
+		out.position[3] = 0;
+
+		out.texCoord[0] = floatToHalf(vertex.texCoord.x);
+		out.texCoord[1] = floatToHalf(vertex.texCoord.y);
+
+		octahedralEncode(vertex.normal, out.normal);
+	}
+
+	return packed;
+}
+
 /**
  * Bind Mesh to OpenGL - Sets up VAO, VBO, and IBO for rendering
  * 
@@ -64,32 +242,74 @@ unsigned int Mesh::getWireframeIBO() const {
  * 2. Create and populate Vertex Buffer Object (VBO):
  *    - Generate buffer and bind to GL_ARRAY_BUFFER
  *    - Upload vertex data from parser (position, UV coords, normals)
- * 3. Create and populate Index Buffer Objects:
- *    - Main IBO: Triangle indices for filled rendering
+ * 3. Create and populate Index Buffer Objects (16-bit chunks when possible, see buildIndexBuffers):
+ *    - Main IBO: Triangle indices for filled rendering, plus one range per material group
  *    - Wireframe IBO: Line indices for wireframe rendering
  * 4. Configure vertex attribute pointers:
  *    - Attribute 0: Position (vec3) at offset 0
  *    - Attribute 1: Texture coordinates (vec2) at texCoord offset
  *    - Attribute 2: Normal vectors (vec3) at normal offset
+ *    Quantized meshes use the PackedVertex layout instead:
+ *    - Attribute 0: Position (3 x unorm16, normalized to the bounding box)
+ *    - Attribute 1: Texture coordinates (2 x half float)
+ *    - Attribute 2: Octahedral normal (2 x snorm16, decoded in the shader)
  * 5. Enable vertex attribute arrays for shader access
  */
 void Mesh::bind(){
     GLCall(glGenVertexArrays(1, &_VAO));
-    GLCall(glBindVertexArray(_VAO));
+    GLState::bindVertexArray(_VAO);
+
+    std::vector<PackedVertex> packed;
+    if (_quantized) {
+        packed = packVertices();
+        _vertexBufferSize = sizeof(PackedVertex) * packed.size();
+    } else {
+        _vertexBufferSize = sizeof(Vertex) * _parser->getVertices().size();
+    }
 
     glGenBuffers(1, &_VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, _VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * _parser->getVertices().size(), _parser->getVertices().data(), GL_STATIC_DRAW);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, _VBO);
+    if (_quantized) {
+        glBufferData(GL_ARRAY_BUFFER, _vertexBufferSize, packed.data(), GL_STATIC_DRAW);
+        std::cout << "Quantized vertex buffer: " << sizeof(Vertex) * packed.size() / 1024 << " KB -> "
+                  << _vertexBufferSize / 1024 << " KB (" << sizeof(PackedVertex) << " bytes per vertex)" << std::endl;
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, _vertexBufferSize, _parser->getVertices().data(), GL_STATIC_DRAW);
+    }
+
+    std::vector<unsigned int> indexData;
+    std::vector<unsigned int> wireframeData;
+    _indexType = GL_UNSIGNED_SHORT;
+    if (!buildIndexBuffers(true, indexData, wireframeData)) {
+        _indexType = GL_UNSIGNED_INT;
+        buildIndexBuffers(false, indexData, wireframeData);
+    }
 
     glGenBuffers(1, &_IBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _IBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * _parser->getIndices().size(), _parser->getIndices().data(), GL_STATIC_DRAW);
+    uploadIndices(_IBO, indexData);
 
     glGenBuffers(1, &_wireframeIBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _wireframeIBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * _wireframeIndices.size(), _wireframeIndices.data(), GL_STATIC_DRAW);
+    uploadIndices(_wireframeIBO, wireframeData);
+
+    size_t totalIndices = indexData.size() + wireframeData.size();
+    _indexBufferSize = totalIndices * (_indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(unsigned int));
+    std::cout << "Index buffers: " << (_indexType == GL_UNSIGNED_SHORT ? "16-bit" : "32-bit") << ", "
+              << getChunkCount() << " draw chunk(s), " << _indexBufferSize / 1024 << " KB ("
+              << totalIndices * sizeof(unsigned int) / 1024 << " KB as 32-bit)" << std::endl;
+
+    GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _IBO);
+
+    if (_quantized) {
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, position));
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _IBO);
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, texCoord));
+
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_SHORT, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, normal));
+        return;
+    }
 
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
@@ -102,8 +322,13 @@ void Mesh::bind(){
 }
 
 void Mesh::generateWireframeIndices() {
-    const std::vector<unsigned int>& triangleIndices = _parser->getIndices();
-    _wireframeIndices.clear();
+    _wireframeIndices = buildLineList(_parser->getIndices());
+    _wireframeIndexCount = _wireframeIndices.size();
+}
+
+std::vector<unsigned int> Mesh::buildLineList(const std::vector<unsigned int> &triangleIndices) {
+    std::vector<unsigned int> lines;
+    lines.reserve(triangleIndices.size() * 2);
     
     for (size_t i = 0; i < triangleIndices.size(); i += 3) {
         if (i + 2 < triangleIndices.size()) {
@@ -111,16 +336,197 @@ void Mesh::generateWireframeIndices() {
             unsigned int v1 = triangleIndices[i + 1];
             unsigned int v2 = triangleIndices[i + 2];
             
-            _wireframeIndices.push_back(v0);
-            _wireframeIndices.push_back(v1);
+            lines.push_back(v0);
+            lines.push_back(v1);
             
-            _wireframeIndices.push_back(v1);
-            _wireframeIndices.push_back(v2);
+            lines.push_back(v1);
+            lines.push_back(v2);
             
-            _wireframeIndices.push_back(v2);
-            _wireframeIndices.push_back(v0);
+            lines.push_back(v2);
+            lines.push_back(v0);
         }
     }
     
-    _wireframeIndexCount = _wireframeIndices.size();
-}
\ No newline at end of file
+    return lines;
+}
+
+/**
+ * Build Index Buffers - Lays out every index range of the mesh as base-vertex chunks
+ * 
+ * FLOW:
+ * 1. Main IBO layout:
+ *    - If the material groups cover every triangle, store only the groups and draw the
+ *      whole mesh as the concatenation of their chunks (no duplicated indices)
+ *    - Otherwise store the full index list first, followed by one range per group
+ *    - Every simplified LOD from the parser follows, laid out the same way
+ * 2. Wireframe IBO: the generated line list of every level
+ * 3. Each range is cut into chunks (whole primitives only):
+ *    - With splitChunks, a chunk ends before the primitive that would stretch its vertex
+ *      span past 65,535; indices are stored relative to the chunk's lowest vertex
+ *    - Without it, every range is a single chunk of absolute indices
+ * 4. Report whether the split layout is usable with 16-bit indices: every relative index
+ *    fits in an unsigned short and splitting did not fragment the mesh into tiny draws
+ */
+bool Mesh::buildIndexBuffers(bool splitChunks, std::vector<unsigned int> &indexData, std::vector<unsigned int> &wireframeData) {
+    const std::vector<unsigned int> &indices = _parser->getIndices();
+    const std::vector<MaterialGroup> &groups = _parser->getMaterialGroups();
+    size_t primitiveSize = _parser->getMode() == FDF ? 2 : 3;
+
+    unsigned int maxRelativeIndex = 0;
+    size_t splitCount = 0;
+
+    auto appendChunks = [&](const std::vector<unsigned int> &source, size_t primitiveStride, std::vector<unsigned int> &out) {
+        std::vector<DrawChunk> chunks;
+        size_t primitiveCount = source.size() / primitiveStride;
+        size_t primitive = 0;
+
+        while (primitive < primitiveCount) {
+            unsigned int minVertex = UINT_MAX;
+            unsigned int maxVertex = 0;
+            size_t end = primitive;
+
+            while (end < primitiveCount) {
+                unsigned int low = minVertex;
+                unsigned int high = maxVertex;
+                for (size_t k = 0; k < primitiveStride; ++k) {
+                    unsigned int index = source[end * primitiveStride + k];
+                    low = std::min(low, index);
+                    high = std::max(high, index);
+                }
+                if (splitChunks && high - low > 0xFFFF && end > primitive) {
+                    break;
+                }
+                minVertex = low;
+                maxVertex = high;
+                end++;
+            }
+
+            DrawChunk chunk;
+            chunk.firstIndex = out.size();
+            chunk.indexCount = static_cast<int>((end - primitive) * primitiveStride);
+            chunk.baseVertex = splitChunks ? static_cast<int>(minVertex) : 0;
+
+            for (size_t i = primitive * primitiveStride; i < end * primitiveStride; ++i) {
+                out.push_back(source[i] - chunk.baseVertex);
+            }
+
+            maxRelativeIndex = std::max(maxRelativeIndex, maxVertex - chunk.baseVertex);
+            if (!chunks.empty()) {
+                splitCount++;
+            }
+            chunks.push_back(chunk);
+            primitive = end;
+        }
+
+        return chunks;
+    };
+
+    indexData.clear();
+    wireframeData.clear();
+    _lods.assign(1, LODRanges());
+
+    size_t groupedIndexCount = 0;
+    for (const auto &group : groups) {
+        groupedIndexCount += group.indices.size();
+    }
+    bool groupsCoverMesh = !groups.empty() && groupedIndexCount == indices.size();
+
+    LODRanges &base = _lods[0];
+    base.primitiveCount = indices.size() / primitiveSize;
+
+    if (!groupsCoverMesh) {
+        base.triangles = appendChunks(indices, primitiveSize, indexData);
+    }
+
+    for (const auto &group : groups) {
+        base.groups.push_back(appendChunks(group.indices, 3, indexData));
+        if (groupsCoverMesh) {
+            base.triangles.insert(base.triangles.end(), base.groups.back().begin(), base.groups.back().end());
+        }
+    }
+
+    base.wireframe = appendChunks(_wireframeIndices, 2, wireframeData);
+
+    for (const auto &lod : _parser->getLODs()) {
+        LODRanges ranges;
+        ranges.primitiveCount = lod.indices.size() / 3;
+        ranges.error = lod.error;
+
+        if (!groups.empty() && lod.groupIndices.size() == groups.size()) {
+            for (const auto &groupIndices : lod.groupIndices) {
+                ranges.groups.push_back(appendChunks(groupIndices, 3, indexData));
+                ranges.triangles.insert(ranges.triangles.end(), ranges.groups.back().begin(), ranges.groups.back().end());
+            }
+        } else {
+            ranges.triangles = appendChunks(lod.indices, 3, indexData);
+        }
+
+        ranges.wireframe = appendChunks(buildLineList(lod.indices), 2, wireframeData);
+        _lods.push_back(std::move(ranges));
+    }
+
+    if (!splitChunks) {
+        return true;
+    }
+
+    size_t totalIndices = indexData.size() + wireframeData.size();
+    return maxRelativeIndex <= 0xFFFF && splitCount <= totalIndices / MIN_CHUNK_INDICES;
+}
+
+void Mesh::uploadIndices(unsigned int ibo, const std::vector<unsigned int> &data) {
+    GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+
+    if (_indexType == GL_UNSIGNED_SHORT) {
+        std::vector<uint16_t> shortData(data.begin(), data.end());
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * shortData.size(), shortData.data(), GL_STATIC_DRAW);
+    } else {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * data.size(), data.data(), GL_STATIC_DRAW);
+    }
+}
+
+void Mesh::drawChunks(unsigned int mode, unsigned int ibo, const std::vector<DrawChunk> &chunks) const {
+    size_t indexSize = _indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(unsigned int);
+
+    GLState::bindVertexArray(_VAO);
+    GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+
+    for (const auto &chunk : chunks) {
+        GLCall(glDrawElementsBaseVertex(mode, chunk.indexCount, _indexType,
+                                        (void*)(chunk.firstIndex * indexSize), chunk.baseVertex));
+    }
+}
+
+void Mesh::drawElements(unsigned int mode, size_t lod) const {
+    if (_lods.empty()) {
+        return;
+    }
+    lod = std::min(lod, _lods.size() - 1);
+    drawChunks(mode, _IBO, _lods[lod].triangles);
+}
+
+void Mesh::drawWireframe(size_t lod) const {
+    if (_lods.empty()) {
+        return;
+    }
+    lod = std::min(lod, _lods.size() - 1);
+    drawChunks(GL_LINES, _wireframeIBO, _lods[lod].wireframe);
+}
+
+void Mesh::drawMaterialGroup(size_t groupIndex, unsigned int mode, size_t lod) const {
+    if (_lods.empty()) {
+        return;
+    }
+    lod = std::min(lod, _lods.size() - 1);
+    if (_lods[lod].groups.empty()) {
+        lod = 0;
+    }
+    if (groupIndex >= _lods[lod].groups.size()) {
+        return;
+    }
+    drawChunks(mode, _IBO, _lods[lod].groups[groupIndex]);
+}
+
+void Mesh::drawPoints() const {
+    GLState::bindVertexArray(_VAO);
+    GLCall(glDrawArrays(GL_POINTS, 0, _vertexCount));
+}
@@ -14,15 +14,40 @@
 #include <iostream>
 #include <glad/glad.h>
 
+namespace {
+    // Render target capacity: sizes are rounded up to this granularity, grown with some
+    // slack, and only shrunk once the used area falls below a quarter of the allocation
+    const int CAPACITY_ALIGNMENT = 64;
+    const float CAPACITY_GROWTH = 1.25f;
+    const float CAPACITY_SHRINK_AREA = 0.25f;
+
+    int alignCapacity(float size) {
+        int aligned = static_cast<int>(size) + CAPACITY_ALIGNMENT - 1;
+        return aligned - aligned % CAPACITY_ALIGNMENT;
+    }
+}
+
 PostProcessor::PostProcessor(int width, int height) 
-    : _framebuffer(0), _colorTexture(0), _depthRenderbuffer(0), 
-      _quadVAO(0), _quadVBO(0), _width(width), _height(height), 
-      _enableCRT(false), _time(0.0f) {
+    : _sceneTarget(nullptr), _enabledCount(0), _fxaaEffect(0),
+      _crtEffect(0), _quadVAO(0), _quadVBO(0), _width(width), _height(height),
+      _capacityWidth(alignCapacity(static_cast<float>(width))), _capacityHeight(alignCapacity(static_cast<float>(height))),
+      _outputSize(width, height), _time(0.0f), _antiAliasing(AntiAliasing::OFF), _samples(0), _maxSamples(0) {
     
-    _postProcessShader = std::make_unique<Shader>("resources/shaders/CRT_PostProcess.shader");
-    _postProcessShader->compile();
+    GLCall(glGetIntegerv(GL_MAX_SAMPLES, &_maxSamples));
+
+    // Anti-aliasing runs first, on the clean scene, before effects distort it
+    _fxaaEffect = addEffect("FXAA", "resources/shaders/FXAA.shader");
+    _effects[_fxaaEffect].timerPass = GpuPass::ANTI_ALIASING;
+    setEffectParameter(_fxaaEffect, "u_spanMax", 8.0f);
+    setEffectParameter(_fxaaEffect, "u_reduceMul", 1.0f / 8.0f);
+    setEffectParameter(_fxaaEffect, "u_reduceMin", 1.0f / 128.0f);
+
+    _crtEffect = addEffect("CRT", "resources/shaders/CRT_PostProcess.shader");
+    setEffectParameter(_crtEffect, "u_scanlineIntensity", 0.02f);
+    setEffectParameter(_crtEffect, "u_vignetteStrength", 0.3f);
+    setEffectParameter(_crtEffect, "u_curvature", 5.0f);
+    setEffectParameter(_crtEffect, "u_aberrationStrength", 0.003f);
     
-    setupFramebuffer();
     setupQuad();
 }
 
@@ -31,41 +56,81 @@ PostProcessor::~PostProcessor() {
 }
 
 /**
- * Setup Framebuffer - Creates off-screen rendering target for post-processing
+ * Add Effect - Appends a pass to the end of the chain, initially disabled
+ * 
+ * The shader is compiled here, once; enabling the pass later costs nothing but the flag.
+ * Returns the pass index used by the other effect accessors.
+ */
+size_t PostProcessor::addEffect(const std::string &name, const std::string &shaderPath) {
+    PostEffect effect;
+    effect.name = name;
+    effect.shader = std::make_unique<Shader>(shaderPath);
+    if (!effect.shader->compile()) {
+        std::cerr << "Error: failed to build the " << name << " effect shader" << std::endl;
+    }
+    _effects.push_back(std::move(effect));
+    return _effects.size() - 1;
+}
+
+int PostProcessor::findEffect(const std::string &name) const {
+    for (size_t i = 0; i < _effects.size(); ++i) {
+        if (_effects[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void PostProcessor::setEffectEnabled(size_t index, bool enabled) {
+    PostEffect &effect = _effects[index];
+    if (effect.enabled != enabled) {
+        effect.enabled = enabled;
+        if (enabled) {
+            _enabledCount++;
+        } else {
+            _enabledCount--;
+        }
+    }
+}
+
+void PostProcessor::setEffectParameter(size_t index, const std::string &name, float value) {
+    for (auto &parameter : _effects[index].parameters) {
+        if (parameter.first == name) {
+            parameter.second = value;
+            return;
+        }
+    }
+    _effects[index].parameters.emplace_back(name, value);
+}
+
+int PostProcessor::getSampleCount(AntiAliasing mode) {
+    switch (mode) {
+        case AntiAliasing::MSAA_2X: return 2;
+        case AntiAliasing::MSAA_4X: return 4;
+        case AntiAliasing::MSAA_8X: return 8;
+        default:                    return 0;
+    }
+}
+
+/**
+ * Set Anti-Aliasing - Switches between no AA, the FXAA pass and a multisampled scene target
  * 
  * FLOW:
- * 1. Generate and bind framebuffer object (FBO)
- * 2. Create color texture attachment:
- *    - Generate texture with screen dimensions
- *    - Configure linear filtering for smooth sampling
- *    - Attach as GL_COLOR_ATTACHMENT0
- * 3. Create depth/stencil renderbuffer:
- *    - Generate renderbuffer with GL_DEPTH24_STENCIL8 format
- *    - Attach as GL_DEPTH_STENCIL_ATTACHMENT for depth testing
- * 4. Validate framebuffer completeness
- * 5. Unbind framebuffer to restore default framebuffer
+ * 1. FXAA is an ordinary effect at the head of the chain: enabling it is the only change
+ * 2. MSAA sets the sample count of the scene target requested by the next bind(); sample
+ *    counts above GL_MAX_SAMPLES are clamped with a warning. Targets of the old count are
+ *    released as usual and age out of the pool
  */
-void PostProcessor::setupFramebuffer() {
-    GLCall(glGenFramebuffers(1, &_framebuffer));
-    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer));
-    
-    GLCall(glGenTextures(1, &_colorTexture));
-    GLCall(glBindTexture(GL_TEXTURE_2D, _colorTexture));
-    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, _width, _height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL));
-    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
-    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-    GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _colorTexture, 0));
-    
-    GLCall(glGenRenderbuffers(1, &_depthRenderbuffer));
-    GLCall(glBindRenderbuffer(GL_RENDERBUFFER, _depthRenderbuffer));
-    GLCall(glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, _width, _height));
-    GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, _depthRenderbuffer));
-    
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        std::cerr << "ERROR: Framebuffer not complete!" << std::endl;
+void PostProcessor::setAntiAliasing(AntiAliasing mode) {
+    int samples = getSampleCount(mode);
+    if (samples > _maxSamples) {
+        std::cerr << "Warning: " << samples << "x MSAA unsupported, using " << _maxSamples << "x" << std::endl;
+        samples = _maxSamples;
     }
-    
-    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+
+    _antiAliasing = mode;
+    _samples = samples;
+    setEffectEnabled(_fxaaEffect, mode == AntiAliasing::FXAA);
 }
 
 /**
@@ -96,8 +161,8 @@ void PostProcessor::setupQuad() {
     GLCall(glGenVertexArrays(1, &_quadVAO));
     GLCall(glGenBuffers(1, &_quadVBO));
     
-    GLCall(glBindVertexArray(_quadVAO));
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, _quadVBO));
+    GLState::bindVertexArray(_quadVAO);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, _quadVBO);
     GLCall(glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW));
     
     GLCall(glEnableVertexAttribArray(0));
@@ -106,118 +171,230 @@ void PostProcessor::setupQuad() {
     GLCall(glEnableVertexAttribArray(1));
     GLCall(glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float))));
 
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
-    GLCall(glBindVertexArray(0));
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+    GLState::bindVertexArray(0);
     
     std::cout << "PostProcessor quad setup complete. VAO: " << _quadVAO << ", VBO: " << _quadVBO << std::endl;
 }
 
+/**
+ * Bind - Makes the pooled scene target current for the scene pass
+ * 
+ * The target is taken from the pool for this frame and handed back by render(). It may be
+ * larger than the scene (see resize()); the viewport restricts drawing to its lower-left
+ * _width x _height corner. With MSAA it is multisampled and resolved by render().
+ */
 void PostProcessor::bind() {
-    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer));
-    GLCall(glViewport(0, 0, _width, _height));
+    if (!_sceneTarget) {
+        _sceneTarget = _pool.acquire({_capacityWidth, _capacityHeight, GL_RGB8, true, _samples});
+        if (!_sceneTarget) {
+            return;
+        }
+    }
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, _sceneTarget->framebuffer);
+    GLState::viewport(0, 0, _width, _height);
 }
 
 void PostProcessor::unbind() {
-    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
 /**
- * Render Post-Process Effects - Applies screen-space effects to framebuffer
+ * Draw Pass - Runs one effect over a fullscreen quad, sampling the given target
+ * 
+ * The output framebuffer and viewport are set by the caller. Built-in uniforms are only
+ * set when the effect declares them; parameters always are, so a misspelt one is reported.
+ * u_resolution is the on-screen size of the composite, not the (possibly scaled) scene
+ * target, so display-space effects such as scanlines do not change with render scale.
+ * u_uvScale is the used fraction of the input texture, whose capacity may exceed the scene.
+ */
+void PostProcessor::drawPass(PostEffect &effect, const RenderTarget &input) {
+    Shader &shader = *effect.shader;
+    shader.use();
+    
+    shader.setUniform("u_screenTexture", 0);
+    if (shader.hasUniform("u_time")) {
+        shader.setUniform("u_time", _time);
+    }
+    if (shader.hasUniform("u_resolution")) {
+        shader.setUniform("u_resolution", _outputSize);
+    }
+    if (shader.hasUniform("u_uvScale")) {
+        shader.setUniform("u_uvScale", glm::vec2(static_cast<float>(_width) / static_cast<float>(_capacityWidth),
+                                                 static_cast<float>(_height) / static_cast<float>(_capacityHeight)));
+    }
+    for (const auto &parameter : effect.parameters) {
+        shader.setUniform(parameter.first, parameter.second);
+    }
+
+    GLState::bindTexture(GL_TEXTURE_2D, input.colorTexture);
+    GLCall(glDrawArrays(GL_TRIANGLES, 0, 6));
+}
+
+/**
+ * Resolve - Returns a single-sampled copy of the scene target that effects can sample
+ * 
+ * Without MSAA the scene target is returned as is. Otherwise its samples are averaged by a
+ * same-size blit into a color-only target from the pool (timed as anti-aliasing).
+ */
+RenderTarget *PostProcessor::resolve() {
+    if (_sceneTarget->desc.samples == 0) {
+        return _sceneTarget;
+    }
+
+    RenderTarget *resolved = _pool.acquire({_capacityWidth, _capacityHeight, GL_RGB8, false, 0});
+    if (!resolved) {
+        return nullptr;
+    }
+
+    GpuTimer::begin(GpuPass::ANTI_ALIASING);
+    GLState::bindFramebuffer(GL_READ_FRAMEBUFFER, _sceneTarget->framebuffer);
+    GLState::bindFramebuffer(GL_DRAW_FRAMEBUFFER, resolved->framebuffer);
+    GLCall(glBlitFramebuffer(0, 0, _width, _height, 0, 0, _width, _height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
+    GpuTimer::begin(GpuPass::POST_PROCESS);
+    return resolved;
+}
+
+/**
+ * Render Post-Process Chain - Runs the enabled effects in order and composites the result
  * 
  * FLOW:
- * 1. Validate quad VAO availability for rendering
- * 2. Save and disable depth testing (2D screen-space rendering)
- * 3. Activate post-process shader and set uniforms:
- *    - Screen texture sampler
- *    - Time for animated effects
- *    - Screen resolution for pixel-perfect effects
- *    - CRT effect enable/disable flag
- * 4. Bind framebuffer color texture to texture unit 0
- * 5. Render fullscreen quad with 6 vertices (2 triangles)
- * 6. Restore previous OpenGL state (depth testing)
- * 7. Clean up bindings
+ * 1. Validate quad VAO and the scene target filled since bind()
+ * 2. Resolve the multisampled scene target, if MSAA is on
+ * 3. No effect enabled (scene rendered off-screen only to be scaled or resolved): linear
+ *    blit into the output viewport, no shader involved
+ * 4. Save and disable depth testing (2D screen-space rendering, read from the state cache)
+ * 5. Walk the chain, skipping disabled passes, each timed under its own GPU pass:
+ *    - Last enabled pass: draw into the output framebuffer at the given viewport
+ *    - Any other pass: draw into the other ping-pong target; the first time one is needed
+ *      a color-only target is taken from the pool, and from then on passes alternate
+ *      between it and the (resolved) scene target, whose contents are no longer needed
+ * 6. Hand every target back to the pool, so one chain of any length holds at most two
+ *    (three with MSAA)
+ * 7. Restore previous OpenGL state (depth testing)
+ * 
+ * Bindings are left in place: all state goes through GLState, so resetting them to 0
+ * would only cost calls that the next bind has to undo.
  */
-void PostProcessor::render() {
+void PostProcessor::render(int x, int y, int width, int height, unsigned int output) {
     if (_quadVAO == 0) {
         std::cerr << "Error: quadVAO is 0!" << std::endl;
         return;
     }
-    
-    GLboolean depthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
-    
-    glDisable(GL_DEPTH_TEST);
-    
-    _postProcessShader->use();
-    GLCall(glGetError());
-    
-    _postProcessShader->setUniform("u_screenTexture", 0);
-    _postProcessShader->setUniform("u_time", _time);
-    _postProcessShader->setUniform("u_resolution", glm::vec2(static_cast<float>(_width), static_cast<float>(_height)));
-
-    GLint enableCRTLoc = glGetUniformLocation(_postProcessShader->getID(), "u_enableCRT");
-    if (enableCRTLoc != -1) {
-        glUniform1i(enableCRTLoc, _enableCRT ? 1 : 0);
+    if (!_sceneTarget) {
+        return;
     }
 
-    GLCall(glActiveTexture(GL_TEXTURE0));
-    GLCall(glBindTexture(GL_TEXTURE_2D, _colorTexture));
-    
-    GLCall(glBindVertexArray(_quadVAO));
-    
-    GLenum error = glGetError();
-    if (error != GL_NO_ERROR) {
-        std::cerr << "OpenGL error before draw: " << error << std::endl;
+    RenderTarget *targets[2] = { resolve(), nullptr };
+    if (!targets[0]) {
+        _pool.release(_sceneTarget);
+        _sceneTarget = nullptr;
+        return;
     }
 
-    GLCall(glDrawArrays(GL_TRIANGLES, 0, 6));
-    
-    if (depthTestEnabled) {
-        glEnable(GL_DEPTH_TEST);
+    if (_enabledCount == 0) {
+        GLState::bindFramebuffer(GL_READ_FRAMEBUFFER, targets[0]->framebuffer);
+        GLState::bindFramebuffer(GL_DRAW_FRAMEBUFFER, output);
+        GLCall(glBlitFramebuffer(0, 0, _width, _height, x, y, x + width, y + height, GL_COLOR_BUFFER_BIT, GL_LINEAR));
+    } else {
+        _outputSize = glm::vec2(static_cast<float>(width), static_cast<float>(height));
+        bool depthTestEnabled = GLState::isEnabled(GL_DEPTH_TEST);
+        
+        GLState::disable(GL_DEPTH_TEST);
+        GLState::activeTexture(GL_TEXTURE0);
+        GLState::bindVertexArray(_quadVAO);
+
+        size_t input = 0;
+        size_t remaining = _enabledCount;
+
+        for (auto &effect : _effects) {
+            if (!effect.enabled) {
+                continue;
+            }
+
+            if (--remaining == 0) {
+                GLState::bindFramebuffer(GL_FRAMEBUFFER, output);
+                GLState::viewport(x, y, width, height);
+            } else {
+                RenderTarget *&target = targets[1 - input];
+                if (!target) {
+                    target = _pool.acquire({_capacityWidth, _capacityHeight, GL_RGB8, false, 0});
+                    if (!target) {
+                        break;
+                    }
+                }
+                GLState::bindFramebuffer(GL_FRAMEBUFFER, target->framebuffer);
+                GLState::viewport(0, 0, _width, _height);
+            }
+
+            GpuTimer::begin(effect.timerPass);
+            drawPass(effect, *targets[input]);
+            input = 1 - input;
+        }
+        GpuTimer::begin(GpuPass::POST_PROCESS);
+        
+        if (depthTestEnabled) {
+            GLState::enable(GL_DEPTH_TEST);
+        }
     }
 
-    GLCall(glBindVertexArray(0));
-    GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+    if (targets[0] != _sceneTarget) {
+        _pool.release(targets[0]);
+    }
+    _pool.release(targets[1]);
+    _pool.release(_sceneTarget);
+    _sceneTarget = nullptr;
 }
 
+/**
+ * Resize - Changes the scene size, reallocating targets only when the capacity must change
+ * 
+ * FLOW:
+ * 1. Same size: nothing to do
+ * 2. Targets are allocated at a capacity of at least the scene size and passes render into
+ *    its lower-left corner, so most size changes (window drags, render scale steps) only
+ *    move the viewport and the UV scale
+ * 3. Growing past the capacity: grow the exceeded dimension with CAPACITY_GROWTH slack, so
+ *    a continuous drag reallocates a handful of times instead of every frame
+ * 4. Shrinking below CAPACITY_SHRINK_AREA of the allocation: reallocate tightly (plus slack)
+ *    to give the memory back
+ * 5. On a capacity change the released targets can never match again and are freed now
+ */
 void PostProcessor::resize(int width, int height) {
+    if (width == _width && height == _height) {
+        return;
+    }
     _width = width;
     _height = height;
-    
-    if (_framebuffer != 0) {
-        GLCall(glDeleteFramebuffers(1, &_framebuffer));
-        _framebuffer = 0;
-    }
-    if (_colorTexture != 0) {
-        GLCall(glDeleteTextures(1, &_colorTexture));
-        _colorTexture = 0;
+
+    int capacityWidth = _capacityWidth;
+    int capacityHeight = _capacityHeight;
+    if (width > capacityWidth || height > capacityHeight) {
+        if (width > capacityWidth) {
+            capacityWidth = alignCapacity(width * CAPACITY_GROWTH);
+        }
+        if (height > capacityHeight) {
+            capacityHeight = alignCapacity(height * CAPACITY_GROWTH);
+        }
+    } else if (static_cast<float>(width) * height < CAPACITY_SHRINK_AREA * capacityWidth * capacityHeight) {
+        capacityWidth = alignCapacity(width * CAPACITY_GROWTH);
+        capacityHeight = alignCapacity(height * CAPACITY_GROWTH);
     }
-    if (_depthRenderbuffer != 0) {
-        GLCall(glDeleteRenderbuffers(1, &_depthRenderbuffer));
-        _depthRenderbuffer = 0;
+
+    if (capacityWidth != _capacityWidth || capacityHeight != _capacityHeight) {
+        _capacityWidth = capacityWidth;
+        _capacityHeight = capacityHeight;
+        _pool.purge();
     }
-    
-    setupFramebuffer();
 }
 
 void PostProcessor::cleanup() {
-    if (_framebuffer != 0) {
-        GLCall(glDeleteFramebuffers(1, &_framebuffer));
-        _framebuffer = 0;
-    }
-    if (_colorTexture != 0) {
-        GLCall(glDeleteTextures(1, &_colorTexture));
-        _colorTexture = 0;
-    }
-    if (_depthRenderbuffer != 0) {
-        GLCall(glDeleteRenderbuffers(1, &_depthRenderbuffer));
-        _depthRenderbuffer = 0;
-    }
     if (_quadVAO != 0) {
-        GLCall(glDeleteVertexArrays(1, &_quadVAO));
+        GLState::deleteVertexArray(_quadVAO);
         _quadVAO = 0;
     }
     if (_quadVBO != 0) {
-        GLCall(glDeleteBuffers(1, &_quadVBO));
+        GLState::deleteBuffer(_quadVBO);
         _quadVBO = 0;
     }
 }
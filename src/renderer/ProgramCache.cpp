@@ -0,0 +1,186 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ProgramCache.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/18 10:08:02 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/18 15:13:40 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/ProgramCache.hpp"
+#include "../../include/GLExtensions.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+
+// Bump when the file layout changes so old files are ignored
+#define PROGRAM_CACHE_MAGIC 0x31425053u  // "SPB1"
+
+ProgramCacheStats ProgramCache::_stats;
+
+const ProgramCacheStats &ProgramCache::getStats() {
+    return _stats;
+}
+
+void ProgramCache::recordMiss() {
+    _stats.misses++;
+}
+
+std::string ProgramCache::getDirectory() {
+    if (const char *dir = std::getenv("SCOP_CACHE_DIR")) {
+        return dir;
+    }
+    if (const char *xdg = std::getenv("XDG_CACHE_HOME")) {
+        return std::string(xdg) + "/scop";
+    }
+    if (const char *home = std::getenv("HOME")) {
+        return std::string(home) + "/.cache/scop";
+    }
+    return ".scop_cache";
+}
+
+std::string ProgramCache::getPath(const std::string &key) {
+    return getDirectory() + "/" + key + ".bin";
+}
+
+/**
+ * Make Key - Hashes everything a program binary depends on into a file name
+ * 
+ * FLOW:
+ * 1. FNV-1a (64-bit) over the vertex source, fragment source and the driver's
+ *    GL_VENDOR / GL_RENDERER / GL_VERSION strings, with separators between fields
+ * 2. Return the hash as 16 hex digits
+ */
+std::string ProgramCache::makeKey(const std::string &vertexSource, const std::string &fragmentSource) {
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](const std::string &text) {
+        for (unsigned char c : text) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        hash ^= 0xFF;
+        hash *= 1099511628211ull;
+    };
+
+    const GLenum driverStrings[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+    mix(vertexSource);
+    mix(fragmentSource);
+    for (GLenum name : driverStrings) {
+        const char *value = reinterpret_cast<const char *>(glGetString(name));
+        mix(value ? value : "");
+    }
+
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+    return buffer;
+}
+
+/**
+ * Load Program - Recreates a linked program from its cached binary
+ * 
+ * FLOW:
+ * 1. Open the cache file; a missing file is a plain miss (returns 0)
+ * 2. Validate the header (magic, binary format, length) against the file size
+ * 3. Create a program and hand the binary to glProgramBinary
+ * 4. Check GL_LINK_STATUS: drivers reject binaries from other builds or GPUs, in which
+ *    case the program and the stale file are deleted and 0 is returned
+ */
+unsigned int ProgramCache::load(const std::string &key) {
+    std::ifstream file(getPath(key), std::ios::binary);
+    if (!file.is_open()) {
+        return 0;
+    }
+
+    uint32_t magic = 0;
+    uint32_t format = 0;
+    uint64_t length = 0;
+    file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char *>(&format), sizeof(format));
+    file.read(reinterpret_cast<char *>(&length), sizeof(length));
+
+    std::vector<char> binary;
+    if (file && magic == PROGRAM_CACHE_MAGIC && length > 0 && length < (64ull << 20)) {
+        binary.resize(static_cast<size_t>(length));
+        file.read(binary.data(), static_cast<std::streamsize>(length));
+    }
+    bool valid = file && !binary.empty();
+    file.close();
+
+    unsigned int program = 0;
+    if (valid) {
+        program = glCreateProgram();
+        GLExtensions::programBinaryLoad(program, format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+        int linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (linked == GL_TRUE) {
+            _stats.hits++;
+            return program;
+        }
+        glDeleteProgram(program);
+    }
+
+    _stats.rejected++;
+    std::error_code error;
+    std::filesystem::remove(getPath(key), error);
+    return 0;
+}
+
+/**
+ * Store Program - Saves a freshly linked program's binary
+ * 
+ * FLOW:
+ * 1. Query the binary size and retrieve it (the program must have been linked with
+ *    GL_PROGRAM_BINARY_RETRIEVABLE_HINT)
+ * 2. Write header + binary to a temporary file, then rename it into place so a crash
+ *    or a concurrent launch never leaves a truncated cache entry
+ * 3. Failures only warn: the cache is an optimization, never a requirement
+ */
+void ProgramCache::store(const std::string &key, unsigned int program) {
+    int length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum format = 0;
+    GLsizei written = 0;
+    GLExtensions::getProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) {
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(getDirectory(), error);
+
+    std::string path = getPath(key);
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        uint32_t magic = PROGRAM_CACHE_MAGIC;
+        uint32_t binaryFormat = format;
+        uint64_t binaryLength = static_cast<uint64_t>(written);
+        file.write(reinterpret_cast<const char *>(&magic), sizeof(magic));
+        file.write(reinterpret_cast<const char *>(&binaryFormat), sizeof(binaryFormat));
+        file.write(reinterpret_cast<const char *>(&binaryLength), sizeof(binaryLength));
+        file.write(binary.data(), written);
+        if (!file) {
+            std::cerr << "Warning: could not write program cache file " << tempPath << std::endl;
+            return;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::cerr << "Warning: could not store program cache file " << path << ": " << error.message() << std::endl;
+        std::filesystem::remove(tempPath, error);
+    }
+}
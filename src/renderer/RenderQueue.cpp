@@ -0,0 +1,136 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RenderQueue.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/16 10:04:51 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/16 17:32:14 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/RenderQueue.hpp"
+#include "../../include/Shader.hpp"
+#include "../../include/Texture.hpp"
+#include <cstring>
+
+void RenderQueue::submit(const DrawItem &item) {
+    _entries.push_back({ makeKey(item), static_cast<uint32_t>(_items.size()) });
+    _items.push_back(item);
+}
+
+void RenderQueue::clear() {
+    _items.clear();
+    _entries.clear();
+    _order.clear();
+}
+
+const DrawItem &RenderQueue::operator[](size_t index) const {
+    return _items[index];
+}
+
+size_t RenderQueue::size() const {
+    return _items.size();
+}
+
+bool RenderQueue::empty() const {
+    return _items.empty();
+}
+
+/**
+ * Depth Bits - Maps a non-negative distance to 24 order-preserving bits
+ * 
+ * The IEEE 754 bit pattern of a non-negative float grows with its value, so the top
+ * 24 bits (exponent plus 15 mantissa bits) order depths without knowing the scene range.
+ */
+uint32_t RenderQueue::depthBits(float depth) {
+    if (!(depth > 0.0f)) {
+        return 0;
+    }
+
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return bits >> 8;
+}
+
+/**
+ * Make Key - Packs an item's sort criteria into 64 bits (most significant first)
+ * 
+ * FLOW:
+ * 1. Bits 63-62: layer, so opaque work runs before overlays and transparency
+ * 2. Opaque/overlay: program (8) | texture (12) | material (10) | depth (24) | kind (8)
+ *    - equal state becomes contiguous, and within it items run front to back so
+ *      early depth testing rejects hidden fragments
+ * 3. Transparent: inverted depth (24) | program (8) | texture (12) | material (10)
+ *    - back to front is required for correct blending and wins over state sorting
+ * 
+ * GL names are truncated to their field width; a collision only costs an extra state
+ * change, never a wrong draw.
+ */
+uint64_t RenderQueue::makeKey(const DrawItem &item) {
+    uint64_t program = item.shader ? item.shader->getID() & 0xFFu : 0;
+    uint64_t texture = (item.useTexture && item.texture) ? item.texture->getID() & 0xFFFu : 0;
+    uint64_t material = static_cast<uint32_t>(item.material) & 0x3FFu;
+    uint64_t depth = depthBits(item.depth);
+    uint64_t key = static_cast<uint64_t>(item.layer) << 62;
+
+    if (item.layer == RenderLayer::TRANSPARENT) {
+        key |= (0xFFFFFFu - depth) << 38;
+        key |= program << 30;
+        key |= texture << 18;
+        key |= material << 8;
+        return key;
+    }
+
+    key |= program << 54;
+    key |= texture << 42;
+    key |= material << 32;
+    key |= depth << 8;
+    key |= static_cast<uint64_t>(item.kind);
+    return key;
+}
+
+/**
+ * Sort Queue - Orders the submitted items by key with an LSD radix sort
+ * 
+ * FLOW:
+ * 1. For each of the 8 key bytes, least significant first:
+ *    - Histogram the byte; if a single bucket holds every entry the pass cannot
+ *      change the order and is skipped (common for layer and program bytes)
+ *    - Prefix-sum the histogram and scatter entries into the scratch buffer (stable)
+ * 2. Emit the item indices in sorted order
+ */
+const std::vector<uint32_t> &RenderQueue::sort() {
+    const size_t count = _entries.size();
+    _scratch.resize(count);
+
+    for (unsigned int shift = 0; shift < 64; shift += 8) {
+        size_t histogram[256] = {};
+        for (const auto &entry : _entries) {
+            histogram[(entry.key >> shift) & 0xFF]++;
+        }
+
+        if (count == 0 || histogram[(_entries[0].key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t &bucket : histogram) {
+            size_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+
+        for (const auto &entry : _entries) {
+            _scratch[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+        }
+        _entries.swap(_scratch);
+    }
+
+    _order.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        _order[i] = _entries[i].index;
+    }
+    return _order;
+}
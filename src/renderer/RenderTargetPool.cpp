@@ -0,0 +1,188 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RenderTargetPool.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/22 09:15:02 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/22 16:31:22 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/RenderTargetPool.hpp"
+#include "../../include/GLState.hpp"
+#include "../../include/ErrorManager.hpp"
+#include <iostream>
+
+RenderTargetPool::RenderTargetPool(size_t maxIdleFrames)
+    : _frame(0), _maxIdleFrames(maxIdleFrames), _allocations(0) {}
+
+RenderTargetPool::~RenderTargetPool() {
+    for (auto &target : _targets) {
+        destroy(*target);
+    }
+}
+
+size_t RenderTargetPool::bytesPerPixel(GLenum format) {
+    switch (format) {
+        case GL_RGB8:       return 3;
+        case GL_RGBA16F:    return 8;
+        case GL_RGBA32F:    return 16;
+        default:            return 4;
+    }
+}
+
+/**
+ * Create - Allocates the GL objects of a target from its description
+ *
+ * FLOW:
+ * 1. Generate and bind the framebuffer object
+ * 2. Color attachment (COLOR_ATTACHMENT0):
+ *    - Single-sampled: texture of the requested format, linear filtering, clamped so
+ *      effects sampling past the edge (curvature, aberration) do not wrap around
+ *    - Multisampled: renderbuffer with the requested sample count
+ * 3. Optional GL_DEPTH24_STENCIL8 renderbuffer for targets the scene is drawn into, with
+ *    the same sample count as the color
+ * 4. Validate completeness; an incomplete target is destroyed and reported as failed
+ */
+bool RenderTargetPool::create(RenderTarget &target) {
+    const RenderTargetDesc &desc = target.desc;
+    GLenum baseFormat = desc.format == GL_RGB8 ? GL_RGB : GL_RGBA;
+
+    GLCall(glGenFramebuffers(1, &target.framebuffer));
+    GLState::bindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+
+    if (desc.samples > 0) {
+        GLCall(glGenRenderbuffers(1, &target.colorRenderbuffer));
+        GLState::bindRenderbuffer(target.colorRenderbuffer);
+        GLCall(glRenderbufferStorageMultisample(GL_RENDERBUFFER, desc.samples, desc.format, desc.width, desc.height));
+        GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, target.colorRenderbuffer));
+    } else {
+        GLCall(glGenTextures(1, &target.colorTexture));
+        GLState::bindTexture(GL_TEXTURE_2D, target.colorTexture);
+        GLCall(glTexImage2D(GL_TEXTURE_2D, 0, desc.format, desc.width, desc.height, 0, baseFormat, GL_UNSIGNED_BYTE, NULL));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+        GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.colorTexture, 0));
+    }
+
+    if (desc.depth) {
+        GLCall(glGenRenderbuffers(1, &target.depthRenderbuffer));
+        GLState::bindRenderbuffer(target.depthRenderbuffer);
+        GLCall(glRenderbufferStorageMultisample(GL_RENDERBUFFER, desc.samples, GL_DEPTH24_STENCIL8, desc.width, desc.height));
+        GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, target.depthRenderbuffer));
+    }
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "ERROR: Render target " << desc.width << "x" << desc.height << " not complete!" << std::endl;
+        destroy(target);
+        return false;
+    }
+    return true;
+}
+
+void RenderTargetPool::destroy(RenderTarget &target) {
+    if (target.framebuffer != 0) {
+        GLState::deleteFramebuffer(target.framebuffer);
+        target.framebuffer = 0;
+    }
+    if (target.colorTexture != 0) {
+        GLState::deleteTexture(target.colorTexture);
+        target.colorTexture = 0;
+    }
+    if (target.colorRenderbuffer != 0) {
+        GLState::deleteRenderbuffer(target.colorRenderbuffer);
+        target.colorRenderbuffer = 0;
+    }
+    if (target.depthRenderbuffer != 0) {
+        GLState::deleteRenderbuffer(target.depthRenderbuffer);
+        target.depthRenderbuffer = 0;
+    }
+}
+
+/**
+ * Acquire - Returns a free target matching the description, creating one if none is free
+ *
+ * The returned target is bound to nothing; its contents are whatever the previous user
+ * left, so callers clear or fully overwrite it. Returns nullptr if allocation failed.
+ */
+RenderTarget *RenderTargetPool::acquire(const RenderTargetDesc &desc) {
+    for (auto &target : _targets) {
+        if (!target->inUse && target->desc == desc) {
+            target->inUse = true;
+            target->lastUsedFrame = _frame;
+            return target.get();
+        }
+    }
+
+    auto target = std::make_unique<RenderTarget>();
+    target->desc = desc;
+    if (!create(*target)) {
+        return nullptr;
+    }
+    target->inUse = true;
+    target->lastUsedFrame = _frame;
+    _allocations++;
+    _targets.push_back(std::move(target));
+    return _targets.back().get();
+}
+
+void RenderTargetPool::release(RenderTarget *target) {
+    if (target) {
+        target->inUse = false;
+        target->lastUsedFrame = _frame;
+    }
+}
+
+/**
+ * End Frame - Advances the frame counter and deletes targets left idle too long
+ *
+ * The idle window is long enough that toggling an effect off and on again finds its
+ * targets still allocated; only a chain that stays disabled gives its memory back.
+ */
+void RenderTargetPool::endFrame() {
+    _frame++;
+    for (size_t i = 0; i < _targets.size();) {
+        RenderTarget &target = *_targets[i];
+        if (!target.inUse && _frame - target.lastUsedFrame > _maxIdleFrames) {
+            destroy(target);
+            _targets.erase(_targets.begin() + static_cast<std::ptrdiff_t>(i));
+        } else {
+            ++i;
+        }
+    }
+}
+
+/**
+ * Purge - Deletes every released target immediately
+ *
+ * Used when the descriptions in use change for good (viewport resize), where waiting for
+ * the idle window would keep one stale set of targets per intermediate size.
+ */
+void RenderTargetPool::purge() {
+    for (size_t i = 0; i < _targets.size();) {
+        if (!_targets[i]->inUse) {
+            destroy(*_targets[i]);
+            _targets.erase(_targets.begin() + static_cast<std::ptrdiff_t>(i));
+        } else {
+            ++i;
+        }
+    }
+}
+
+RenderTargetPoolStats RenderTargetPool::getStats() const {
+    RenderTargetPoolStats stats;
+    stats.allocations = _allocations;
+    for (const auto &target : _targets) {
+        const RenderTargetDesc &desc = target->desc;
+        size_t pixels = static_cast<size_t>(desc.width) * static_cast<size_t>(desc.height)
+                      * static_cast<size_t>(desc.samples > 0 ? desc.samples : 1);
+        stats.targets++;
+        stats.inUse += target->inUse ? 1 : 0;
+        stats.bytes += pixels * (bytesPerPixel(desc.format) + (desc.depth ? 4 : 0));
+    }
+    return stats;
+}
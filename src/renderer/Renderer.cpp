@@ -11,109 +11,328 @@
 /* ************************************************************************** */
 
 #include "../../include/Renderer.hpp"
+#include <iostream>
 
 Renderer::Renderer(Shader* shader) : _shader(shader) {}
 
-void Renderer::setMatrices(const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection) {
-    _shader->use();
-    
-    int modelLoc = glGetUniformLocation(_shader->getID(), "model");
-    int viewLoc = glGetUniformLocation(_shader->getID(), "view");
-    int projectionLoc = glGetUniformLocation(_shader->getID(), "projection");
-    
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(projection));
+Renderer::~Renderer() = default;
+
+/**
+ * Initialize Renderer - Compiles the shader variants and creates the shared uniform
+ * buffers (requires a current GL context)
+ * 
+ * FLOW:
+ * 1. Build one program per ShaderVariant from the base shader's source, each with
+ *    its #define, so mode selection happens per draw instead of per fragment:
+ *    every variant is started before any is waited on, so cache loads and driver-side
+ *    parallel compilation overlap
+ * 2. Allocate the per-frame block (view, projection, camera and light)
+ * 3. Allocate the per-object block (model and normal matrix)
+ * 4. Both are attached to their fixed binding points for the lifetime of the renderer;
+ *    programs pick them up through UniformBuffer::bindProgramBlocks at link time
+ */
+void Renderer::initialize() {
+    static const char *defines[] = { "LINE", "POINT", "TEXTURED", "UNTEXTURED" };
+    for (size_t i = 0; i < static_cast<size_t>(ShaderVariant::COUNT); ++i) {
+        _variants[i] = std::make_unique<Shader>(*_shader, std::vector<std::string>{ defines[i] });
+        _variants[i]->beginCompile();
+    }
+    for (size_t i = 0; i < static_cast<size_t>(ShaderVariant::COUNT); ++i) {
+        if (!_variants[i]->finishCompile()) {
+            std::cerr << "Error: failed to build the " << defines[i] << " shader variant" << std::endl;
+        }
+    }
+
+    _frameBuffer = std::make_unique<UniformBuffer>(sizeof(FrameUniforms), UniformBuffer::FRAME_BINDING);
+    _objectBuffer = std::make_unique<UniformBuffer>(sizeof(ObjectUniforms), UniformBuffer::OBJECT_BINDING);
 }
 
 /**
- * Draw Mesh - Renders 3D mesh with various rendering modes and effects
+ * Set Mesh Uniforms - Sets the per-mesh program uniforms on every variant
  * 
  * FLOW:
- * 1. Activate shader program for rendering
- * 2. Get uniform locations for rendering mode control
- * 3. Handle wireframe rendering mode:
- *    - Set line color and enable line mode flags
- *    - Bind wireframe index buffer
- *    - Draw using GL_LINES primitive
- * 4. Handle standard rendering modes:
- *    - Configure line vs triangle rendering
- *    - Set up lighting uniforms (light position, color, camera position)
- *    - Configure texture usage flag and bind texture sampler
- *    - Draw using appropriate primitive type (triangles/lines)
- * 5. Handle vertex visualization overlay:
- *    - Enable vertex mode and set vertex color
- *    - Configure point rendering with size
- *    - Draw vertices as GL_POINTS
+ * 1. Vertex decoding (quantization offset/scale) is shared by all variants
+ * 2. The texture sampler only exists in the TEXTURED variant and is fixed to unit 0
  */
-void Renderer::draw(Mesh &mesh, int mode, const glm::vec3 &cameraPos, bool showVertices, bool wireframeMode, bool useTexture) {
-    _shader->use();
+void Renderer::setMeshUniforms(const Mesh &mesh) {
+    for (auto &variant : _variants) {
+        variant->use();
+        variant->setUniform("u_quantized", mesh.isQuantized() ? 1 : 0);
+        variant->setUniform("u_quantOffset", mesh.getQuantOffset());
+        variant->setUniform("u_quantScale", mesh.getQuantScale());
+        if (variant->hasUniform("u_texture")) {
+            variant->setUniform("u_texture", 0);
+        }
+    }
+}
+
+/**
+ * Select Variant - Maps a draw item to the shader permutation that renders it
+ */
+Shader *Renderer::selectVariant(const DrawItem &item) const {
+    ShaderVariant variant = ShaderVariant::UNTEXTURED;
+
+    switch (item.kind) {
+        case DrawKind::WIREFRAME:
+        case DrawKind::LINES:
+            variant = ShaderVariant::LINE;
+            break;
+        case DrawKind::POINTS:
+            variant = ShaderVariant::POINT;
+            break;
+        case DrawKind::TRIANGLES:
+            variant = (item.useTexture && item.texture) ? ShaderVariant::TEXTURED : ShaderVariant::UNTEXTURED;
+            break;
+    }
+    return _variants[static_cast<size_t>(variant)].get();
+}
+
+/**
+ * Set Frame Data - Fills the per-frame uniform block shared by every program
+ * 
+ * FLOW:
+ * 1. Pack view and projection matrices, camera position and the scene light
+ * 2. Upload through the buffer's shadow copy (no GL call if nothing moved)
+ */
+void Renderer::setFrameData(const glm::mat4& view, const glm::mat4& projection, const glm::vec3 &cameraPos) {
+    if (!_frameBuffer) {
+        return;
+    }
+
+    FrameUniforms frame;
+    frame.view = view;
+    frame.projection = projection;
+    frame.viewPos = glm::vec4(cameraPos, 1.0f);
+    frame.lightPos = glm::vec4(5.0f, 5.0f, 5.0f, 1.0f);
+    frame.lightColor = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+
+    Shader::recordBlockUpdate(_frameBuffer->update(&frame, sizeof(frame)));
+}
+
+/**
+ * Set Object Data - Fills the per-object uniform block for the next draws
+ * 
+ * FLOW:
+ * 1. Store the model matrix
+ * 2. Compute the normal matrix once on the CPU (inverse transpose of the upper 3x3)
+ *    instead of inverting the model matrix in every vertex shader invocation
+ * 3. Upload through the buffer's shadow copy
+ */
+void Renderer::setObjectData(const glm::mat4& model) {
+    if (!_objectBuffer) {
+        return;
+    }
+
+    ObjectUniforms object;
+    object.model = model;
+    object.normalMatrix = glm::mat4(glm::transpose(glm::inverse(glm::mat3(model))));
+
+    Shader::recordBlockUpdate(_objectBuffer->update(&object, sizeof(object)));
+}
+
+/**
+ * Select LOD - Picks the coarsest level whose error stays below LOD_PIXEL_ERROR on screen
+ * 
+ * FLOW:
+ * 1. Walk the levels from coarsest to finest
+ * 2. A level's error is relative to the model size, so error * projected size (pixels)
+ *    is the approximate on-screen deviation of that level
+ * 3. Return the first level within the pixel budget, or the full mesh (level 0)
+ */
+size_t Renderer::selectLOD(const Mesh &mesh, float projectedSize) const {
+    for (size_t lod = mesh.getLODCount() - 1; lod > 0; --lod) {
+        if (mesh.getLODError(lod) * projectedSize <= LOD_PIXEL_ERROR) {
+            return lod;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Submit Item - Queues a draw item, picking its shader variant when none is set
+ */
+void Renderer::submit(const DrawItem &item) {
+    if (item.shader) {
+        _queue.submit(item);
+        return;
+    }
+
+    DrawItem resolved = item;
+    resolved.shader = selectVariant(item);
+    _queue.submit(resolved);
+}
+
+const RenderQueueStats &Renderer::getQueueStats() const {
+    return _queueStats;
+}
+
+/**
+ * Submit Mesh - Queues the items that draw a whole mesh in the current display mode
+ * 
+ * FLOW:
+ * 1. Wireframe mode: one WIREFRAME item (edge list at the requested LOD)
+ * 2. Otherwise: one TRIANGLES or LINES item depending on the render mode,
+ *    carrying the texture to bind when texturing is on
+ * 3. Vertex visualization adds an overlay POINTS item
+ */
+void Renderer::submitMesh(const Mesh &mesh, int mode, bool showVertices, bool wireframeMode, bool useTexture,
+                          const Texture *texture, size_t lod, float depth) {
+    DrawItem item;
+    item.mesh = &mesh;
+    item.lod = lod;
+    item.depth = depth;
 
-    int lineColorLoc = glGetUniformLocation(_shader->getID(), "u_lineColor");
-    int isLineModeLoc = glGetUniformLocation(_shader->getID(), "u_isLineMode");
-    int isVertexModeLoc = glGetUniformLocation(_shader->getID(), "u_isVertexMode");
-    
     if (wireframeMode) {
-        setLineColor(lineColorLoc, Colors::OFF_WHITE);
-        glLineWidth(1.0f);
-        glUniform1i(isLineModeLoc, 1);
-        glUniform1i(isVertexModeLoc, 0);
-        
-        GLCall(glBindVertexArray(mesh.getVAO()));
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.getWireframeIBO());
-        GLCall(glDrawElements(GL_LINES, (GLsizei)mesh.getWireframeIndexCount(), GL_UNSIGNED_INT, nullptr));
-        
+        item.kind = DrawKind::WIREFRAME;
+    } else if (mode == 0) {
+        item.kind = DrawKind::TRIANGLES;
+        item.texture = texture;
+        item.useTexture = useTexture;
     } else {
-        int renderMode = mode == 0 ? GL_TRIANGLES : GL_LINES;
-        
-        if (renderMode == GL_LINES) {
-            setLineColor(lineColorLoc, Colors::OFF_WHITE);
-            glLineWidth(1.0f);
-            glUniform1i(isLineModeLoc, 1);
-            glUniform1i(isVertexModeLoc, 0);
-        } else {
-            glUniform1i(isLineModeLoc, 0);
-            glUniform1i(isVertexModeLoc, 0);
-            
-            int colorLoc = glGetUniformLocation(_shader->getID(), "u_color");
-            int lightPosLoc = glGetUniformLocation(_shader->getID(), "u_lightPos");
-            int lightColorLoc = glGetUniformLocation(_shader->getID(), "u_lightColor");
-            int viewPosLoc = glGetUniformLocation(_shader->getID(), "u_viewPos");
-            
-            int textureLoc = glGetUniformLocation(_shader->getID(), "u_texture");
-            int useTextureLoc = glGetUniformLocation(_shader->getID(), "useTexture");
-            
-            glUniform3f(colorLoc, 0.5, 0.5, 0.9);
-            
-            glm::vec3 lightPos(5.0f, 5.0f, 5.0f);
-            glUniform3fv(lightPosLoc, 1, glm::value_ptr(lightPos));
-            
-            glm::vec3 lightColor(1.0f, 1.0f, 1.0f);
-            glUniform3fv(lightColorLoc, 1, glm::value_ptr(lightColor));
-            
-            glUniform3fv(viewPosLoc, 1, glm::value_ptr(cameraPos));
-            
-            glUniform1i(textureLoc, 0);
-            glUniform1i(useTextureLoc, useTexture ? 1 : 0);
-        }
-        
-        GLCall(glBindVertexArray(mesh.getVAO()));
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.getIBO());
-        GLCall(glDrawElements(renderMode, (GLsizei)mesh.getIndexCount(), GL_UNSIGNED_INT, nullptr));
+        item.kind = DrawKind::LINES;
+    }
+    submit(item);
+
+    if (showVertices) {
+        submitVertices(mesh, depth);
     }
-    
+}
+
+/**
+ * Submit Model - Queues a whole model the way the viewer draws it
+ *
+ * The draws come from planSceneDraws() (wireframe, whole mesh or one item per material
+ * group), so the viewer, headless and software backends pick the same draws and textures.
+ * Items are executed in sort-key order, so groups sharing a texture are drawn together
+ * instead of in file order.
+ */
+void Renderer::submitModel(const Mesh &mesh, const std::vector<MaterialGroup> &groups,
+                           const std::unordered_map<int, std::shared_ptr<Texture>> &materialTextures,
+                           const Texture *fallback, int mode, bool showVertices, bool wireframeMode, bool useTexture,
+                           size_t lod, float depth) {
+    for (const auto &draw : planSceneDraws(groups, mode, materialTextures, fallback, useTexture, wireframeMode)) {
+        DrawItem item;
+        item.mesh = &mesh;
+        item.kind = draw.kind;
+        item.group = draw.group;
+        item.material = draw.material;
+        item.texture = draw.texture;
+        item.useTexture = draw.useTexture;
+        item.lod = lod;
+        item.depth = depth;
+        submit(item);
+    }
+
     if (showVertices) {
-        glUniform1i(isVertexModeLoc, 1);
-        glUniform1i(isLineModeLoc, 0);
-        
-        int vertexColorLoc = glGetUniformLocation(_shader->getID(), "u_vertexColor");
-        glUniform3f(vertexColorLoc, 1.0f, 1.0f, 0.0f);
-        
-        glEnable(GL_PROGRAM_POINT_SIZE);
-        glPointSize(10.0f);
-        
-        GLCall(glDrawArrays(GL_POINTS, 0, mesh.getVertexCount()));
-        
-        glDisable(GL_PROGRAM_POINT_SIZE);
+        submitVertices(mesh, depth);
+    }
+}
+
+void Renderer::submitVertices(const Mesh &mesh, float depth) {
+    DrawItem item;
+    item.mesh = &mesh;
+    item.kind = DrawKind::POINTS;
+    item.layer = RenderLayer::OVERLAY;
+    item.depth = depth;
+    submit(item);
+}
+
+/**
+ * Flush Queue - Sorts the submitted items and executes them in key order
+ * 
+ * FLOW:
+ * 1. Radix-sort the queue by sort key
+ * 2. Execute each item, counting program/texture changes between neighbours
+ *    (what the sort is meant to minimize; GLState elides the rest)
+ * 3. Wireframe and vertex overlay items are timed on the GPU as their own pass,
+ *    everything else as the scene; the caller closes the last pass
+ * 4. Clear the queue for the next frame
+ */
+void Renderer::flush() {
+    GL_DEBUG_GROUP("Render queue");
+    const std::vector<uint32_t> &order = _queue.sort();
+
+    _queueStats = RenderQueueStats();
+    const DrawItem *previous = nullptr;
+    for (uint32_t index : order) {
+        const DrawItem &item = _queue[index];
+        const Texture *texture = item.useTexture ? item.texture : nullptr;
+        if (previous && (previous->shader != item.shader
+                         || (previous->useTexture ? previous->texture : nullptr) != texture)) {
+            _queueStats.stateSwitches++;
+        }
+
+        bool overlay = item.kind == DrawKind::WIREFRAME || item.kind == DrawKind::POINTS;
+        GpuTimer::begin(overlay ? GpuPass::WIREFRAME_POINTS : GpuPass::SCENE);
+        execute(item);
+        previous = &item;
+    }
+    _queueStats.items = order.size();
+
+    _queue.clear();
+}
+
+/**
+ * Execute Item - Sets up shader state for one draw item and issues its draw
+ * 
+ * FLOW:
+ * 1. Activate the item's variant program (filtered by GLState); the variant already
+ *    encodes the render mode, so no mode uniforms are needed
+ * 2. WIREFRAME / LINES (LINE variant):
+ *    - Set line color and width
+ *    - Draw the wireframe edge list, or the triangle indices as GL_LINES
+ * 3. TRIANGLES (TEXTURED / UNTEXTURED variant):
+ *    - Textured: bind the item's texture to unit 0 (the sampler is fixed at setup)
+ *    - Untextured: set the base color (light and camera come from the per-frame block)
+ *    - Draw the whole mesh or one material group at the item's LOD
+ * 4. POINTS (POINT variant):
+ *    - Set vertex color
+ *    - Configure point rendering with size and draw vertices as GL_POINTS
+ */
+void Renderer::execute(const DrawItem &item) {
+    Shader &shader = *item.shader;
+    const Mesh &mesh = *item.mesh;
+
+    shader.use();
+
+    switch (item.kind) {
+        case DrawKind::WIREFRAME:
+        case DrawKind::LINES:
+            setLineColor(shader, Colors::OFF_WHITE);
+            GLState::lineWidth(1.0f);
+
+            if (item.kind == DrawKind::WIREFRAME) {
+                mesh.drawWireframe(item.lod);
+            } else if (item.group >= 0) {
+                mesh.drawMaterialGroup(static_cast<size_t>(item.group), GL_LINES, item.lod);
+            } else {
+                mesh.drawElements(GL_LINES, item.lod);
+            }
+            break;
+
+        case DrawKind::TRIANGLES:
+            if (item.useTexture && item.texture) {
+                item.texture->Bind(0);
+            } else {
+                shader.setUniform("u_color", glm::vec3(0.5f, 0.5f, 0.9f));
+            }
+
+            if (item.group >= 0) {
+                mesh.drawMaterialGroup(static_cast<size_t>(item.group), GL_TRIANGLES, item.lod);
+            } else {
+                mesh.drawElements(GL_TRIANGLES, item.lod);
+            }
+            break;
+
+        case DrawKind::POINTS:
+            shader.setUniform("u_vertexColor", glm::vec3(1.0f, 1.0f, 0.0f));
+
+            GLState::enable(GL_PROGRAM_POINT_SIZE);
+            GLState::pointSize(10.0f);
+
+            mesh.drawPoints();
+
+            GLState::disable(GL_PROGRAM_POINT_SIZE);
+            break;
     }
-}
\ No newline at end of file
+}
@@ -11,13 +11,34 @@
 /* ************************************************************************** */
 
 #include "../../include/Shader.hpp"
+#include "../../include/GLExtensions.hpp"
+#include "../../include/ProgramCache.hpp"
+#include <algorithm>
+#include <cstring>
 
-Shader::Shader(std::string shaderpath) {
+UniformStats Shader::_frameStats;
+
+Shader::Shader(std::string shaderpath) : _vs(0), _fs(0), _id(0), _fromCache(false) {
     _shaderSource = parseShader(shaderpath);
 }
 
+/**
+ * Shader Variant Constructor - Builds a permutation of an already parsed shader
+ * 
+ * FLOW:
+ * 1. Reuse the base shader's parsed sources (no file access)
+ * 2. Inject one "#define NAME" per entry into both stages
+ * 3. The variant is compiled separately and owns its own program
+ */
+Shader::Shader(const Shader &base, const std::vector<std::string> &defines) : _vs(0), _fs(0), _id(0), _fromCache(false) {
+    _shaderSource.vertexSource = applyDefines(base._shaderSource.vertexSource, defines);
+    _shaderSource.fragmentSource = applyDefines(base._shaderSource.fragmentSource, defines);
+}
+
 Shader::~Shader() {
-    glDeleteProgram(_id);
+    if (_id) {
+        GLState::deleteProgram(_id);
+    }
 }
 
 unsigned int Shader::getID() const {
@@ -25,12 +46,108 @@ unsigned int Shader::getID() const {
 }
 
 void Shader::use() const {
-    glUseProgram(_id);
+    GLState::useProgram(_id);
+}
+
+bool Shader::compile() {
+    beginCompile();
+    return finishCompile();
+}
+
+bool Shader::hasUniform(const std::string &name) const {
+    return _uniforms.find(name) != _uniforms.end();
+}
+
+const UniformStats &Shader::getFrameStats() {
+    return _frameStats;
+}
+
+void Shader::resetFrameStats() {
+    _frameStats = UniformStats();
+}
+
+void Shader::recordBlockUpdate(bool uploaded) {
+    _frameStats.blockUpdates++;
+    if (uploaded) {
+        _frameStats.blockUploads++;
+    }
+}
+
+/**
+ * Reflect Uniforms - Builds the uniform location table once after linking
+ * 
+ * FLOW:
+ * 1. Query the number of active uniforms and the longest name
+ * 2. For each active uniform (glGetActiveUniform):
+ *    - Strip the "[0]" suffix GL reports for arrays
+ *    - Resolve its location; uniforms inside blocks have none and are skipped
+ * 3. Store location and type; the shadow value stays empty until the first upload
+ */
+void Shader::reflectUniforms() {
+    _uniforms.clear();
+    _missingUniforms.clear();
+
+    int count = 0;
+    int maxLength = 0;
+    glGetProgramiv(_id, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<char> nameBuffer(static_cast<size_t>(maxLength) + 1);
+    for (int i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(_id, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()), &length, &size, &type, nameBuffer.data());
+
+        std::string name(nameBuffer.data(), static_cast<size_t>(length));
+        size_t bracket = name.find("[0]");
+        if (bracket != std::string::npos) {
+            name.erase(bracket);
+        }
+
+        int location = glGetUniformLocation(_id, name.c_str());
+        if (location == -1) {
+            continue;
+        }
+
+        UniformSlot slot;
+        slot.location = location;
+        slot.type = type;
+        _uniforms[name] = slot;
+    }
 }
 
-void Shader::compile() {
-    _id = createShader(_shaderSource.vertexSource, _shaderSource.fragmentSource);
-    use();
+/**
+ * Update Shadow - Decides whether a uniform value has to reach the driver
+ * 
+ * FLOW:
+ * 1. Count the request and look the name up in the reflected table
+ *    (unknown names warn once instead of every frame)
+ * 2. Compare the new value against the shadow copy byte by byte
+ * 3. Equal: count as skipped and return nullptr so no GL call is made
+ * 4. Different: store the new value and return the slot for the upload
+ */
+UniformSlot *Shader::updateShadow(const std::string &name, const void *data, size_t size) {
+    _frameStats.requests++;
+
+    auto it = _uniforms.find(name);
+    if (it == _uniforms.end()) {
+        if (_missingUniforms.insert(name).second) {
+            std::cerr << "Warning: uniform '" << name << "' not found!" << std::endl;
+        }
+        return nullptr;
+    }
+
+    UniformSlot &slot = it->second;
+    if (slot.valueSize == size && std::memcmp(slot.value, data, size) == 0) {
+        _frameStats.skipped++;
+        return nullptr;
+    }
+
+    std::memcpy(slot.value, data, size);
+    slot.valueSize = size;
+    _frameStats.uploads++;
+    return &slot;
 }
 
 /**
@@ -78,16 +195,46 @@ ShaderProgramSource Shader::parseShader(const std::string &filepath) {
 }
 
 /**
- * Compile Shader - Compiles individual shader (vertex or fragment)
+ * Apply Defines - Inserts preprocessor defines into a GLSL stage
+ * 
+ * FLOW:
+ * 1. Find the #version directive, which must stay the first statement
+ * 2. Insert the defines on the line right after it
+ * 3. Sources without #version get the defines prepended
+ */
+std::string Shader::applyDefines(const std::string &source, const std::vector<std::string> &defines) {
+	if (defines.empty()) {
+		return source;
+	}
+
+	std::string block;
+	for (const auto &define : defines) {
+		block += "#define " + define + "\n";
+	}
+
+	size_t version = source.find("#version");
+	if (version == std::string::npos) {
+		return block + source;
+	}
+
+	size_t lineEnd = source.find('\n', version);
+	if (lineEnd == std::string::npos) {
+		return source + "\n" + block;
+	}
+	return source.substr(0, lineEnd + 1) + block + source.substr(lineEnd + 1);
+}
+
+/**
+ * Compile Shader - Starts compiling an individual shader (vertex or fragment)
  * 
  * FLOW:
  * 1. Create shader object of specified type (GL_VERTEX_SHADER/GL_FRAGMENT_SHADER)
  * 2. Set shader source code from string
  * 3. Compile shader using OpenGL
- * 4. Check compilation status:
- *    - If successful: Return shader ID
- *    - If failed: Extract and log error message, cleanup shader, return 0
- * 5. Handle compilation errors with detailed logging
+ * 
+ * The status is not queried here: asking for it blocks until the compile is done, which
+ * would serialize drivers that compile in the background (KHR_parallel_shader_compile).
+ * checkShader() does that in finishCompile().
  */
 unsigned int Shader::compileShader(unsigned int type, const std::string &source) {
 	unsigned int id = glCreateShader(type);
@@ -95,88 +242,150 @@ unsigned int Shader::compileShader(unsigned int type, const std::string &source)
 	glShaderSource(id, 1, &src, nullptr);
 	glCompileShader(id);
 
+	return (id);
+}
+
+/**
+ * Check Shader - Reports the compilation result of a shader
+ * 
+ * FLOW:
+ * 1. Check compilation status
+ * 2. If failed: extract and log the error message
+ */
+bool Shader::checkShader(unsigned int id, unsigned int type) {
 	int result;
 	glGetShaderiv(id, GL_COMPILE_STATUS, &result);
 	if (result == GL_FALSE) {
 		int length;
 		glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
-		char *message = (char *)(alloca(length * sizeof(char)));
-		glGetShaderInfoLog(id, length, &length, message);
+		std::vector<char> message(static_cast<size_t>(std::max(length, 1)));
+		glGetShaderInfoLog(id, length, &length, message.data());
 		std::cerr << "Failed to compile "
 			<< (type == GL_VERTEX_SHADER ? "vertex" : "fragment")
 			<< " shader: "
-			<< message << "\n";
-		glDeleteShader(id);
-		return 0;
+			<< message.data() << "\n";
+		return false;
 	}
+	return true;
+}
 
-	return (id);
+/**
+ * Begin Compile - Gets the program object on its way without waiting for the driver
+ * 
+ * FLOW:
+ * 1. With program binary support, hash the sources into a cache key and try
+ *    ProgramCache::load(); a hit gives a linked program immediately
+ * 2. Otherwise create the program, compile both stages and link, flagging the
+ *    program as retrievable so its binary can be cached afterwards
+ * 3. No status is queried, so several shaders can be started back to back and the
+ *    driver compiles them in parallel where it supports it
+ */
+void Shader::beginCompile() {
+	_fromCache = false;
+	if (GLExtensions::programBinary) {
+		_cacheKey = ProgramCache::makeKey(_shaderSource.vertexSource, _shaderSource.fragmentSource);
+		_id = ProgramCache::load(_cacheKey);
+		if (_id) {
+			_fromCache = true;
+			return;
+		}
+	}
+
+	ProgramCache::recordMiss();
+	_id = glCreateProgram();
+	_vs = compileShader(GL_VERTEX_SHADER, _shaderSource.vertexSource);
+	_fs = compileShader(GL_FRAGMENT_SHADER, _shaderSource.fragmentSource);
+
+	glAttachShader(_id, _vs);
+	glAttachShader(_id, _fs);
+	if (GLExtensions::programBinary) {
+		GLExtensions::programParameteri(_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+	glLinkProgram(_id);
 }
 
 /**
- * Create Shader Program - Links vertex and fragment shaders into program
+ * Finish Compile - Waits for the program and prepares it for use
  * 
  * FLOW:
- * 1. Create OpenGL shader program object
- * 2. Compile vertex and fragment shaders from source strings
- * 3. Attach compiled shaders to program
- * 4. Link shaders into executable program
- * 5. Validate program for current OpenGL state
- * 6. Clean up individual shader objects (no longer needed after linking)
- * 7. Return linked program ID for rendering use
+ * 1. Programs built from source: report stage compile errors and the link log,
+ *    validate, release the stage objects and store the binary in the program cache
+ * 2. A stage that failed to compile or a program that failed to link is deleted and
+ *    false returned; the shader is left with no program (getID() == 0)
+ * 3. Wire uniform blocks to the shared binding points (not part of a program binary)
+ * 4. Reflect uniforms and make the program current
  */
-unsigned int Shader::createShader(const std::string &vertexShader, const std::string &fragmentShader) {
-	unsigned int program = glCreateProgram();
-	_vs = compileShader(GL_VERTEX_SHADER, vertexShader);
-	_fs = compileShader(GL_FRAGMENT_SHADER, fragmentShader);
+bool Shader::finishCompile() {
+	if (!_fromCache) {
+		bool compiled = checkShader(_vs, GL_VERTEX_SHADER);
+		compiled = checkShader(_fs, GL_FRAGMENT_SHADER) && compiled;
+
+		int linked = GL_FALSE;
+		if (compiled) {
+			glGetProgramiv(_id, GL_LINK_STATUS, &linked);
+		}
+		if (compiled && linked == GL_FALSE) {
+			int length = 0;
+			glGetProgramiv(_id, GL_INFO_LOG_LENGTH, &length);
+			std::vector<char> message(static_cast<size_t>(std::max(length, 1)));
+			glGetProgramInfoLog(_id, length, &length, message.data());
+			std::cerr << "Failed to link shader program: " << message.data() << "\n";
+		}
+		glValidateProgram(_id);
 
-	glAttachShader(program, _vs);
-	glAttachShader(program, _fs);
-	glLinkProgram(program);
-	glValidateProgram(program);
+		glDetachShader(_id, _vs);
+		glDetachShader(_id, _fs);
+		glDeleteShader(_vs);
+		glDeleteShader(_fs);
+		_vs = 0;
+		_fs = 0;
 
-	glDeleteShader(_vs);
-	glDeleteShader(_fs);
+		if (linked == GL_FALSE) {
+			GLState::deleteProgram(_id);
+			_id = 0;
+			return false;
+		}
+		if (GLExtensions::programBinary) {
+			ProgramCache::store(_cacheKey, _id);
+		}
+	}
+
+	UniformBuffer::bindProgramBlocks(_id);
+	reflectUniforms();
+	use();
+	return true;
+}
 
-	return (program);
+bool Shader::isFromCache() const {
+	return _fromCache;
 }
 
 void Shader::setUniform(const std::string& name, int value) {
-    GLint location = glGetUniformLocation(_id, name.c_str());
-    if (location == -1) {
-        std::cerr << "Warning: uniform '" << name << "' not found!" << std::endl;
+    if (UniformSlot *slot = updateShadow(name, &value, sizeof(value))) {
+        glUniform1i(slot->location, value);
     }
-    glUniform1i(location, value);
 }
 
 void Shader::setUniform(const std::string& name, float value) {
-    GLint location = glGetUniformLocation(_id, name.c_str());
-    if (location == -1) {
-        std::cerr << "Warning: uniform '" << name << "' not found!" << std::endl;
+    if (UniformSlot *slot = updateShadow(name, &value, sizeof(value))) {
+        glUniform1f(slot->location, value);
     }
-    glUniform1f(location, value);
 }
 
 void Shader::setUniform(const std::string& name, const glm::vec2& vector) {
-    GLint location = glGetUniformLocation(_id, name.c_str());
-    if (location == -1) {
-        std::cerr << "Warning: uniform '" << name << "' not found!" << std::endl;
+    if (UniformSlot *slot = updateShadow(name, glm::value_ptr(vector), sizeof(float) * 2)) {
+        glUniform2fv(slot->location, 1, glm::value_ptr(vector));
     }
-    glUniform2fv(location, 1, glm::value_ptr(vector));
 }
 
 void Shader::setUniform(const std::string& name, const glm::vec3& vector) {
-    GLint location = glGetUniformLocation(_id, name.c_str());
-    if (location == -1) {
-        std::cerr << "Warning: uniform '" << name << "' not found!" << std::endl;
+    if (UniformSlot *slot = updateShadow(name, glm::value_ptr(vector), sizeof(float) * 3)) {
+        glUniform3fv(slot->location, 1, glm::value_ptr(vector));
     }
-    glUniform3fv(location, 1, glm::value_ptr(vector));
 }
 
 void Shader::setUniform(const std::string& name, const glm::mat4& matrix) {
-    GLint location = glGetUniformLocation(_id, name.c_str());
-    if (location == -1) {
-        std::cerr << "Warning: uniform '" << name << "' not found!" << std::endl;
+    if (UniformSlot *slot = updateShadow(name, glm::value_ptr(matrix), sizeof(float) * 16)) {
+        glUniformMatrix4fv(slot->location, 1, GL_FALSE, glm::value_ptr(matrix));
     }
-    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
 }
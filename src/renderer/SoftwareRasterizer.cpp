@@ -0,0 +1,979 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SoftwareRasterizer.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/28 09:05:12 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/29 18:27:30 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/SoftwareRasterizer.hpp"
+#include "../../include/stb_image/stb_image.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+#if defined(__SSE2__)
+# include <emmintrin.h>
+#endif
+
+namespace {
+    const size_t VERTEX_BLOCK = 4096;
+    const size_t CHUNK_PRIMITIVES = 2048;
+    const float GUARD_PIXELS = 8192.0f;     // Half-extent of the guard band around the viewport centre
+
+    // Clip outcodes: frustum planes, then the guard band the fixed-point positions must stay in
+    const uint8_t CLIP_NEAR = 1;
+    const uint8_t CLIP_FAR = 2;
+    const uint8_t CLIP_LEFT = 4;
+    const uint8_t CLIP_RIGHT = 8;
+    const uint8_t CLIP_BOTTOM = 16;
+    const uint8_t CLIP_TOP = 32;
+    const uint8_t CLIP_GUARD_X = 64;
+    const uint8_t CLIP_GUARD_Y = 128;
+    const uint8_t CLIP_FRUSTUM = CLIP_NEAR | CLIP_FAR | CLIP_LEFT | CLIP_RIGHT | CLIP_BOTTOM | CLIP_TOP;
+    const uint8_t CLIP_REQUIRED = CLIP_NEAR | CLIP_FAR | CLIP_GUARD_X | CLIP_GUARD_Y;
+
+    const size_t MAX_CLIPPED_VERTICES = 3 + 6;
+
+    // Four lanes of floats / ints: SSE2 where available, plain arrays otherwise
+#if defined(__SSE2__)
+    struct Float4 {
+        __m128 v;
+        Float4(__m128 value) : v(value) {}
+        Float4(float value) : v(_mm_set1_ps(value)) {}
+    };
+    inline Float4 operator+(Float4 a, Float4 b) { return _mm_add_ps(a.v, b.v); }
+    inline Float4 operator-(Float4 a, Float4 b) { return _mm_sub_ps(a.v, b.v); }
+    inline Float4 operator*(Float4 a, Float4 b) { return _mm_mul_ps(a.v, b.v); }
+    inline Float4 operator/(Float4 a, Float4 b) { return _mm_div_ps(a.v, b.v); }
+    inline Float4 max4(Float4 a, Float4 b) { return _mm_max_ps(a.v, b.v); }
+    inline Float4 sqrt4(Float4 a) { return _mm_sqrt_ps(a.v); }
+    inline Float4 lanes4() { return _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f); }
+    inline Float4 load4(const float *p) { return _mm_loadu_ps(p); }
+    inline void store4(float *p, Float4 a) { _mm_storeu_ps(p, a.v); }
+    inline int lessMask(Float4 a, Float4 b) { return _mm_movemask_ps(_mm_cmplt_ps(a.v, b.v)); }
+
+    struct Int4 {
+        __m128i v;
+        Int4(__m128i value) : v(value) {}
+        Int4(int32_t value) : v(_mm_set1_epi32(value)) {}
+    };
+    inline Int4 operator+(Int4 a, Int4 b) { return _mm_add_epi32(a.v, b.v); }
+    inline Int4 steps4(int32_t step) { return _mm_set_epi32(3 * step, 2 * step, step, 0); }
+    inline int nonNegativeMask(Int4 a) { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(a.v, _mm_set1_epi32(-1)))); }
+#else
+    struct Float4 {
+        float v[4];
+        Float4() {}
+        Float4(float value) { v[0] = v[1] = v[2] = v[3] = value; }
+    };
+    template <typename Op>
+    inline Float4 apply4(Float4 a, Float4 b, Op op) {
+        Float4 r;
+        for (int i = 0; i < 4; ++i) r.v[i] = op(a.v[i], b.v[i]);
+        return r;
+    }
+    inline Float4 operator+(Float4 a, Float4 b) { return apply4(a, b, [](float x, float y) { return x + y; }); }
+    inline Float4 operator-(Float4 a, Float4 b) { return apply4(a, b, [](float x, float y) { return x - y; }); }
+    inline Float4 operator*(Float4 a, Float4 b) { return apply4(a, b, [](float x, float y) { return x * y; }); }
+    inline Float4 operator/(Float4 a, Float4 b) { return apply4(a, b, [](float x, float y) { return x / y; }); }
+    inline Float4 max4(Float4 a, Float4 b) { return apply4(a, b, [](float x, float y) { return x > y ? x : y; }); }
+    inline Float4 sqrt4(Float4 a) { return apply4(a, a, [](float x, float) { return std::sqrt(x); }); }
+    inline Float4 lanes4() { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = static_cast<float>(i); return r; }
+    inline Float4 load4(const float *p) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = p[i]; return r; }
+    inline void store4(float *p, Float4 a) { for (int i = 0; i < 4; ++i) p[i] = a.v[i]; }
+    inline int lessMask(Float4 a, Float4 b) {
+        int mask = 0;
+        for (int i = 0; i < 4; ++i) mask |= (a.v[i] < b.v[i]) << i;
+        return mask;
+    }
+
+    struct Int4 {
+        int32_t v[4];
+        Int4() {}
+        Int4(int32_t value) { v[0] = v[1] = v[2] = v[3] = value; }
+    };
+    inline Int4 operator+(Int4 a, Int4 b) { Int4 r; for (int i = 0; i < 4; ++i) r.v[i] = a.v[i] + b.v[i]; return r; }
+    inline Int4 steps4(int32_t step) { Int4 r; for (int i = 0; i < 4; ++i) r.v[i] = i * step; return r; }
+    inline int nonNegativeMask(Int4 a) {
+        int mask = 0;
+        for (int i = 0; i < 4; ++i) mask |= (a.v[i] >= 0) << i;
+        return mask;
+    }
+#endif
+
+    struct Vec4x3 {
+        Float4 x, y, z;
+    };
+
+    inline Float4 dot3(const Vec4x3 &a, const Vec4x3 &b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    inline Vec4x3 normalize3(const Vec4x3 &a) {
+        Float4 inverseLength = Float4(1.0f) / sqrt4(max4(dot3(a, a), Float4(1e-20f)));
+        return {a.x * inverseLength, a.y * inverseLength, a.z * inverseLength};
+    }
+
+    inline int32_t floorDiv(int32_t value, int32_t divisor) {
+        return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+    }
+
+    inline int32_t ceilDiv(int32_t value, int32_t divisor) {
+        return -floorDiv(-value, divisor);
+    }
+
+    inline uint8_t toUnorm8(float value) {
+        value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+        return static_cast<uint8_t>(value * 255.0f + 0.5f);
+    }
+
+    /**
+     * Bilinear sample with clamp to edge, as GL_LINEAR / GL_CLAMP_TO_EDGE without mipmaps.
+     */
+    glm::vec3 sampleTexture(const SoftwareTexture &texture, float u, float v) {
+        // Clamped first: far out-of-range (or NaN) coordinates would overflow the int casts
+        float x = std::fmin(std::fmax(u * static_cast<float>(texture.width) - 0.5f, -1.0f), static_cast<float>(texture.width));
+        float y = std::fmin(std::fmax(v * static_cast<float>(texture.height) - 0.5f, -1.0f), static_cast<float>(texture.height));
+        float fx = std::floor(x);
+        float fy = std::floor(y);
+        float tx = x - fx;
+        float ty = y - fy;
+
+        int x0 = std::min(std::max(static_cast<int>(fx), 0), texture.width - 1);
+        int y0 = std::min(std::max(static_cast<int>(fy), 0), texture.height - 1);
+        int x1 = std::min(std::max(static_cast<int>(fx) + 1, 0), texture.width - 1);
+        int y1 = std::min(std::max(static_cast<int>(fy) + 1, 0), texture.height - 1);
+
+        const uint8_t *texels = texture.texels.data();
+        auto texel = [&](int tx0, int ty0) {
+            const uint8_t *p = texels + (static_cast<size_t>(ty0) * static_cast<size_t>(texture.width) + static_cast<size_t>(tx0)) * 4;
+            return glm::vec3(p[0], p[1], p[2]);
+        };
+        glm::vec3 top = texel(x0, y0) + (texel(x1, y0) - texel(x0, y0)) * tx;
+        glm::vec3 bottom = texel(x0, y1) + (texel(x1, y1) - texel(x0, y1)) * tx;
+        return (top + (bottom - top) * ty) * (1.0f / 255.0f);
+    }
+}
+
+std::shared_ptr<SoftwareTexture> SoftwareTexture::load(const std::string &path) {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    unsigned char *data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+    if (!data) {
+        std::cerr << "Warning: could not load texture " << path << ": " << stbi_failure_reason() << std::endl;
+        return nullptr;
+    }
+
+    auto texture = std::make_shared<SoftwareTexture>();
+    texture->width = width;
+    texture->height = height;
+    texture->texels.assign(data, data + static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+    stbi_image_free(data);
+    return texture;
+}
+
+SoftwareRasterizer::SoftwareRasterizer(size_t threads)
+    : _threads(threads), _width(0), _height(0), _stride(0), _tilesX(0), _tilesY(0), _guardX(1.0f), _guardY(1.0f),
+      _clearColor(0.0f), _viewProjection(1.0f), _normalMatrix(1.0f), _job(nullptr), _jobCount(0), _nextJob(0),
+      _generation(0), _busy(0), _stopping(false) {
+    if (_threads == 0) {
+        _threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    _stats.threads = _threads;
+    for (size_t w = 1; w < _threads; ++w) {
+        _workers.emplace_back(&SoftwareRasterizer::workerLoop, this);
+    }
+}
+
+SoftwareRasterizer::~SoftwareRasterizer() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _workReady.notify_all();
+    for (std::thread &worker : _workers) {
+        worker.join();
+    }
+}
+
+/**
+ * Resize - Allocates the color and depth buffers
+ *
+ * Rows are padded by four pixels so the last group of four lanes in a row can always be
+ * loaded and stored whole. The guard band is expressed in NDC units of this size.
+ */
+bool SoftwareRasterizer::resize(int width, int height) {
+    if (width <= 0 || height <= 0 || width > MAX_SIZE || height > MAX_SIZE) {
+        std::cerr << "Software rasterizer: unsupported size " << width << "x" << height
+                  << " (1 to " << MAX_SIZE << " pixels per side)" << std::endl;
+        return false;
+    }
+
+    _width = width;
+    _height = height;
+    _stride = ((width + 3) & ~3) + 4;
+    _tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    _tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    _guardX = GUARD_PIXELS / (0.5f * static_cast<float>(width));
+    _guardY = GUARD_PIXELS / (0.5f * static_cast<float>(height));
+    _color.assign(static_cast<size_t>(_stride) * static_cast<size_t>(height) * 4, 0);
+    _depth.assign(static_cast<size_t>(_stride) * static_cast<size_t>(height), 1.0f);
+    _stats.tiles = static_cast<size_t>(_tilesX) * static_cast<size_t>(_tilesY);
+    return true;
+}
+
+void SoftwareRasterizer::beginFrame(const SoftwareFrameData &frame, const glm::vec3 &clearColor) {
+    _frame = frame;
+    _clearColor = clearColor;
+    _viewProjection = frame.projection * frame.view;
+    _normalMatrix = glm::transpose(glm::inverse(glm::mat3(frame.model)));
+    _commands.clear();
+    _sources.clear();
+}
+
+void SoftwareRasterizer::submitTriangles(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices,
+                                         const glm::vec3 &color, const SoftwareTexture *texture) {
+    Command command = {&vertices, &indices, false, color, texture, 0};
+    _commands.push_back(command);
+}
+
+void SoftwareRasterizer::submitLines(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices, const glm::vec3 &color) {
+    Command command = {&vertices, &indices, true, color, nullptr, 0};
+    _commands.push_back(command);
+}
+
+/**
+ * Worker Loop - Runs every job batch published by parallelFor until the rasterizer is destroyed
+ *
+ * FLOW:
+ * 1. Sleep until a new batch is published (generation changes) or shutdown
+ * 2. Take job indices until the batch is exhausted
+ * 3. The last worker to finish wakes the dispatching thread
+ */
+void SoftwareRasterizer::workerLoop() {
+    size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _workReady.wait(lock, [this, seen] { return _stopping || _generation != seen; });
+            if (_stopping) {
+                return;
+            }
+            seen = _generation;
+        }
+
+        runJobs();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (--_busy == 0) {
+            _workDone.notify_one();
+        }
+    }
+}
+
+void SoftwareRasterizer::runJobs() {
+    for (size_t i = _nextJob++; i < _jobCount; i = _nextJob++) {
+        (*_job)(i);
+    }
+}
+
+/**
+ * Parallel For - Runs job(0) .. job(count - 1) on the worker pool and the calling thread
+ *
+ * FLOW:
+ * 1. A single job, or no workers: run inline
+ * 2. Publish the batch under the lock and wake the workers
+ * 3. Take jobs on the calling thread too, then wait until every worker has left the batch,
+ *    so the next batch never races a straggler on the shared job counter
+ */
+void SoftwareRasterizer::parallelFor(size_t count, const std::function<void(size_t)> &job) {
+    if (_workers.empty() || count < 2) {
+        for (size_t i = 0; i < count; ++i) {
+            job(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _job = &job;
+        _jobCount = count;
+        _nextJob = 0;
+        _busy = _workers.size();
+        _generation++;
+    }
+    _workReady.notify_all();
+
+    runJobs();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _workDone.wait(lock, [this] { return _busy == 0; });
+    _job = nullptr;
+}
+
+uint8_t SoftwareRasterizer::outcode(const glm::vec4 &clip) const {
+    uint8_t code = 0;
+    if (clip.z < -clip.w) code |= CLIP_NEAR;
+    if (clip.z > clip.w) code |= CLIP_FAR;
+    if (clip.x < -clip.w) code |= CLIP_LEFT;
+    if (clip.x > clip.w) code |= CLIP_RIGHT;
+    if (clip.y < -clip.w) code |= CLIP_BOTTOM;
+    if (clip.y > clip.w) code |= CLIP_TOP;
+    if (std::fabs(clip.x) > _guardX * clip.w) code |= CLIP_GUARD_X;
+    if (std::fabs(clip.y) > _guardY * clip.w) code |= CLIP_GUARD_Y;
+    return code;
+}
+
+/**
+ * Project - Perspective divide and viewport transform of a vertex inside the guard band
+ *
+ * The position is snapped to the subpixel grid; attributes are divided by w so they
+ * interpolate linearly in screen space and are corrected per pixel.
+ */
+SoftwareRasterizer::ScreenVertex SoftwareRasterizer::project(const ClipVertex &vertex) const {
+    const float scale = static_cast<float>(1 << SUBPIXEL_BITS);
+    float invW = 1.0f / vertex.clip.w;
+
+    ScreenVertex screen;
+    screen.x = static_cast<int32_t>(std::floor((vertex.clip.x * invW * 0.5f + 0.5f) * static_cast<float>(_width) * scale + 0.5f));
+    screen.y = static_cast<int32_t>(std::floor((vertex.clip.y * invW * 0.5f + 0.5f) * static_cast<float>(_height) * scale + 0.5f));
+    screen.z = vertex.clip.z * invW * 0.5f + 0.5f;
+    screen.invW = invW;
+    screen.attributes[0] = vertex.world.x * invW;
+    screen.attributes[1] = vertex.world.y * invW;
+    screen.attributes[2] = vertex.world.z * invW;
+    screen.attributes[3] = vertex.normal.x * invW;
+    screen.attributes[4] = vertex.normal.y * invW;
+    screen.attributes[5] = vertex.normal.z * invW;
+    screen.attributes[6] = vertex.uv.x * invW;
+    screen.attributes[7] = vertex.uv.y * invW;
+    return screen;
+}
+
+/**
+ * Transform - Vertex stage for one block of a source's vertices
+ *
+ * Same math as the vertex shader (world position, normal matrix, clip position). Vertices
+ * that need no clipping are projected right away; the others are projected per primitive
+ * after clipping.
+ */
+void SoftwareRasterizer::transform(size_t sourceIndex, size_t first, size_t count) {
+    Source &source = _sources[sourceIndex];
+    const std::vector<Vertex> &vertices = *source.vertices;
+
+    for (size_t i = first; i < first + count; ++i) {
+        glm::vec4 world = _frame.model * glm::vec4(vertices[i].position, 1.0f);
+
+        ClipVertex &clip = source.clip[i];
+        clip.clip = _viewProjection * world;
+        clip.world = glm::vec3(world);
+        clip.normal = _normalMatrix * vertices[i].normal;
+        clip.uv = vertices[i].texCoord;
+
+        source.outcodes[i] = outcode(clip.clip);
+        if (!(source.outcodes[i] & CLIP_REQUIRED)) {
+            source.screen[i] = project(clip);
+        }
+    }
+}
+
+/**
+ * Clip Primitive - Clips a triangle or line against the near/far planes and the guard band
+ *
+ * FLOW:
+ * 1. Sutherland-Hodgman against each plane the primitive crosses; attributes are
+ *    interpolated in clip space, where they are still linear
+ * 2. Project the surviving vertices into the chunk's own vertex list
+ * 3. Emit a triangle fan (or the clipped segment) referencing them
+ */
+void SoftwareRasterizer::clipPrimitive(Chunk &chunk, const Source &source, const unsigned int *indices, size_t vertexCount, uint8_t planes) {
+    ClipVertex polygon[MAX_CLIPPED_VERTICES];
+    ClipVertex clipped[MAX_CLIPPED_VERTICES];
+    size_t count = vertexCount;
+    for (size_t i = 0; i < vertexCount; ++i) {
+        polygon[i] = source.clip[indices[i]];
+    }
+
+    auto lerp = [](const ClipVertex &a, const ClipVertex &b, float t) {
+        ClipVertex r;
+        r.clip = a.clip + (b.clip - a.clip) * t;
+        r.world = a.world + (b.world - a.world) * t;
+        r.normal = a.normal + (b.normal - a.normal) * t;
+        r.uv = a.uv + (b.uv - a.uv) * t;
+        return r;
+    };
+
+    // Signed distances (inside >= 0) of the six clipping planes
+    const float guardX = _guardX;
+    const float guardY = _guardY;
+    auto distance = [guardX, guardY](int plane, const glm::vec4 &c) {
+        switch (plane) {
+            case 0:  return c.z + c.w;
+            case 1:  return c.w - c.z;
+            case 2:  return c.x + guardX * c.w;
+            case 3:  return guardX * c.w - c.x;
+            case 4:  return c.y + guardY * c.w;
+            default: return guardY * c.w - c.y;
+        }
+    };
+    const uint8_t planeMasks[6] = {CLIP_NEAR, CLIP_FAR, CLIP_GUARD_X, CLIP_GUARD_X, CLIP_GUARD_Y, CLIP_GUARD_Y};
+
+    for (int plane = 0; plane < 6; ++plane) {
+        if (!(planes & planeMasks[plane])) {
+            continue;
+        }
+
+        if (vertexCount == 2) {
+            float d0 = distance(plane, polygon[0].clip);
+            float d1 = distance(plane, polygon[1].clip);
+            if (d0 < 0.0f && d1 < 0.0f) {
+                return;
+            }
+            if (d0 < 0.0f) {
+                polygon[0] = lerp(polygon[0], polygon[1], d0 / (d0 - d1));
+            } else if (d1 < 0.0f) {
+                polygon[1] = lerp(polygon[0], polygon[1], d0 / (d0 - d1));
+            }
+            continue;
+        }
+
+        size_t out = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const ClipVertex &current = polygon[i];
+            const ClipVertex &next = polygon[(i + 1) % count];
+            float dc = distance(plane, current.clip);
+            float dn = distance(plane, next.clip);
+            if (dc >= 0.0f) {
+                clipped[out++] = current;
+            }
+            if ((dc >= 0.0f) != (dn >= 0.0f)) {
+                clipped[out++] = lerp(current, next, dc / (dc - dn));
+            }
+        }
+        count = out;
+        if (count < 3) {
+            return;
+        }
+        std::copy(clipped, clipped + count, polygon);
+    }
+
+    uint32_t base = static_cast<uint32_t>(chunk.vertices.size());
+    for (size_t i = 0; i < count; ++i) {
+        chunk.vertices.push_back(project(polygon[i]));
+    }
+
+    if (vertexCount == 2) {
+        chunk.primitives.push_back({{base | CLIPPED_VERTEX, (base + 1) | CLIPPED_VERTEX, 0}});
+        return;
+    }
+    for (size_t i = 1; i + 1 < count; ++i) {
+        chunk.primitives.push_back({{base | CLIPPED_VERTEX, static_cast<uint32_t>(base + i) | CLIPPED_VERTEX,
+                                     static_cast<uint32_t>(base + i + 1) | CLIPPED_VERTEX}});
+    }
+}
+
+/**
+ * Setup Chunk - Culls, clips and collects the primitives of one chunk
+ *
+ * FLOW:
+ * 1. Skip primitives with out-of-range indices
+ * 2. Trivially reject primitives entirely outside one frustum plane
+ * 3. Clip the ones crossing the near/far planes or the guard band; the rest reference the
+ *    source's projected vertices directly
+ * 4. Drop triangles with no area once snapped (nothing to rasterize); no face culling,
+ *    the viewer draws both sides
+ */
+void SoftwareRasterizer::setupChunk(Chunk &chunk) {
+    const Command &command = _commands[chunk.command];
+    const Source &source = _sources[command.source];
+    const std::vector<unsigned int> &indices = *command.indices;
+    const size_t vertexCount = source.clip.size();
+    const size_t stride = command.lines ? 2 : 3;
+
+    chunk.primitives.clear();
+    chunk.vertices.clear();
+    for (size_t p = chunk.first; p < chunk.first + chunk.count; ++p) {
+        const unsigned int *primitive = &indices[p * stride];
+        uint8_t all = 0xFF;
+        uint8_t any = 0;
+        bool valid = true;
+        for (size_t i = 0; i < stride; ++i) {
+            if (primitive[i] >= vertexCount) {
+                valid = false;
+                break;
+            }
+            all &= source.outcodes[primitive[i]];
+            any |= source.outcodes[primitive[i]];
+        }
+        if (!valid || (all & CLIP_FRUSTUM)) {
+            continue;
+        }
+
+        if (any & CLIP_REQUIRED) {
+            clipPrimitive(chunk, source, primitive, stride, any & CLIP_REQUIRED);
+            continue;
+        }
+
+        if (!command.lines) {
+            const ScreenVertex &a = source.screen[primitive[0]];
+            const ScreenVertex &b = source.screen[primitive[1]];
+            const ScreenVertex &c = source.screen[primitive[2]];
+            int64_t area = static_cast<int64_t>(b.x - a.x) * (c.y - a.y) - static_cast<int64_t>(c.x - a.x) * (b.y - a.y);
+            if (area == 0) {
+                continue;
+            }
+        }
+        chunk.primitives.push_back({{primitive[0], primitive[1], command.lines ? 0u : primitive[2]}});
+    }
+}
+
+const SoftwareRasterizer::ScreenVertex &SoftwareRasterizer::fetch(const Chunk &chunk, uint32_t index) const {
+    if (index & CLIPPED_VERTEX) {
+        return chunk.vertices[index & ~CLIPPED_VERTEX];
+    }
+    return _sources[_commands[chunk.command].source].screen[index];
+}
+
+/**
+ * Bin Chunk - Sorts the chunk's primitives into per-tile lists
+ *
+ * A counting sort over the tiles each primitive's pixel bounds overlap: one pass counts,
+ * the prefix sum gives each tile's range in the binned array, a second pass fills it.
+ * Within a tile the chunk's primitives keep their submission order.
+ */
+void SoftwareRasterizer::binChunk(Chunk &chunk) {
+    const Command &command = _commands[chunk.command];
+    const size_t tileCount = static_cast<size_t>(_tilesX) * static_cast<size_t>(_tilesY);
+    const int32_t one = 1 << SUBPIXEL_BITS;
+    const size_t vertexCount = command.lines ? 2 : 3;
+
+    auto tileRange = [&](const Primitive &primitive, int range[4]) {
+        int32_t minX = INT32_MAX, minY = INT32_MAX, maxX = INT32_MIN, maxY = INT32_MIN;
+        for (size_t i = 0; i < vertexCount; ++i) {
+            const ScreenVertex &v = fetch(chunk, primitive.vertices[i]);
+            minX = std::min(minX, v.x);
+            minY = std::min(minY, v.y);
+            maxX = std::max(maxX, v.x);
+            maxY = std::max(maxY, v.y);
+        }
+        int px0 = std::max(floorDiv(minX, one), 0);
+        int py0 = std::max(floorDiv(minY, one), 0);
+        int px1 = std::min(floorDiv(maxX, one), _width - 1);
+        int py1 = std::min(floorDiv(maxY, one), _height - 1);
+        if (px0 > px1 || py0 > py1) {
+            return false;
+        }
+        range[0] = px0 / TILE_SIZE;
+        range[1] = py0 / TILE_SIZE;
+        range[2] = px1 / TILE_SIZE;
+        range[3] = py1 / TILE_SIZE;
+        return true;
+    };
+
+    chunk.tileStart.assign(tileCount + 1, 0);
+    int range[4];
+    for (const Primitive &primitive : chunk.primitives) {
+        if (!tileRange(primitive, range)) continue;
+        for (int ty = range[1]; ty <= range[3]; ++ty) {
+            for (int tx = range[0]; tx <= range[2]; ++tx) {
+                chunk.tileStart[static_cast<size_t>(ty * _tilesX + tx) + 1]++;
+            }
+        }
+    }
+    for (size_t t = 0; t < tileCount; ++t) {
+        chunk.tileStart[t + 1] += chunk.tileStart[t];
+    }
+
+    chunk.binned.resize(chunk.tileStart[tileCount]);
+    std::vector<uint32_t> cursor(chunk.tileStart.begin(), chunk.tileStart.end() - 1);
+    for (size_t p = 0; p < chunk.primitives.size(); ++p) {
+        if (!tileRange(chunk.primitives[p], range)) continue;
+        for (int ty = range[1]; ty <= range[3]; ++ty) {
+            for (int tx = range[0]; tx <= range[2]; ++tx) {
+                chunk.binned[cursor[static_cast<size_t>(ty * _tilesX + tx)]++] = static_cast<uint32_t>(p);
+            }
+        }
+    }
+}
+
+/**
+ * Raster Triangle - Rasterizes the part of a triangle inside one tile, four pixels at a time
+ *
+ * FLOW:
+ * 1. Orient counter-clockwise (both sides are drawn) and clamp the pixel bounds to the tile
+ * 2. Edge functions in fixed point at the first pixel centre, with the top-left fill rule
+ *    as a -1 bias on edges that do not own their pixels, so shared edges draw once
+ * 3. Per edge, evaluate the bounds' corners: all negative rejects the triangle for this
+ *    tile, all non-negative drops the edge from the per-pixel test. Edges left cross the
+ *    tile, which bounds their values well within 32 bits
+ * 4. Per row, step the 32-bit edge values four lanes at a time for the coverage mask
+ * 5. Interpolate depth (screen-linear) and test GL_LESS; shade surviving lanes with the
+ *    3D.shader Phong model, attributes perspective-corrected through 1/w
+ */
+void SoftwareRasterizer::rasterTriangle(const Tile &tile, const ScreenVertex *v0, const ScreenVertex *v1, const ScreenVertex *v2, const Command &command) {
+    int64_t area = static_cast<int64_t>(v1->x - v0->x) * (v2->y - v0->y) - static_cast<int64_t>(v2->x - v0->x) * (v1->y - v0->y);
+    if (area == 0) {
+        return;
+    }
+    if (area < 0) {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    const int32_t one = 1 << SUBPIXEL_BITS;
+    const int32_t half = one >> 1;
+    int px0 = std::max(tile.x0, ceilDiv(std::min({v0->x, v1->x, v2->x}) - half, one));
+    int py0 = std::max(tile.y0, ceilDiv(std::min({v0->y, v1->y, v2->y}) - half, one));
+    int px1 = std::min(tile.x1 - 1, floorDiv(std::max({v0->x, v1->x, v2->x}) - half, one));
+    int py1 = std::min(tile.y1 - 1, floorDiv(std::max({v0->y, v1->y, v2->y}) - half, one));
+    if (px0 > px1 || py0 > py1) {
+        return;
+    }
+    // Spans start 4-aligned within the tile so the 4-wide depth loads never reach a neighbour tile
+    px0 = tile.x0 + ((px0 - tile.x0) & ~3);
+
+    const ScreenVertex *v[3] = {v0, v1, v2};
+    const int64_t originX = static_cast<int64_t>(px0) * one + half;
+    const int64_t originY = static_cast<int64_t>(py0) * one + half;
+    const int64_t width = px1 - px0;
+    const int64_t height = py1 - py0;
+
+    int64_t edgeOrigin[3];
+    int64_t edgeStepX[3];
+    int64_t edgeStepY[3];
+    int32_t partialValue[3];
+    int32_t partialStepX[3];
+    int32_t partialStepY[3];
+    int partial = 0;
+
+    for (int k = 0; k < 3; ++k) {
+        const ScreenVertex *a = v[(k + 1) % 3];
+        const ScreenVertex *b = v[(k + 2) % 3];
+        int64_t dx = b->x - a->x;
+        int64_t dy = b->y - a->y;
+
+        edgeOrigin[k] = dx * (originY - a->y) - dy * (originX - a->x);
+        edgeStepX[k] = -dy * one;
+        edgeStepY[k] = dx * one;
+
+        int64_t biased = edgeOrigin[k] + ((dy > 0 || (dy == 0 && dx < 0)) ? 0 : -1);
+        int64_t corners[4] = {biased, biased + edgeStepX[k] * width, biased + edgeStepY[k] * height,
+                              biased + edgeStepX[k] * width + edgeStepY[k] * height};
+        int64_t low = std::min({corners[0], corners[1], corners[2], corners[3]});
+        int64_t high = std::max({corners[0], corners[1], corners[2], corners[3]});
+        if (high < 0) {
+            return;
+        }
+        if (low >= 0) {
+            continue;
+        }
+        partialValue[partial] = static_cast<int32_t>(biased);
+        partialStepX[partial] = static_cast<int32_t>(edgeStepX[k]);
+        partialStepY[partial] = static_cast<int32_t>(edgeStepY[k]);
+        partial++;
+    }
+
+    // Barycentric planes of v1 and v2 (v0 takes the rest) relative to the first pixel
+    const double inverseArea = 1.0 / static_cast<double>(area);
+    const float b1Origin = static_cast<float>(static_cast<double>(edgeOrigin[1]) * inverseArea);
+    const float b1StepX = static_cast<float>(static_cast<double>(edgeStepX[1]) * inverseArea);
+    const float b1StepY = static_cast<float>(static_cast<double>(edgeStepY[1]) * inverseArea);
+    const float b2Origin = static_cast<float>(static_cast<double>(edgeOrigin[2]) * inverseArea);
+    const float b2StepX = static_cast<float>(static_cast<double>(edgeStepX[2]) * inverseArea);
+    const float b2StepY = static_cast<float>(static_cast<double>(edgeStepY[2]) * inverseArea);
+
+    const float z0 = v0->z, zd1 = v1->z - v0->z, zd2 = v2->z - v0->z;
+    const float w0 = v0->invW, wd1 = v1->invW - v0->invW, wd2 = v2->invW - v0->invW;
+    const size_t attributeCount = command.texture ? 8 : 6;
+    float a0[8], ad1[8], ad2[8];
+    for (size_t i = 0; i < attributeCount; ++i) {
+        a0[i] = v0->attributes[i];
+        ad1[i] = v1->attributes[i] - v0->attributes[i];
+        ad2[i] = v2->attributes[i] - v0->attributes[i];
+    }
+
+    const Float4 lanes = lanes4();
+    const Int4 laneSteps[3] = {steps4(partial > 0 ? partialStepX[0] : 0), steps4(partial > 1 ? partialStepX[1] : 0),
+                               steps4(partial > 2 ? partialStepX[2] : 0)};
+    const Vec4x3 lightPos = {Float4(_frame.lightPos.x), Float4(_frame.lightPos.y), Float4(_frame.lightPos.z)};
+    const Vec4x3 viewPos = {Float4(_frame.viewPos.x), Float4(_frame.viewPos.y), Float4(_frame.viewPos.z)};
+    const glm::vec3 light = _frame.lightColor;
+
+    for (int py = py0; py <= py1; ++py) {
+        const int32_t rowOffset = py - py0;
+        int32_t rowEdge[3];
+        for (int k = 0; k < partial; ++k) {
+            rowEdge[k] = partialValue[k] + partialStepY[k] * rowOffset;
+        }
+        const float rowB1 = b1Origin + b1StepY * static_cast<float>(rowOffset);
+        const float rowB2 = b2Origin + b2StepY * static_cast<float>(rowOffset);
+        float *depthRow = &_depth[static_cast<size_t>(py) * static_cast<size_t>(_stride)];
+        uint8_t *colorRow = &_color[static_cast<size_t>(py) * static_cast<size_t>(_stride) * 4];
+
+        for (int px = px0; px <= px1; px += 4) {
+            const int32_t columnOffset = px - px0;
+            int mask = px1 - px >= 3 ? 0xF : (1 << (px1 - px + 1)) - 1;
+            for (int k = 0; k < partial; ++k) {
+                mask &= nonNegativeMask(Int4(rowEdge[k] + partialStepX[k] * columnOffset) + laneSteps[k]);
+            }
+            if (!mask) {
+                continue;
+            }
+
+            const Float4 fx = Float4(static_cast<float>(columnOffset)) + lanes;
+            const Float4 b1 = Float4(rowB1) + Float4(b1StepX) * fx;
+            const Float4 b2 = Float4(rowB2) + Float4(b2StepX) * fx;
+            const Float4 z = Float4(z0) + b1 * Float4(zd1) + b2 * Float4(zd2);
+            mask &= lessMask(z, load4(depthRow + px));
+            if (!mask) {
+                continue;
+            }
+
+            const Float4 w = Float4(1.0f) / (Float4(w0) + b1 * Float4(wd1) + b2 * Float4(wd2));
+            Float4 attribute[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+            for (size_t i = 0; i < attributeCount; ++i) {
+                attribute[i] = (Float4(a0[i]) + b1 * Float4(ad1[i]) + b2 * Float4(ad2[i])) * w;
+            }
+
+            const Vec4x3 world = {attribute[0], attribute[1], attribute[2]};
+            const Vec4x3 normal = normalize3({attribute[3], attribute[4], attribute[5]});
+            const Vec4x3 lightDir = normalize3({lightPos.x - world.x, lightPos.y - world.y, lightPos.z - world.z});
+            const Vec4x3 viewDir = normalize3({viewPos.x - world.x, viewPos.y - world.y, viewPos.z - world.z});
+
+            const Float4 nDotL = dot3(normal, lightDir);
+            const Float4 diffuse = max4(nDotL, Float4(0.0f));
+            const Float4 twoNDotL = nDotL + nDotL;
+            const Vec4x3 reflectDir = {normal.x * twoNDotL - lightDir.x, normal.y * twoNDotL - lightDir.y, normal.z * twoNDotL - lightDir.z};
+            Float4 specular = max4(dot3(viewDir, reflectDir), Float4(0.0f));
+            for (int i = 0; i < 5; ++i) {
+                specular = specular * specular;  // pow(x, 32)
+            }
+            const Float4 intensity = Float4(0.5f) + diffuse + specular * Float4(0.2f);   // ambient + diffuse + specular, times the light color
+
+            float depth[4], light4[4], u[4], vCoord[4];
+            store4(depth, z);
+            store4(light4, intensity);
+            if (command.texture) {
+                store4(u, attribute[6]);
+                store4(vCoord, attribute[7]);
+            }
+
+            for (int lane = 0; lane < 4; ++lane) {
+                if (!(mask & (1 << lane))) {
+                    continue;
+                }
+                glm::vec3 base = command.texture ? sampleTexture(*command.texture, u[lane], vCoord[lane]) : command.color;
+                glm::vec3 result = light * light4[lane] * base;
+                uint8_t *pixel = colorRow + static_cast<size_t>(px + lane) * 4;
+                pixel[0] = toUnorm8(result.r);
+                pixel[1] = toUnorm8(result.g);
+                pixel[2] = toUnorm8(result.b);
+                pixel[3] = 255;
+                depthRow[px + lane] = depth[lane];
+            }
+        }
+    }
+}
+
+/**
+ * Raster Line - Draws the part of a one pixel wide line inside one tile
+ *
+ * Steps along the major axis through every pixel centre between the endpoints (last one
+ * excluded, as GL's diamond-exit rule does), four pixels at a time for the minor coordinate
+ * and depth; the depth-tested writes are scattered per lane. Pixels outside the tile are
+ * left to the tiles that own them.
+ */
+void SoftwareRasterizer::rasterLine(const Tile &tile, const ScreenVertex *v0, const ScreenVertex *v1, const Command &command) {
+    const float scale = 1.0f / static_cast<float>(1 << SUBPIXEL_BITS);
+    float start[2] = {static_cast<float>(v0->x) * scale, static_cast<float>(v0->y) * scale};
+    float end[2] = {static_cast<float>(v1->x) * scale, static_cast<float>(v1->y) * scale};
+    float startZ = v0->z;
+    float endZ = v1->z;
+
+    int major = std::fabs(end[0] - start[0]) >= std::fabs(end[1] - start[1]) ? 0 : 1;
+    int minor = 1 - major;
+    if (end[major] < start[major]) {
+        std::swap(start, end);
+        std::swap(startZ, endZ);
+    }
+    float length = end[major] - start[major];
+    if (length <= 0.0f) {
+        return;
+    }
+
+    const int tileMin[2] = {tile.x0, tile.y0};
+    const int tileMax[2] = {tile.x1 - 1, tile.y1 - 1};
+    int first = std::max(static_cast<int>(std::ceil(start[major] - 0.5f)), tileMin[major]);
+    int last = std::min(static_cast<int>(std::ceil(end[major] - 0.5f)) - 1, tileMax[major]);
+    if (first > last) {
+        return;
+    }
+
+    const float slope = (end[minor] - start[minor]) / length;
+    const float depthSlope = (endZ - startZ) / length;
+    const uint8_t color[3] = {toUnorm8(command.color.r), toUnorm8(command.color.g), toUnorm8(command.color.b)};
+    const Float4 lanes = lanes4();
+
+    for (int p = first; p <= last; p += 4) {
+        const Float4 distance = Float4(static_cast<float>(p) + 0.5f - start[major]) + lanes;
+        float minorCoord[4], depth[4];
+        store4(minorCoord, Float4(start[minor]) + distance * Float4(slope));
+        store4(depth, Float4(startZ) + distance * Float4(depthSlope));
+
+        for (int lane = 0; lane < 4 && p + lane <= last; ++lane) {
+            int q = static_cast<int>(std::floor(minorCoord[lane]));
+            if (q < tileMin[minor] || q > tileMax[minor]) {
+                continue;
+            }
+            int x = major == 0 ? p + lane : q;
+            int y = major == 0 ? q : p + lane;
+            size_t index = static_cast<size_t>(y) * static_cast<size_t>(_stride) + static_cast<size_t>(x);
+            if (!(depth[lane] < _depth[index])) {
+                continue;
+            }
+            _depth[index] = depth[lane];
+            uint8_t *pixel = &_color[index * 4];
+            pixel[0] = color[0];
+            pixel[1] = color[1];
+            pixel[2] = color[2];
+            pixel[3] = 255;
+        }
+    }
+}
+
+/**
+ * Raster Tile - Clears one tile and replays every chunk's primitives binned to it
+ */
+void SoftwareRasterizer::rasterTile(size_t tileIndex) {
+    Tile tile;
+    tile.x0 = static_cast<int>(tileIndex % static_cast<size_t>(_tilesX)) * TILE_SIZE;
+    tile.y0 = static_cast<int>(tileIndex / static_cast<size_t>(_tilesX)) * TILE_SIZE;
+    tile.x1 = std::min(tile.x0 + TILE_SIZE, _width);
+    tile.y1 = std::min(tile.y0 + TILE_SIZE, _height);
+
+    const uint8_t clear[4] = {toUnorm8(_clearColor.r), toUnorm8(_clearColor.g), toUnorm8(_clearColor.b), 255};
+    for (int y = tile.y0; y < tile.y1; ++y) {
+        size_t row = static_cast<size_t>(y) * static_cast<size_t>(_stride);
+        std::fill(_depth.begin() + static_cast<std::ptrdiff_t>(row + static_cast<size_t>(tile.x0)),
+                  _depth.begin() + static_cast<std::ptrdiff_t>(row + static_cast<size_t>(tile.x1)), 1.0f);
+        for (int x = tile.x0; x < tile.x1; ++x) {
+            std::copy(clear, clear + 4, &_color[(row + static_cast<size_t>(x)) * 4]);
+        }
+    }
+
+    for (const Chunk &chunk : _chunks) {
+        const Command &command = _commands[chunk.command];
+        for (uint32_t i = chunk.tileStart[tileIndex]; i < chunk.tileStart[tileIndex + 1]; ++i) {
+            const Primitive &primitive = chunk.primitives[chunk.binned[i]];
+            const ScreenVertex &a = fetch(chunk, primitive.vertices[0]);
+            const ScreenVertex &b = fetch(chunk, primitive.vertices[1]);
+            if (command.lines) {
+                rasterLine(tile, &a, &b, command);
+            } else {
+                rasterTriangle(tile, &a, &b, &fetch(chunk, primitive.vertices[2]), command);
+            }
+        }
+    }
+}
+
+/**
+ * Flush - Renders the submitted draws into the color and depth buffers
+ *
+ * FLOW:
+ * 1. One source per distinct vertex array (material groups share the mesh's vertices),
+ *    transformed in parallel blocks
+ * 2. Every draw is cut into fixed-size chunks, set up and binned in parallel; the chunk
+ *    size does not depend on the thread count, so neither does the image
+ * 3. Tiles are rasterized in parallel, each by one thread, so no pixel is shared
+ */
+void SoftwareRasterizer::flush() {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+
+    for (Command &command : _commands) {
+        auto source = std::find_if(_sources.begin(), _sources.end(), [&](const Source &s) { return s.vertices == command.vertices; });
+        command.source = static_cast<size_t>(source - _sources.begin());
+        if (source == _sources.end()) {
+            Source created;
+            created.vertices = command.vertices;
+            created.screen.resize(command.vertices->size());
+            created.clip.resize(command.vertices->size());
+            created.outcodes.resize(command.vertices->size());
+            _sources.push_back(std::move(created));
+        }
+    }
+
+    std::vector<std::pair<size_t, size_t>> blocks;
+    for (size_t s = 0; s < _sources.size(); ++s) {
+        for (size_t first = 0; first < _sources[s].clip.size(); first += VERTEX_BLOCK) {
+            blocks.emplace_back(s, first);
+        }
+    }
+    parallelFor(blocks.size(), [&](size_t i) {
+        size_t count = std::min(VERTEX_BLOCK, _sources[blocks[i].first].clip.size() - blocks[i].second);
+        transform(blocks[i].first, blocks[i].second, count);
+    });
+    auto transformed = Clock::now();
+
+    size_t chunkCount = 0;
+    for (size_t c = 0; c < _commands.size(); ++c) {
+        size_t primitives = _commands[c].indices->size() / (_commands[c].lines ? 2 : 3);
+        for (size_t first = 0; first < primitives; first += CHUNK_PRIMITIVES) {
+            if (chunkCount == _chunks.size()) {
+                _chunks.emplace_back();
+            }
+            Chunk &chunk = _chunks[chunkCount++];
+            chunk.command = c;
+            chunk.first = first;
+            chunk.count = std::min(CHUNK_PRIMITIVES, primitives - first);
+        }
+    }
+    _chunks.resize(chunkCount);
+    parallelFor(_chunks.size(), [&](size_t i) {
+        setupChunk(_chunks[i]);
+        binChunk(_chunks[i]);
+    });
+    auto binned = Clock::now();
+
+    parallelFor(static_cast<size_t>(_tilesX) * static_cast<size_t>(_tilesY), [&](size_t tile) { rasterTile(tile); });
+    auto rasterized = Clock::now();
+
+    _stats.triangles = 0;
+    _stats.lines = 0;
+    _stats.binned = 0;
+    for (const Chunk &chunk : _chunks) {
+        (_commands[chunk.command].lines ? _stats.lines : _stats.triangles) += chunk.primitives.size();
+        _stats.binned += chunk.binned.size();
+    }
+    _stats.transformMs = std::chrono::duration<float, std::milli>(transformed - start).count();
+    _stats.binMs = std::chrono::duration<float, std::milli>(binned - transformed).count();
+    _stats.rasterMs = std::chrono::duration<float, std::milli>(rasterized - binned).count();
+
+    _commands.clear();
+    _sources.clear();
+}
+
+/**
+ * Read Pixels - Copies the color buffer out as tightly packed RGB, bottom row first
+ */
+void SoftwareRasterizer::readPixels(std::vector<uint8_t> &rgb) const {
+    rgb.resize(static_cast<size_t>(_width) * static_cast<size_t>(_height) * 3);
+    for (int y = 0; y < _height; ++y) {
+        const uint8_t *source = &_color[static_cast<size_t>(y) * static_cast<size_t>(_stride) * 4];
+        uint8_t *target = &rgb[static_cast<size_t>(y) * static_cast<size_t>(_width) * 3];
+        for (int x = 0; x < _width; ++x) {
+            target[x * 3] = source[x * 4];
+            target[x * 3 + 1] = source[x * 4 + 1];
+            target[x * 3 + 2] = source[x * 4 + 2];
+        }
+    }
+}
@@ -41,7 +41,7 @@ Texture::Texture(const std::string &path): _filePath(path),
 	}
 	
 	GLCall(glGenTextures(1, &_rendererId));
-	GLCall(glBindTexture(GL_TEXTURE_2D, _rendererId));
+	GLState::bindTexture(GL_TEXTURE_2D, _rendererId);
 
 	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
 	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
@@ -49,7 +49,7 @@ Texture::Texture(const std::string &path): _filePath(path),
 	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
 
 	GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, _width, _height, 0, GL_RGBA, GL_UNSIGNED_BYTE, _localBufer));
-	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+	GLState::bindTexture(GL_TEXTURE_2D, 0);
 
 	if (_localBufer) {
 		stbi_image_free(_localBufer);
@@ -57,16 +57,20 @@ Texture::Texture(const std::string &path): _filePath(path),
 }
 
 Texture::~Texture() {
-	GLCall(glDeleteTextures(1, &_rendererId));
+	GLState::deleteTexture(_rendererId);
 }
 
 void Texture::Bind(unsigned int slot) const {
-	GLCall(glActiveTexture(GL_TEXTURE0 + slot)); // GL_TEXTURE0 = first image slot (OpenGL = STATE MACHINE)
-	GLCall(glBindTexture(GL_TEXTURE_2D, _rendererId));
+	GLState::activeTexture(GL_TEXTURE0 + slot); // GL_TEXTURE0 = first image slot (OpenGL = STATE MACHINE)
+	GLState::bindTexture(GL_TEXTURE_2D, _rendererId);
 }
 
 void Texture::Unbind() const {
-	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+	GLState::bindTexture(GL_TEXTURE_2D, 0);
+}
+
+unsigned int Texture::getID() const {
+	return _rendererId;
 }
 
 int Texture::getWidth() const {
@@ -0,0 +1,97 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UniformBuffer.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/14 10:13:02 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/14 16:48:35 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/UniformBuffer.hpp"
+#include "../../include/ErrorManager.hpp"
+#include "../../include/GLState.hpp"
+#include <cstring>
+
+/**
+ * UniformBuffer Constructor - Allocates the buffer and attaches it to its binding point
+ * 
+ * FLOW:
+ * 1. Generate the buffer object and allocate `size` bytes (GL_DYNAMIC_DRAW, no data yet)
+ * 2. Attach the whole buffer to the indexed GL_UNIFORM_BUFFER binding point once;
+ *    the attachment is global state, so no per-draw rebinding is needed afterwards
+ * 3. Size the shadow copy; the first update() always uploads
+ */
+UniformBuffer::UniformBuffer(size_t size, unsigned int binding)
+    : _id(0), _binding(binding), _shadow(size, 0), _initialized(false) {
+    GLCall(glGenBuffers(1, &_id));
+    GLState::bindBuffer(GL_UNIFORM_BUFFER, _id);
+    GLCall(glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_DRAW));
+    GLState::bindBufferBase(GL_UNIFORM_BUFFER, _binding, _id);
+}
+
+UniformBuffer::~UniformBuffer() {
+    if (_id) {
+        GLState::deleteBuffer(_id);
+    }
+}
+
+unsigned int UniformBuffer::getID() const {
+    return _id;
+}
+
+unsigned int UniformBuffer::getBinding() const {
+    return _binding;
+}
+
+/**
+ * Update Buffer - Uploads new block contents when they differ from the last upload
+ * 
+ * FLOW:
+ * 1. Reject sizes that do not match the allocated block
+ * 2. Compare against the shadow copy; unchanged contents return false without a GL call
+ * 3. Otherwise copy into the shadow and replace the buffer contents with glBufferSubData
+ */
+bool UniformBuffer::update(const void *data, size_t size) {
+    if (size != _shadow.size()) {
+        std::cerr << "Warning: uniform buffer update of " << size << " bytes, block is "
+                  << _shadow.size() << " bytes" << std::endl;
+        return false;
+    }
+
+    if (_initialized && std::memcmp(_shadow.data(), data, size) == 0) {
+        return false;
+    }
+
+    std::memcpy(_shadow.data(), data, size);
+    _initialized = true;
+
+    GLState::bindBuffer(GL_UNIFORM_BUFFER, _id);
+    GLCall(glBufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(size), _shadow.data()));
+    return true;
+}
+
+/**
+ * Bind Program Blocks - Wires a freshly linked program's blocks to the shared binding points
+ * 
+ * FLOW:
+ * 1. Look up each known block name in the program (glGetUniformBlockIndex)
+ * 2. Programs that do not declare a block are left alone
+ * 3. Declared blocks are assigned their fixed binding point, so every program reads the
+ *    same buffers (GLSL 3.30 has no layout(binding) qualifier for this)
+ */
+void UniformBuffer::bindProgramBlocks(unsigned int program) {
+    static const struct { const char *name; unsigned int binding; } blocks[] = {
+        { "FrameData", FRAME_BINDING },
+        { "ObjectData", OBJECT_BINDING },
+    };
+
+    for (const auto &block : blocks) {
+        unsigned int index = glGetUniformBlockIndex(program, block.name);
+        if (index != GL_INVALID_INDEX) {
+            GLCall(glUniformBlockBinding(program, index, block.binding));
+        }
+    }
+}
@@ -184,6 +184,15 @@ void UIManager::renderControlPanel() {
     renderModelControls();
     ImGui::Spacing();
     
+    renderFramePacingControls();
+    ImGui::Spacing();
+    
+    renderResolutionControls();
+    ImGui::Spacing();
+    
+    renderCaptureControls();
+    ImGui::Spacing();
+    
     renderPerformanceStats();
     
     ImGui::End();
@@ -201,6 +210,17 @@ void UIManager::renderMeshInfo() {
         ImGui::Text("Triangles: %d", _state.triangleCount);
         ImGui::Text("Materials: %d", _state.materialCount);
         
+        if (_state.lodPrimitiveCounts.size() > 1) {
+            ImGui::Text("Active LOD: %d / %d (%d %s)", _state.activeLOD,
+                        static_cast<int>(_state.lodPrimitiveCounts.size()) - 1,
+                        _state.lodPrimitiveCounts[_state.activeLOD],
+                        _state.lodLineList ? "segments" : "triangles");
+            for (size_t lod = 0; lod < _state.lodPrimitiveCounts.size(); ++lod) {
+                ImGui::Text("%s LOD%zu: %d", static_cast<int>(lod) == _state.activeLOD ? ">" : " ",
+                            lod, _state.lodPrimitiveCounts[lod]);
+            }
+        }
+        
         if (_regularFont) {
             ImGui::PopFont();
         }
@@ -221,6 +241,7 @@ void UIManager::renderRenderingControls() {
         bool wireframe = _state.wireframeMode;
         if (ImGui::Checkbox("Wireframe Mode [V]", &wireframe)) {
             _state.wireframeMode = wireframe;
+            _stateChanged = true;
             if (onWireframeModeChanged) {
                 onWireframeModeChanged(wireframe);
             }
@@ -229,6 +250,7 @@ void UIManager::renderRenderingControls() {
         bool vertices = _state.showVertices;
         if (ImGui::Checkbox("Show Vertices [X]", &vertices)) {
             _state.showVertices = vertices;
+            _stateChanged = true;
             if (onVertexModeChanged) {
                 onVertexModeChanged(vertices);
             }
@@ -237,6 +259,7 @@ void UIManager::renderRenderingControls() {
         bool ortho = _state.orthographicProjection;
         if (ImGui::Checkbox("Orthographic [P]", &ortho)) {
             _state.orthographicProjection = ortho;
+            _stateChanged = true;
             if (onProjectionModeChanged) {
                 onProjectionModeChanged(ortho);
             }
@@ -245,6 +268,7 @@ void UIManager::renderRenderingControls() {
         bool autoRot = _state.autoRotation;
         if (ImGui::Checkbox("Auto Rotation [1]", &autoRot)) {
             _state.autoRotation = autoRot;
+            _stateChanged = true;
             if (onAutoRotationChanged) {
                 onAutoRotationChanged(autoRot);
             }
@@ -253,6 +277,7 @@ void UIManager::renderRenderingControls() {
         bool crtEffect = _state.enableCRT;
         if (ImGui::Checkbox("CRT Effect [C]", &crtEffect)) {
             _state.enableCRT = crtEffect;
+            _stateChanged = true;
             if (onCRTModeChanged) {
                 onCRTModeChanged(crtEffect);
             }
@@ -261,11 +286,21 @@ void UIManager::renderRenderingControls() {
         bool useTexture = _state.useTexture;
         if (ImGui::Checkbox("Texture Mode [T]", &useTexture)) {
             _state.useTexture = useTexture;
+            _stateChanged = true;
             if (onTextureModeChanged) {
                 onTextureModeChanged(useTexture);
             }
         }
 
+        bool onDemand = _state.renderOnDemand;
+        if (ImGui::Checkbox("Render On Demand", &onDemand)) {
+            _state.renderOnDemand = onDemand;
+            _stateChanged = true;
+            if (onRenderOnDemandChanged) {
+                onRenderOnDemandChanged(onDemand);
+            }
+        }
+
         if (_regularFont) {
             ImGui::PopFont();
         }
@@ -293,6 +328,7 @@ void UIManager::renderModelControls() {
         }
         
         if (renderCustomButton("Reset Model [R]")) {
+            _stateChanged = true;
             if (onResetCamera) {
                 onResetCamera();
             }
@@ -318,6 +354,204 @@ void UIManager::renderModelControls() {
     }
 }
 
+/**
+ * Render Frame Pacing Controls - VSync mode, frame rate limit and low-latency toggle
+ * 
+ * FLOW:
+ * 1. VSync combo (Off / On / Adaptive); adaptive is labelled as falling back to
+ *    plain vsync when the driver lacks swap_control_tear
+ * 2. FPS limit slider, 0 meaning unlimited
+ * 3. Low-latency checkbox (wait before sampling input, drain the GPU after the swap)
+ * Every change is forwarded through its callback and marks the UI state as changed.
+ */
+void UIManager::renderFramePacingControls() {
+    if (renderCustomCollapsingHeader("Frame Pacing", ImGuiTreeNodeFlags_DefaultOpen)) {
+        if (_regularFont) {
+            ImGui::PushFont(_regularFont);
+        }
+
+        const char *vsyncModes[] = {"Off", "On", _state.pacingStats.adaptiveSupported ? "Adaptive" : "Adaptive (unsupported)"};
+        int vsync = _state.vsyncMode;
+        if (ImGui::Combo("VSync", &vsync, vsyncModes, IM_ARRAYSIZE(vsyncModes))) {
+            _state.vsyncMode = vsync;
+            _stateChanged = true;
+            if (onVSyncModeChanged) {
+                onVSyncModeChanged(vsync);
+            }
+        }
+
+        int targetFPS = _state.targetFPS;
+        if (ImGui::SliderInt("FPS Limit", &targetFPS, 0, 240, targetFPS == 0 ? "Unlimited" : "%d")) {
+            _state.targetFPS = targetFPS;
+            _stateChanged = true;
+            if (onTargetFPSChanged) {
+                onTargetFPSChanged(targetFPS);
+            }
+        }
+
+        bool lowLatency = _state.lowLatency;
+        if (ImGui::Checkbox("Low Latency", &lowLatency)) {
+            _state.lowLatency = lowLatency;
+            _stateChanged = true;
+            if (onLowLatencyChanged) {
+                onLowLatencyChanged(lowLatency);
+            }
+        }
+
+        if (_regularFont) {
+            ImGui::PopFont();
+        }
+
+        ImGui::Spacing();
+        ImGui::Spacing();
+    }
+}
+
+/**
+ * Render Resolution Controls - Dynamic resolution toggle, manual scale and GPU budget
+ * 
+ * FLOW:
+ * 1. Dynamic resolution checkbox (render scale driven by the measured GPU frame time)
+ * 2. Dynamic: GPU budget slider in milliseconds; manual: render scale slider
+ * 3. Current scale and the scene size it renders at, against the viewport in pixels
+ * 4. Anti-aliasing combo (Off / FXAA / MSAA 2x-8x, modes above GL_MAX_SAMPLES labelled with
+ *    the count they fall back to) with the GPU time of the AA pass and of the scene, since
+ *    the cost of MSAA is mostly in rasterizing the scene
+ * Every change is forwarded through its callback and marks the UI state as changed.
+ */
+void UIManager::renderResolutionControls() {
+    if (renderCustomCollapsingHeader("Resolution", ImGuiTreeNodeFlags_DefaultOpen)) {
+        if (_regularFont) {
+            ImGui::PushFont(_regularFont);
+        }
+
+        bool dynamic = _state.dynamicResolution;
+        if (ImGui::Checkbox("Dynamic Resolution", &dynamic)) {
+            _state.dynamicResolution = dynamic;
+            _stateChanged = true;
+            if (onDynamicResolutionChanged) {
+                onDynamicResolutionChanged(dynamic);
+            }
+        }
+
+        if (_state.dynamicResolution) {
+            float budget = _state.gpuBudgetMs;
+            if (ImGui::SliderFloat("GPU Budget", &budget, 4.0f, 50.0f, "%.1f ms")) {
+                _state.gpuBudgetMs = budget;
+                _stateChanged = true;
+                if (onGpuBudgetChanged) {
+                    onGpuBudgetChanged(budget);
+                }
+            }
+        } else {
+            float scale = _state.renderScale;
+            if (ImGui::SliderFloat("Render Scale", &scale, 0.5f, 1.0f, "%.2f")) {
+                _state.renderScale = scale;
+                _stateChanged = true;
+                if (onRenderScaleChanged) {
+                    onRenderScaleChanged(scale);
+                }
+            }
+        }
+
+        const ResolutionStats &resolution = _state.resolutionStats;
+        ImGui::Text("Scale: %.0f%% (%dx%d of %dx%d)", resolution.scale * 100.0f, resolution.renderWidth,
+                    resolution.renderHeight, resolution.viewportWidth, resolution.viewportHeight);
+
+        const char *modeNames[] = {"Off", "FXAA", "MSAA 2x", "MSAA 4x", "MSAA 8x"};
+        std::string modeLabels[IM_ARRAYSIZE(modeNames)];
+        const char *modes[IM_ARRAYSIZE(modeNames)];
+        for (int mode = 0; mode < IM_ARRAYSIZE(modeNames); ++mode) {
+            modeLabels[mode] = modeNames[mode];
+            int samples = PostProcessor::getSampleCount(static_cast<AntiAliasing>(mode));
+            if (samples > _state.maxSamples) {
+                modeLabels[mode] += " (max " + std::to_string(_state.maxSamples) + "x)";
+            }
+            modes[mode] = modeLabels[mode].c_str();
+        }
+        int antiAliasing = _state.antiAliasing;
+        if (ImGui::Combo("Anti-Aliasing", &antiAliasing, modes, IM_ARRAYSIZE(modes))) {
+            _state.antiAliasing = antiAliasing;
+            _stateChanged = true;
+            if (onAntiAliasingChanged) {
+                onAntiAliasingChanged(antiAliasing);
+            }
+        }
+
+        const GpuTimerStats &gpu = _state.gpuStats;
+        ImGui::Text("AA: %.2f ms, scene: %.2f ms", gpu.passMs[static_cast<size_t>(GpuPass::ANTI_ALIASING)],
+                    gpu.passMs[static_cast<size_t>(GpuPass::SCENE)]);
+
+        if (_regularFont) {
+            ImGui::PopFont();
+        }
+
+        ImGui::Spacing();
+        ImGui::Spacing();
+    }
+}
+
+void UIManager::renderCaptureControls() {
+    if (renderCustomCollapsingHeader("Capture", ImGuiTreeNodeFlags_DefaultOpen)) {
+        if (renderCustomButton("Screenshot [F12]")) {
+            _stateChanged = true;
+            if (onScreenshot) {
+                onScreenshot();
+            }
+        }
+
+        if (_regularFont) {
+            ImGui::PushFont(_regularFont);
+        }
+
+        const FrameCaptureStats &capture = _state.captureStats;
+        ImGui::Text("Saved: %zu (pending %zu, dropped %zu, failed %zu)", capture.written, capture.pending,
+                    capture.dropped, capture.failed);
+        if (!capture.lastPath.empty()) {
+            ImGui::TextWrapped("Last: %s", capture.lastPath.c_str());
+        }
+
+        const TurntableStats &turntable = _state.turntableStats;
+        int frames = _state.turntableFrames;
+        if (ImGui::SliderInt("Turntable Frames", &frames, 24, 720)) {
+            _state.turntableFrames = frames;
+        }
+
+        if (_regularFont) {
+            ImGui::PopFont();
+        }
+
+        if (renderCustomButton(turntable.recording ? "Stop Recording" : "Record Turntable")) {
+            _stateChanged = true;
+            if (turntable.recording && onTurntableStop) {
+                onTurntableStop();
+            } else if (!turntable.recording && onTurntableStart) {
+                onTurntableStart(_state.turntableFrames);
+            }
+        }
+
+        if (_regularFont) {
+            ImGui::PushFont(_regularFont);
+        }
+
+        if (turntable.recording || turntable.encoding) {
+            ImGui::Text("%s: %d / %d rendered, %zu written (%.1f frames/s)",
+                        turntable.recording ? "Recording" : "Encoding", turntable.frame, turntable.frames,
+                        turntable.written, turntable.framesPerSecond);
+        } else if (turntable.frames > 0) {
+            ImGui::Text("Last turntable: %zu frames", turntable.written);
+            ImGui::TextWrapped("%s", turntable.directory.c_str());
+        }
+
+        if (_regularFont) {
+            ImGui::PopFont();
+        }
+
+        ImGui::Spacing();
+        ImGui::Spacing();
+    }
+}
+
 void UIManager::renderPerformanceStats() {
     if (renderCustomCollapsingHeader("Performance", ImGuiTreeNodeFlags_DefaultOpen)) {
         if (_regularFont) {
@@ -326,6 +560,38 @@ void UIManager::renderPerformanceStats() {
         
         ImGui::Text("FPS: %.1f", _state.fps);
         ImGui::Text("Frame Time: %.3f ms", _state.frameTime * 1000.0f);
+
+        const GpuTimerStats &gpu = _state.gpuStats;
+        float cpuMs = _state.pacingStats.cpuTime * 1000.0f;
+        ImGui::Text("GPU: %.2f ms, CPU: %.2f ms (%s-bound)", gpu.totalMs, cpuMs, gpu.totalMs > cpuMs ? "GPU" : "CPU");
+        for (size_t pass = 0; pass < static_cast<size_t>(GpuPass::COUNT); ++pass) {
+            ImGui::Text("  %s: %.2f ms", GpuTimer::getPassName(static_cast<GpuPass>(pass)), gpu.passMs[pass]);
+        }
+
+        if (_state.pacingStats.targetFrameTime > 0.0f) {
+            ImGui::Text("Pacing jitter: %.2f ms (max %.2f ms off %.2f ms target)", _state.pacingStats.jitter * 1000.0f,
+                        _state.pacingStats.maxDeviation * 1000.0f, _state.pacingStats.targetFrameTime * 1000.0f);
+        } else {
+            ImGui::Text("Pacing jitter: %.2f ms (max %.2f ms off mean)", _state.pacingStats.jitter * 1000.0f,
+                        _state.pacingStats.maxDeviation * 1000.0f);
+        }
+        ImGui::Text("Uniform GL calls: %zu (uncached: %zu)", _state.uniformStats.uploads,
+                    _state.uniformStats.requests * 2);
+        ImGui::Text("Uniforms skipped: %zu / %zu", _state.uniformStats.skipped, _state.uniformStats.requests);
+        ImGui::Text("Uniform buffer uploads: %zu / %zu", _state.uniformStats.blockUploads, _state.uniformStats.blockUpdates);
+        ImGui::Text("GL state changes: %zu (elided: %zu)", _state.glStateStats.issued, _state.glStateStats.elided);
+        ImGui::Text("Draw items: %zu (%zu program/texture switches)", _state.queueStats.items, _state.queueStats.stateSwitches);
+        ImGui::Text("Post targets: %zu (%.1f MB, %zu allocated since start)", _state.postTargetStats.targets,
+                    static_cast<float>(_state.postTargetStats.bytes) / (1024.0f * 1024.0f), _state.postTargetStats.allocations);
+
+        const RenderSchedulerStats &scheduler = _state.schedulerStats;
+        ImGui::Text("Rendering: %s, %.1f frames/s, CPU %.1f%%",
+                    !scheduler.onDemand ? "continuous" : (scheduler.animating ? "animating" : "on demand"),
+                    scheduler.framesPerSecond, scheduler.cpuUsage);
+        if (scheduler.idleSeconds > 0.0f) {
+            ImGui::Text("Last idle: %.1f s, CPU %.2f%%, %zu wakeups", scheduler.idleSeconds,
+                        scheduler.idleCpuUsage, scheduler.idleWakeups);
+        }
         
         if (_regularFont) {
             ImGui::PopFont();
@@ -420,9 +686,63 @@ void UIManager::updateCameraInfo(const InputManager* inputManager) {
     }
 }
 
-void UIManager::updatePerformanceStats(float deltaTime) {
-    _state.frameTime = deltaTime;
-    _state.fps = (deltaTime > 0.0f) ? (1.0f / deltaTime) : 0.0f;
+void UIManager::updateLODInfo(const Mesh* mesh, size_t activeLOD) {
+    if (mesh) {
+        _state.lodPrimitiveCounts.resize(mesh->getLODCount());
+        for (size_t lod = 0; lod < _state.lodPrimitiveCounts.size(); ++lod) {
+            _state.lodPrimitiveCounts[lod] = static_cast<int>(mesh->getLODPrimitiveCount(lod));
+        }
+        _state.lodLineList = mesh->isLineList();
+        _state.activeLOD = static_cast<int>(std::min(activeLOD, _state.lodPrimitiveCounts.size() - 1));
+    }
+}
+
+void UIManager::updatePerformanceStats(const FramePacingStats& stats) {
+    _state.pacingStats = stats;
+    _state.frameTime = stats.frameTime;
+    _state.fps = stats.fps;
+}
+
+void UIManager::updateUniformStats(const UniformStats& stats) {
+    _state.uniformStats = stats;
+}
+
+void UIManager::updateGLStateStats(const GLStateStats& stats) {
+    _state.glStateStats = stats;
+}
+
+void UIManager::updateQueueStats(const RenderQueueStats& stats) {
+    _state.queueStats = stats;
+}
+
+void UIManager::updateSchedulerStats(const RenderSchedulerStats& stats) {
+    _state.schedulerStats = stats;
+}
+
+void UIManager::updateGpuTimerStats(const GpuTimerStats& stats) {
+    _state.gpuStats = stats;
+}
+
+void UIManager::updatePostTargetStats(const RenderTargetPoolStats& stats) {
+    _state.postTargetStats = stats;
+}
+
+void UIManager::updateResolutionStats(const ResolutionStats& stats) {
+    _state.resolutionStats = stats;
+}
+
+void UIManager::updateCaptureStats(const FrameCaptureStats& stats) {
+    _state.captureStats = stats;
+}
+
+void UIManager::updateTurntableStats(const TurntableStats& stats) {
+    _state.turntableStats = stats;
+}
+
+bool UIManager::consumeStateChanged() {
+    bool changed = _stateChanged;
+    _stateChanged = false;
+    return changed;
 }
 
 void UIManager::setCurrentFile(const std::string& filename) {
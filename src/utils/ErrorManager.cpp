@@ -11,6 +11,47 @@
 /* ************************************************************************** */
 
 #include "../../include/ErrorManager.hpp"
+#include "../../include/GLExtensions.hpp"
+
+bool ErrorManager::_debugOutput = false;
+const char *ErrorManager::_callFunction = nullptr;
+const char *ErrorManager::_callFile = nullptr;
+int ErrorManager::_callLine = 0;
+std::vector<std::string> ErrorManager::_groups;
+
+namespace {
+	const char *debugSourceName(GLenum source) {
+		switch (source) {
+			case GL_DEBUG_SOURCE_API:             return "API";
+			case GL_DEBUG_SOURCE_WINDOW_SYSTEM:   return "Window system";
+			case GL_DEBUG_SOURCE_SHADER_COMPILER: return "Shader compiler";
+			case GL_DEBUG_SOURCE_THIRD_PARTY:     return "Third party";
+			case GL_DEBUG_SOURCE_APPLICATION:     return "Application";
+			default:                              return "Other";
+		}
+	}
+
+	const char *debugTypeName(GLenum type) {
+		switch (type) {
+			case GL_DEBUG_TYPE_ERROR:               return "Error";
+			case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "Deprecated behavior";
+			case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:  return "Undefined behavior";
+			case GL_DEBUG_TYPE_PORTABILITY:         return "Portability";
+			case GL_DEBUG_TYPE_PERFORMANCE:         return "Performance";
+			case GL_DEBUG_TYPE_MARKER:              return "Marker";
+			default:                                return "Other";
+		}
+	}
+
+	const char *debugSeverityName(GLenum severity) {
+		switch (severity) {
+			case GL_DEBUG_SEVERITY_HIGH:   return "high";
+			case GL_DEBUG_SEVERITY_MEDIUM: return "medium";
+			case GL_DEBUG_SEVERITY_LOW:    return "low";
+			default:                       return "notification";
+		}
+	}
+}
 
 void ErrorManager::GLClearError() {
 	while (glGetError() != GL_NO_ERROR);
@@ -34,9 +75,104 @@ bool ErrorManager::GLLogCall(const char *function, const char *file, int line) {
 		          << "(0x" << std::hex << std::uppercase << std::setw(4) << std::setfill('0') << error << std::dec << "): "
 		          << errorName << std::endl
 				  << "function [" << function << "] in file [" << file << "] at line:" << line << std::endl;
+		printGroups();
+
+		return (false);
+	}
+
+	return (true);
+}
+
+void ErrorManager::printGroups() {
+	for (size_t i = _groups.size(); i-- > 0;) {
+		std::cout << "  in group [" << _groups[i] << "]" << std::endl;
+	}
+}
 
+/**
+ * Enable Debug Output - Switches error reporting from glGetError polling to KHR_debug
+ * 
+ * FLOW:
+ * 1. Requires GLExtensions::load to have found the KHR_debug entry points; otherwise
+ *    GLCall keeps polling and false is returned
+ * 2. Enable synchronous output so the callback runs inside the offending call, which
+ *    keeps the recorded call site and the debugger stack meaningful
+ * 3. Register the callback and mute notification-severity chatter (buffer placement hints etc.)
+ * 4. Warn when the context was not created with the debug flag: drivers may then report
+ *    fewer messages, but errors are still delivered
+ */
+bool ErrorManager::enableDebugOutput() {
+	if (!GLExtensions::debugOutput) {
+		std::cerr << "Warning: KHR_debug unavailable, falling back to glGetError polling" << std::endl;
 		return (false);
 	}
 
+	glEnable(GL_DEBUG_OUTPUT);
+	glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+	GLExtensions::debugMessageCallback(&ErrorManager::debugCallback, nullptr);
+	GLExtensions::debugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+
+	GLint flags = 0;
+	glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+	if (!(flags & GL_CONTEXT_FLAG_DEBUG_BIT)) {
+		std::cerr << "Warning: GL context has no debug flag, debug output may be incomplete" << std::endl;
+	}
+
+	_debugOutput = true;
 	return (true);
-}
\ No newline at end of file
+}
+
+/**
+ * Debug Callback - Reports a driver message with the location it was raised from
+ * 
+ * FLOW:
+ * 1. Skip group push/pop echoes (our own groups come back as messages on some drivers)
+ * 2. Print source, type, severity and the message text
+ * 3. Add the GLCall site when the message came from a wrapped call, then the open
+ *    debug groups innermost first
+ * 4. Errors stop execution through DEBUG_BREAK, same as the polling path
+ */
+void APIENTRY ErrorManager::debugCallback(GLenum source, GLenum type, GLuint id, GLenum severity,
+                                          GLsizei length, const GLchar *message, const void *userParam) {
+	(void)userParam;
+	if (type == GL_DEBUG_TYPE_PUSH_GROUP || type == GL_DEBUG_TYPE_POP_GROUP) {
+		return;
+	}
+
+	std::cout << "[OpenGL " << debugTypeName(type) << "] (" << id << ", " << debugSourceName(source)
+	          << ", " << debugSeverityName(severity) << "): "
+	          << (length < 0 ? std::string(message) : std::string(message, static_cast<size_t>(length))) << std::endl;
+	if (_callFunction) {
+		std::cout << "function [" << _callFunction << "] in file [" << _callFile << "] at line:" << _callLine << std::endl;
+	}
+	printGroups();
+
+	if (type == GL_DEBUG_TYPE_ERROR) {
+		DEBUG_BREAK();
+	}
+}
+
+/**
+ * Push Group - Opens a debug group labelled "name (file:line)"
+ * 
+ * The label is kept on a CPU-side stack so the glGetError fallback can print it too,
+ * and forwarded to glPushDebugGroup when debug output is active so external tools
+ * (RenderDoc, apitrace) show the same scopes.
+ */
+void ErrorManager::pushGroup(const char *name, const char *file, int line) {
+	std::string label = std::string(name) + " (" + file + ":" + std::to_string(line) + ")";
+	if (_debugOutput) {
+		GLExtensions::pushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, label.c_str());
+	}
+	_groups.push_back(std::move(label));
+}
+
+void ErrorManager::popGroup() {
+	if (_groups.empty()) {
+		return;
+	}
+	if (_debugOutput) {
+		GLExtensions::popDebugGroup();
+	}
+	_groups.pop_back();
+}
@@ -0,0 +1,340 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   PngWriter.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/24 09:41:53 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/24 15:12:31 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/PngWriter.hpp"
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    const size_t WINDOW_SIZE = 32768;
+    const size_t HASH_BITS = 15;
+    const size_t MIN_MATCH = 3;
+    const size_t MAX_MATCH = 258;
+    const size_t MAX_CHAIN = 16;
+
+    // Deflate length codes 257..285: base length and extra bits
+    const uint16_t LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                      35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    const uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                      3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    // Distance codes 0..29: base distance and extra bits
+    const uint16_t DIST_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,
+                                    513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+    const uint8_t DIST_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7,
+                                    8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+    // Deflate bit stream: values are packed LSB first, Huffman codes MSB first
+    class BitWriter {
+        private:
+            std::vector<uint8_t> &_out;
+            uint32_t _buffer;
+            int _count;
+
+        public:
+            explicit BitWriter(std::vector<uint8_t> &out) : _out(out), _buffer(0), _count(0) {}
+
+            void bits(uint32_t value, int count) {
+                _buffer |= value << _count;
+                _count += count;
+                while (_count >= 8) {
+                    _out.push_back(static_cast<uint8_t>(_buffer));
+                    _buffer >>= 8;
+                    _count -= 8;
+                }
+            }
+
+            void code(uint32_t code, int length) {
+                uint32_t reversed = 0;
+                for (int i = 0; i < length; ++i) {
+                    reversed = (reversed << 1) | ((code >> i) & 1u);
+                }
+                bits(reversed, length);
+            }
+
+            void flush() {
+                if (_count > 0) {
+                    _out.push_back(static_cast<uint8_t>(_buffer));
+                }
+                _buffer = 0;
+                _count = 0;
+            }
+    };
+
+    void writeLiteral(BitWriter &writer, uint32_t symbol) {
+        if (symbol < 144) {
+            writer.code(0x30 + symbol, 8);
+        } else if (symbol < 256) {
+            writer.code(0x190 + symbol - 144, 9);
+        } else if (symbol < 280) {
+            writer.code(symbol - 256, 7);
+        } else {
+            writer.code(0xC0 + symbol - 280, 8);
+        }
+    }
+
+    void writeMatch(BitWriter &writer, size_t length, size_t distance) {
+        size_t lengthCode = 28;
+        while (LENGTH_BASE[lengthCode] > length) {
+            lengthCode--;
+        }
+        writeLiteral(writer, static_cast<uint32_t>(257 + lengthCode));
+        writer.bits(static_cast<uint32_t>(length - LENGTH_BASE[lengthCode]), LENGTH_EXTRA[lengthCode]);
+
+        size_t distCode = 29;
+        while (DIST_BASE[distCode] > distance) {
+            distCode--;
+        }
+        writer.code(static_cast<uint32_t>(distCode), 5);
+        writer.bits(static_cast<uint32_t>(distance - DIST_BASE[distCode]), DIST_EXTRA[distCode]);
+    }
+
+    uint32_t hash3(const uint8_t *p) {
+        uint32_t value = (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[1]) << 8) | p[2];
+        return (value * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    void appendBigEndian(std::vector<uint8_t> &out, uint32_t value) {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    uint8_t paeth(int a, int b, int c) {
+        int p = a + b - c;
+        int pa = std::abs(p - a);
+        int pb = std::abs(p - b);
+        int pc = std::abs(p - c);
+        if (pa <= pb && pa <= pc) {
+            return static_cast<uint8_t>(a);
+        }
+        return static_cast<uint8_t>(pb <= pc ? b : c);
+    }
+}
+
+uint32_t PngWriter::crc32(uint32_t crc, const uint8_t *data, size_t size) {
+    static uint32_t table[256];
+    static bool tableReady = [] {
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        return true;
+    }();
+    (void)tableReady;
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+uint32_t PngWriter::adler32(const uint8_t *data, size_t size) {
+    uint32_t a = 1, b = 0;
+    while (size > 0) {
+        size_t block = size < 5552 ? size : 5552;
+        size -= block;
+        while (block-- > 0) {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521u;
+        b %= 65521u;
+    }
+    return (b << 16) | a;
+}
+
+/**
+ * Filter Rows - Prefixes each scanline with the PNG filter that predicts it best
+ *
+ * FLOW:
+ * 1. Rows are taken bottom-up when flipVertically is set (OpenGL readback order)
+ * 2. Each of the five filters (None, Sub, Up, Average, Paeth) is tried per row, keeping the
+ *    one with the smallest sum of absolute residuals (the usual libpng heuristic)
+ */
+std::vector<uint8_t> PngWriter::filterRows(const uint8_t *pixels, int width, int height, int channels, bool flipVertically) {
+    size_t stride = static_cast<size_t>(width) * static_cast<size_t>(channels);
+    std::vector<uint8_t> filtered;
+    filtered.reserve((stride + 1) * static_cast<size_t>(height));
+
+    std::vector<uint8_t> zeroRow(stride, 0);
+    std::vector<uint8_t> candidate(stride);
+    std::vector<uint8_t> best(stride);
+
+    for (int y = 0; y < height; ++y) {
+        int sourceRow = flipVertically ? height - 1 - y : y;
+        int previousRow = flipVertically ? sourceRow + 1 : sourceRow - 1;
+        const uint8_t *row = pixels + static_cast<size_t>(sourceRow) * stride;
+        const uint8_t *up = y > 0 ? pixels + static_cast<size_t>(previousRow) * stride : zeroRow.data();
+
+        uint8_t bestFilter = 0;
+        size_t bestCost = static_cast<size_t>(-1);
+        for (uint8_t filter = 0; filter < 5; ++filter) {
+            size_t cost = 0;
+            for (size_t i = 0; i < stride; ++i) {
+                int left = i >= static_cast<size_t>(channels) ? row[i - channels] : 0;
+                int upLeft = i >= static_cast<size_t>(channels) ? up[i - channels] : 0;
+                uint8_t predicted = 0;
+                switch (filter) {
+                    case 1: predicted = static_cast<uint8_t>(left); break;
+                    case 2: predicted = up[i]; break;
+                    case 3: predicted = static_cast<uint8_t>((left + up[i]) / 2); break;
+                    case 4: predicted = paeth(left, up[i], upLeft); break;
+                    default: break;
+                }
+                uint8_t residual = static_cast<uint8_t>(row[i] - predicted);
+                candidate[i] = residual;
+                cost += residual < 128 ? residual : 256 - residual;
+            }
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestFilter = filter;
+                best.swap(candidate);
+            }
+        }
+
+        filtered.push_back(bestFilter);
+        filtered.insert(filtered.end(), best.begin(), best.end());
+    }
+    return filtered;
+}
+
+/**
+ * Deflate - Compresses data into a zlib stream with one fixed-Huffman block
+ *
+ * FLOW:
+ * 1. zlib header (deflate, 32K window, no dictionary)
+ * 2. Greedy LZ77: hash the next three bytes, walk at most MAX_CHAIN earlier positions with
+ *    the same hash inside the 32K window and take the longest match (3..258 bytes)
+ * 3. Emit matches as length/distance pairs and everything else as literals, using the
+ *    fixed code from RFC 1951 (no code tables to build or store)
+ * 4. End-of-block symbol, then the Adler-32 of the uncompressed data
+ */
+std::vector<uint8_t> PngWriter::deflate(const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> out;
+    out.reserve(data.size() / 4 + 64);
+    out.push_back(0x78);
+    out.push_back(0x01);
+
+    BitWriter writer(out);
+    writer.bits(1, 1);
+    writer.bits(1, 2);
+
+    const size_t NONE = static_cast<size_t>(-1);
+    std::vector<size_t> head(static_cast<size_t>(1) << HASH_BITS, NONE);
+    std::vector<size_t> chain(data.size(), NONE);
+
+    auto insert = [&](size_t position) {
+        if (position + MIN_MATCH <= data.size()) {
+            uint32_t h = hash3(&data[position]);
+            chain[position] = head[h];
+            head[h] = position;
+        }
+    };
+
+    size_t i = 0;
+    while (i < data.size()) {
+        size_t bestLength = 0;
+        size_t bestDistance = 0;
+
+        if (i + MIN_MATCH <= data.size()) {
+            size_t limit = std::min(MAX_MATCH, data.size() - i);
+            size_t candidate = head[hash3(&data[i])];
+            for (size_t steps = 0; candidate != NONE && i - candidate <= WINDOW_SIZE && steps < MAX_CHAIN; ++steps) {
+                size_t length = 0;
+                while (length < limit && data[candidate + length] == data[i + length]) {
+                    length++;
+                }
+                if (length > bestLength) {
+                    bestLength = length;
+                    bestDistance = i - candidate;
+                    if (length == limit) {
+                        break;
+                    }
+                }
+                candidate = chain[candidate];
+            }
+        }
+
+        if (bestLength >= MIN_MATCH) {
+            writeMatch(writer, bestLength, bestDistance);
+            for (size_t k = 0; k < bestLength; ++k) {
+                insert(i + k);
+            }
+            i += bestLength;
+        } else {
+            writeLiteral(writer, data[i]);
+            insert(i);
+            i++;
+        }
+    }
+
+    writeLiteral(writer, 256);
+    writer.flush();
+    appendBigEndian(out, adler32(data.data(), data.size()));
+    return out;
+}
+
+void PngWriter::appendChunk(std::vector<uint8_t> &png, const char *type, const std::vector<uint8_t> &data) {
+    appendBigEndian(png, static_cast<uint32_t>(data.size()));
+    size_t typeStart = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+    appendBigEndian(png, crc32(0, &png[typeStart], png.size() - typeStart));
+}
+
+/**
+ * Encode - Builds a complete PNG file in memory
+ *
+ * channels is 3 (RGB) or 4 (RGBA), 8 bits each. Returns an empty buffer for other layouts.
+ */
+std::vector<uint8_t> PngWriter::encode(const uint8_t *pixels, int width, int height, int channels, bool flipVertically) {
+    if ((channels != 3 && channels != 4) || width <= 0 || height <= 0) {
+        return {};
+    }
+
+    static const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::vector<uint8_t> png(SIGNATURE, SIGNATURE + 8);
+
+    std::vector<uint8_t> header;
+    appendBigEndian(header, static_cast<uint32_t>(width));
+    appendBigEndian(header, static_cast<uint32_t>(height));
+    header.push_back(8);                                // bit depth
+    header.push_back(channels == 4 ? 6 : 2);            // color type: RGBA / RGB
+    header.push_back(0);                                // deflate
+    header.push_back(0);                                // adaptive filtering
+    header.push_back(0);                                // no interlace
+    appendChunk(png, "IHDR", header);
+
+    appendChunk(png, "IDAT", deflate(filterRows(pixels, width, height, channels, flipVertically)));
+    appendChunk(png, "IEND", {});
+    return png;
+}
+
+bool PngWriter::write(const std::string &path, const uint8_t *pixels, int width, int height, int channels, bool flipVertically) {
+    std::vector<uint8_t> png = encode(pixels, width, height, channels, flipVertically);
+    if (png.empty()) {
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char *>(png.data()), static_cast<std::streamsize>(png.size()));
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   StartupTimer.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: hmunoz-g <hmunoz-g@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/08/18 11:40:37 by hmunoz-g          #+#    #+#             */
+/*   Updated: 2025/08/18 15:14:19 by hmunoz-g         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../../include/StartupTimer.hpp"
+#include <iostream>
+#include <iomanip>
+
+std::vector<std::pair<std::string, double>> StartupTimer::_phases;
+StartupTimer::Clock::time_point StartupTimer::_start = StartupTimer::Clock::now();
+StartupTimer::Clock::time_point StartupTimer::_last = StartupTimer::_start;
+
+void StartupTimer::begin() {
+    _phases.clear();
+    _start = Clock::now();
+    _last = _start;
+}
+
+void StartupTimer::mark(const std::string &phase) {
+    Clock::time_point now = Clock::now();
+    double ms = std::chrono::duration<double, std::milli>(now - _last).count();
+    _last = now;
+
+    for (auto &entry : _phases) {
+        if (entry.first == phase) {
+            entry.second += ms;
+            return;
+        }
+    }
+    _phases.emplace_back(phase, ms);
+}
+
+/**
+ * Report - Prints every phase with its share of the total startup time
+ */
+void StartupTimer::report() {
+    double total = std::chrono::duration<double, std::milli>(_last - _start).count();
+
+    std::cout << "Startup breakdown (" << std::fixed << std::setprecision(1) << total << " ms):" << std::endl;
+    for (const auto &entry : _phases) {
+        double share = total > 0.0 ? 100.0 * entry.second / total : 0.0;
+        std::cout << "  " << std::left << std::setw(22) << entry.first << std::right
+                  << std::setw(9) << entry.second << " ms  " << std::setw(5) << share << "%" << std::endl;
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+}